@@ -0,0 +1,896 @@
+/**
+ * @file main.cxx
+ * @brief Headless benchmark suite, prints machine-readable results as JSON.
+ *
+ * Every scenario runs on a hidden window with SDL's dummy video driver and software renderer,
+ * with a fixed random seed and tick interval so runs are comparable across engine versions.
+ * Results go to stdout, or to the file named by the `HELIPAD_BENCHMARK_OUTPUT` environment
+ * variable.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <engine.hxx>
+#include <ecs/physics_kernels.hxx>
+#include <ecs/systems.hxx>
+#include <safety.hxx>
+
+namespace {
+    constexpr std::uint32_t benchmark_seed = 1;
+    constexpr float benchmark_tick_interval = 1.f / 32.f;
+
+    constexpr std::string_view benchmark_scene_name = "benchmark";
+    constexpr std::string_view benchmark_sprite_path = "assets/space_war/player/default.png";
+    constexpr std::string_view benchmark_font_path = "assets/helipad/fonts/roboto_regular.ttf";
+
+    struct benchmark_result {
+        std::string name;
+        std::size_t entities;
+        std::size_t iterations;
+        double mean_ms;
+        double median_ms;
+        double min_ms;
+        double max_ms;
+    };
+
+    /**
+     * @brief Time a scenario body, after untimed warmup runs to settle caches and allocations.
+     */
+    template <class F>
+    benchmark_result benchmark_run(std::string_view name, const std::size_t entities,
+                                   const std::size_t iterations, F&& body) {
+        constexpr std::size_t warmup_iterations = 5;
+        for (std::size_t i = 0; i < warmup_iterations; ++i) {
+            body(i);
+        }
+
+        std::vector<double> samples(iterations);
+        for (std::size_t i = 0; i < iterations; ++i) {
+            const std::uint64_t start = engine::performance_counter_value_current();
+            body(warmup_iterations + i);
+            samples[i] = engine::performance_counter_seconds_since(start) * 1000.0;
+        }
+
+        double sum = 0.0;
+        for (const double sample : samples) {
+            sum += sample;
+        }
+
+        std::sort(samples.begin(), samples.end());
+
+        return {std::string(name),
+                entities,
+                iterations,
+                sum / static_cast<double>(iterations),
+                samples[iterations / 2],
+                samples.front(),
+                samples.back()};
+    }
+
+    glm::vec2 random_point(std::mt19937& rng, const glm::vec2& extent) {
+        std::uniform_real_distribution<float> x(-extent.x, extent.x);
+        std::uniform_real_distribution<float> y(-extent.y, extent.y);
+        return {x(rng), y(rng)};
+    }
+
+    void physics_entities_create(engine::game_entities& entities, const std::size_t count) {
+        entities.clear();
+
+        std::mt19937 rng(benchmark_seed);
+        for (std::size_t i = 0; i < count; ++i) {
+            const entt::entity entity = entities.sprite_create_interpolated("sprite");
+            entities.set_transform_position(entity, random_point(rng, {2000.f, 2000.f}));
+            entities.set_velocity_linear(entity, random_point(rng, {100.f, 100.f}));
+            entities.set_velocity_linear_drag(entity, 0.1f);
+            entities.set_velocity_angular(entity, 45.f);
+        }
+    }
+
+    /**
+     * @brief The physics step from before it was split into grouped passes, as a baseline.
+     *
+     * Walks every entity with a position and probes its optional components one at a time, a
+     * sparse set lookup and a branch each, and wraps rotations with loops.
+     */
+    void physics_baseline_update(entt::registry& registry, const float tick_interval) {
+        auto view = registry.view<engine::component_position, engine::component_rotation>();
+
+        for (auto [entity, position, rotation] : view.each()) {
+            if (auto* interpolation = registry.try_get<engine::component_interpolation>(entity)) {
+                interpolation->previous_position = position.value;
+                interpolation->previous_rotation = rotation.value;
+            }
+
+            if (auto* velocity_linear =
+                    registry.try_get<engine::component_velocity_linear>(entity)) {
+                glm::vec2 velocity = velocity_linear->value;
+
+                if (velocity_linear->drag > 0.0f) {
+                    const float drag_factor = 1.0f - (velocity_linear->drag * tick_interval);
+                    velocity *= std::max(0.0f, drag_factor);
+                    velocity_linear->value = velocity;
+                }
+
+                if (velocity_linear->max_speed > 0.0f) {
+                    const float speed = glm::length(velocity);
+                    if (speed > velocity_linear->max_speed) {
+                        velocity = (velocity / speed) * velocity_linear->max_speed;
+                        velocity_linear->value = velocity;
+                    }
+                }
+
+                position.value += velocity * tick_interval;
+            }
+
+            if (auto* velocity_angular =
+                    registry.try_get<engine::component_velocity_angular>(entity)) {
+                float velocity = velocity_angular->value;
+
+                if (velocity_angular->drag > 0.0f) {
+                    const float drag_factor = 1.0f - (velocity_angular->drag * tick_interval);
+                    velocity *= std::max(0.0f, drag_factor);
+                    velocity_angular->value = velocity;
+                }
+
+                if (velocity_angular->max_speed > 0.0f) {
+                    if (std::abs(velocity) > velocity_angular->max_speed) {
+                        velocity = std::copysign(velocity_angular->max_speed, velocity);
+                        velocity_angular->value = velocity;
+                    }
+                }
+
+                rotation.value += velocity * tick_interval;
+
+                while (rotation.value >= 360.0f) {
+                    rotation.value -= 360.0f;
+                }
+
+                while (rotation.value < 0.0f) {
+                    rotation.value += 360.0f;
+                }
+            }
+        }
+    }
+
+    benchmark_result benchmark_physics_tick(engine::game_scene& scene, const std::size_t count) {
+        engine::game_entities* entities = scene.get_entities();
+        physics_entities_create(*entities, count);
+
+        const std::string name = std::format("physics_tick_{}", count);
+        return benchmark_run(name, count, 200, [&](std::size_t) {
+            entities->systems_update(benchmark_tick_interval);
+        });
+    }
+
+    /**
+     * @brief Time the grouped physics passes against the baseline on the same entities.
+     * @note Both run on the calling thread, so only the iteration differs.
+     */
+    std::vector<benchmark_result> benchmark_physics_passes(engine::game_scene& scene,
+                                                           const std::size_t count) {
+        engine::game_entities* entities = scene.get_entities();
+        entt::registry& registry = entities->registry();
+
+        std::vector<benchmark_result> results;
+
+        physics_entities_create(*entities, count);
+        results.push_back(
+            benchmark_run(std::format("physics_baseline_{}", count), count, 200, [&](std::size_t) {
+                physics_baseline_update(registry, benchmark_tick_interval);
+            }));
+
+        physics_entities_create(*entities, count);
+        results.push_back(
+            benchmark_run(std::format("physics_grouped_{}", count), count, 200, [&](std::size_t) {
+                engine::system_physics::update(registry, benchmark_tick_interval);
+            }));
+
+        return results;
+    }
+
+    benchmark_result benchmark_physics_kernel(const engine::physics_kernels& kernels,
+                                              std::string_view name, const std::size_t count) {
+        std::mt19937 rng(benchmark_seed);
+
+        std::vector<engine::component_velocity_linear> velocities(count);
+        std::vector<engine::component_position> positions(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            velocities[i].value = random_point(rng, {100.f, 100.f});
+            velocities[i].drag = 0.1f;
+            positions[i].value = random_point(rng, {2000.f, 2000.f});
+        }
+
+        return benchmark_run(name, count, 500, [&](std::size_t) {
+            kernels.integrate_linear(velocities.data(), positions.data(), count,
+                                     benchmark_tick_interval);
+        });
+    }
+
+    /**
+     * @brief Entity counts the kernels are checked at, none a multiple of four or eight so every
+     *        SIMD kernel also runs its scalar tail.
+     */
+    constexpr std::size_t kernel_check_counts[] = {1, 3, 5, 7, 13, 31, 203, 1001};
+
+    /**
+     * @brief Largest difference accepted between two kernels, relative to the value's magnitude.
+     */
+    constexpr float kernel_check_epsilon = 1e-4f;
+
+    bool kernel_values_match(const float expected, const float actual) {
+        return std::abs(expected - actual) <=
+               kernel_check_epsilon * std::max(1.f, std::abs(expected));
+    }
+
+    /**
+     * @brief Compare angles in degrees, so one kernel wrapping to 0 and another just below 360
+     *        still match.
+     */
+    bool kernel_angles_match(const float expected, const float actual) {
+        const float difference = std::abs(expected - actual);
+        return std::min(difference, 360.f - difference) <= kernel_check_epsilon * 360.f;
+    }
+
+    void kernel_check_fail(std::string_view kernel, const engine::physics_kernels& kernels,
+                           const std::size_t count, const std::size_t index,
+                           const float expected, const float actual) {
+        throw engine::error_message(
+            "{} kernel of {} differs from scalar at {} of {}: expected {}, got {}", kernel,
+            engine::physics_kernel_isa_name(kernels.isa), index, count, expected, actual);
+    }
+
+    /**
+     * @brief Get a random speed, a tenth of them zero.
+     */
+    float kernel_check_speed(std::mt19937& rng, const float extent) {
+        std::uniform_real_distribution<float> speed(-extent, extent);
+        return (rng() % 10 == 0) ? 0.f : speed(rng);
+    }
+
+    /**
+     * @brief Get a random max speed or drag, covering the zero, negative and clamping cases.
+     */
+    float kernel_check_limit(std::mt19937& rng, const float typical, const float large) {
+        std::uniform_real_distribution<float> value(0.f, typical);
+
+        switch (rng() % 5) {
+        case 0:
+            return 0.f;
+        case 1:
+            return -value(rng);
+        case 2:
+            return large;
+        default:
+            return value(rng);
+        }
+    }
+
+    /**
+     * @brief Run a kernel set against the scalar kernels on the same random inputs.
+     * @note Throws an `error_message` naming the first value outside the epsilon.
+     */
+    void physics_kernels_check(const engine::physics_kernels& kernels) {
+        const engine::physics_kernels& reference = engine::physics_kernels_scalar();
+        std::mt19937 rng(benchmark_seed);
+
+        // Drag of 100 clamps the per tick factor to zero, max speeds of 1 clamp most values.
+        for (const std::size_t count : kernel_check_counts) {
+            std::vector<engine::component_velocity_linear> linear(count);
+            std::vector<engine::component_position> positions(count);
+            for (std::size_t i = 0; i < count; ++i) {
+                linear[i].value = {kernel_check_speed(rng, 2000.f),
+                                   kernel_check_speed(rng, 2000.f)};
+                linear[i].max_speed = kernel_check_limit(rng, 1000.f, 1.f);
+                linear[i].drag = kernel_check_limit(rng, 1.f, 100.f);
+                positions[i].value = random_point(rng, {2000.f, 2000.f});
+            }
+
+            std::vector<engine::component_velocity_linear> linear_actual = linear;
+            std::vector<engine::component_position> positions_actual = positions;
+            reference.integrate_linear(linear.data(), positions.data(), count,
+                                       benchmark_tick_interval);
+            kernels.integrate_linear(linear_actual.data(), positions_actual.data(), count,
+                                     benchmark_tick_interval);
+
+            for (std::size_t i = 0; i < count; ++i) {
+                for (int axis = 0; axis < 2; ++axis) {
+                    if (kernel_values_match(linear[i].value[axis],
+                                            linear_actual[i].value[axis]) == false) {
+                        kernel_check_fail("Linear velocity", kernels, count, i,
+                                          linear[i].value[axis], linear_actual[i].value[axis]);
+                    }
+
+                    if (kernel_values_match(positions[i].value[axis],
+                                            positions_actual[i].value[axis]) == false) {
+                        kernel_check_fail("Position", kernels, count, i,
+                                          positions[i].value[axis],
+                                          positions_actual[i].value[axis]);
+                    }
+                }
+            }
+
+            // Tiny negative rotations wrap to just below a full turn or to zero.
+            std::vector<engine::component_velocity_angular> angular(count);
+            std::vector<engine::component_rotation> rotations(count);
+            std::uniform_real_distribution<float> degrees(-720.f, 720.f);
+            for (std::size_t i = 0; i < count; ++i) {
+                angular[i].value = kernel_check_speed(rng, 720.f);
+                angular[i].max_speed = kernel_check_limit(rng, 360.f, 1.f);
+                angular[i].drag = kernel_check_limit(rng, 1.f, 100.f);
+                rotations[i].value = (rng() % 8 == 0) ? -1e-6f : degrees(rng);
+            }
+
+            std::vector<engine::component_velocity_angular> angular_actual = angular;
+            std::vector<engine::component_rotation> rotations_actual = rotations;
+            reference.integrate_angular(angular.data(), rotations.data(), count,
+                                        benchmark_tick_interval);
+            kernels.integrate_angular(angular_actual.data(), rotations_actual.data(), count,
+                                      benchmark_tick_interval);
+
+            for (std::size_t i = 0; i < count; ++i) {
+                if (kernel_values_match(angular[i].value, angular_actual[i].value) == false) {
+                    kernel_check_fail("Angular velocity", kernels, count, i, angular[i].value,
+                                      angular_actual[i].value);
+                }
+
+                const float rotation = rotations_actual[i].value;
+                if (kernel_angles_match(rotations[i].value, rotation) == false ||
+                    rotation < 0.f || rotation >= 360.f) {
+                    kernel_check_fail("Rotation", kernels, count, i, rotations[i].value,
+                                      rotation);
+                }
+            }
+
+            // Particle pools as the simulation uses them, one array per field.
+            constexpr std::size_t field_count = 8;
+            std::uniform_real_distribution<float> remaining(-0.1f, 2.f);
+            std::vector<float> particles(count * field_count);
+            for (std::size_t i = 0; i < count; ++i) {
+                const glm::vec2 position = random_point(rng, {2000.f, 2000.f});
+                particles[i] = position.x;
+                particles[count + i] = position.y;
+                particles[count * 4 + i] = kernel_check_speed(rng, 500.f);
+                particles[count * 5 + i] = kernel_check_speed(rng, 500.f);
+                particles[count * 6 + i] = remaining(rng);
+                particles[count * 7 + i] = 2.f;
+            }
+
+            std::vector<float> particles_actual = particles;
+            const auto arrays = [count](std::vector<float>& data) {
+                float* base = data.data();
+                return engine::game_particle_arrays{base,             base + count,
+                                                    base + count * 2, base + count * 3,
+                                                    base + count * 4, base + count * 5,
+                                                    base + count * 6, base + count * 7};
+            };
+
+            for (const float drag : {0.f, 0.5f, 100.f}) {
+                const glm::vec2 acceleration = {0.f, 98.f};
+                reference.integrate_particles(arrays(particles), count, acceleration, drag,
+                                              benchmark_tick_interval);
+                kernels.integrate_particles(arrays(particles_actual), count, acceleration, drag,
+                                            benchmark_tick_interval);
+            }
+
+            for (std::size_t i = 0; i < particles.size(); ++i) {
+                if (kernel_values_match(particles[i], particles_actual[i]) == false) {
+                    kernel_check_fail("Particle", kernels, count, i % count, particles[i],
+                                      particles_actual[i]);
+                }
+            }
+        }
+    }
+
+    benchmark_result benchmark_lifetime_churn(engine::game_scene& scene,
+                                              const std::size_t spawns_per_tick) {
+        engine::game_entities* entities = scene.get_entities();
+        entities->clear();
+
+        // Lifetimes of one to four ticks keep the live count steady at a few times the spawns.
+        std::mt19937 rng(benchmark_seed);
+        std::uniform_real_distribution<float> lifetime(benchmark_tick_interval,
+                                                       benchmark_tick_interval * 4.f);
+
+        return benchmark_run("lifetime_churn", spawns_per_tick, 200, [&](std::size_t) {
+            for (std::size_t i = 0; i < spawns_per_tick; ++i) {
+                const entt::entity entity = entities->sprite_create_interpolated("sprite");
+                entities->set_transform_position(entity, random_point(rng, {500.f, 500.f}));
+                entities->add<engine::component_lifetime>(entity, lifetime(rng));
+            }
+
+            entities->systems_update(benchmark_tick_interval);
+        });
+    }
+
+    benchmark_result benchmark_render_queue(engine::game_engine& engine, engine::game_scene& scene,
+                                            const std::size_t count) {
+        engine::game_entities* entities = scene.get_entities();
+        engine::game_renderer* renderer = engine.get_renderer();
+        entities->clear();
+
+        // Spread over twice the view size in each direction, most sprites end up culled.
+        std::mt19937 rng(benchmark_seed);
+        for (std::size_t i = 0; i < count; ++i) {
+            const entt::entity entity = entities->sprite_create("sprite");
+            entities->set_transform_position(entity, random_point(rng, {1280.f, 720.f}));
+        }
+
+        entities->systems_update(benchmark_tick_interval);
+
+        return benchmark_run("render_queue", count, 100, [&](std::size_t) {
+            renderer->draw_begin();
+            entities->system_renderer_update(renderer, *scene.get_resources(), 0.f);
+            renderer->sprite_batch_flush();
+        });
+    }
+
+    benchmark_result benchmark_particles(engine::game_engine& engine, engine::game_scene& scene,
+                                         const std::size_t count) {
+        engine::game_entities* entities = scene.get_entities();
+        engine::game_renderer* renderer = engine.get_renderer();
+        entities->clear();
+
+        // Long lifetimes keep every pool full, so each iteration moves and draws `count`.
+        constexpr std::size_t emitter_count = 10;
+        engine::game_particle_settings settings;
+        settings.lifetime_min = 1000.f;
+        settings.lifetime_max = 1000.f;
+        settings.spawn_radius = 500.f;
+        settings.acceleration = {0.f, 10.f};
+        settings.drag = 0.1f;
+
+        std::mt19937 rng(benchmark_seed);
+        for (std::size_t i = 0; i < emitter_count; ++i) {
+            const std::size_t capacity = count / emitter_count;
+            const entt::entity entity =
+                entities->particle_emitter_create("sprite", settings, capacity);
+            entities->set_transform_position(entity, random_point(rng, {640.f, 360.f}));
+            entities->particles_burst(entity, static_cast<std::uint32_t>(capacity));
+        }
+
+        entities->systems_update(benchmark_tick_interval);
+
+        return benchmark_run("particles", count, 100, [&](std::size_t) {
+            entities->systems_update(benchmark_tick_interval);
+
+            renderer->draw_begin();
+            entities->system_renderer_update(renderer, *scene.get_resources(), 0.5f);
+        });
+    }
+
+    benchmark_result benchmark_animation(engine::game_engine& engine, engine::game_scene& scene,
+                                         const std::size_t count) {
+        engine::game_entities* entities = scene.get_entities();
+        engine::game_renderer* renderer = engine.get_renderer();
+        entities->clear();
+
+        // An 8 by 4 sheet at 30 frames per second, so most entities change frame every tick.
+        const std::vector<engine::game_animation_frame> frames =
+            engine::game_animation_clip::frames_from_grid({0.f, 0.f, 1.f, 1.f}, {8, 4}, 0, 32,
+                                                          1.f / 30.f);
+        const engine::game_animation_clip::handle clip =
+            entities->get_animation_clips().create("benchmark", frames);
+
+        std::mt19937 rng(benchmark_seed);
+        std::uniform_real_distribution<float> speed(0.5f, 2.f);
+        for (std::size_t i = 0; i < count; ++i) {
+            const entt::entity entity = entities->sprite_create("sprite");
+            entities->set_transform_position(entity, random_point(rng, {640.f, 360.f}));
+            entities->animation_play(entity, clip, speed(rng));
+        }
+
+        entities->systems_update(benchmark_tick_interval);
+
+        return benchmark_run("animation", count, 100, [&](std::size_t) {
+            entities->systems_update(benchmark_tick_interval);
+
+            renderer->draw_begin();
+            entities->system_renderer_update(renderer, *scene.get_resources(), 0.5f);
+        });
+    }
+
+    std::vector<benchmark_result> benchmark_snapshot(engine::game_scene& scene,
+                                                     const std::size_t count) {
+        engine::game_entities* entities = scene.get_entities();
+        entities->clear();
+
+        std::mt19937 rng(benchmark_seed);
+        for (std::size_t i = 0; i < count; ++i) {
+            const entt::entity entity = entities->sprite_create_interpolated("sprite");
+            entities->set_transform_position(entity, random_point(rng, {2000.f, 2000.f}));
+            entities->set_velocity_linear(entity, random_point(rng, {100.f, 100.f}));
+        }
+
+        entities->systems_update(benchmark_tick_interval);
+
+        std::vector<benchmark_result> results;
+        engine::game_snapshot snapshot;
+
+        results.push_back(benchmark_run("snapshot_write", count, 200, [&](std::size_t) {
+            entities->snapshot_write(snapshot, 0);
+        }));
+
+        // Every entity moves each tick, so the deltas are close to their worst case.
+        engine::game_snapshot_ring ring(60);
+        results.push_back(
+            benchmark_run("snapshot_ring_push", count, 200, [&](const std::size_t iteration) {
+                entities->systems_update(benchmark_tick_interval);
+                entities->snapshot_write(snapshot, iteration);
+                ring.push(snapshot);
+            }));
+
+        results.push_back(benchmark_run("snapshot_read", count, 200, [&](std::size_t) {
+            entities->snapshot_read(snapshot);
+        }));
+
+        return results;
+    }
+
+    std::vector<benchmark_result> benchmark_resource_lookup(engine::game_scene& scene,
+                                                            const std::size_t count) {
+        engine::game_resources* resources = scene.get_resources();
+
+        std::vector<std::string> keys(count);
+        std::vector<engine::game_sprite::handle> handles(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            keys[i] = std::format("lookup_{}", i);
+            resources->sprite_get_or_create(keys[i], benchmark_sprite_path);
+            handles[i] = resources->sprite_handle_get(keys[i]);
+        }
+
+        std::size_t found = 0;
+        std::vector<benchmark_result> results;
+
+        results.push_back(benchmark_run("resource_lookup_key", count, 500, [&](std::size_t) {
+            for (const std::string& key : keys) {
+                found += (resources->sprite_get(key) != nullptr) ? 1 : 0;
+            }
+        }));
+
+        results.push_back(benchmark_run("resource_lookup_handle", count, 500, [&](std::size_t) {
+            for (const engine::game_sprite::handle handle : handles) {
+                found += (resources->sprite_get(handle) != nullptr) ? 1 : 0;
+            }
+        }));
+
+        // Keeps the lookups from being optimized away.
+        if (found == 0) {
+            engine::log_error("Resource lookups found no sprites.");
+        }
+
+        for (const std::string& key : keys) {
+            resources->sprite_destroy(key);
+        }
+
+        return results;
+    }
+
+    benchmark_result benchmark_text_update(engine::game_scene& scene, const std::size_t count) {
+        engine::game_resources* resources = scene.get_resources();
+
+        std::vector<engine::game_text_dynamic*> texts(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            texts[i] = resources->text_dynamic_get_or_create(std::format("text_{}", i), "0",
+                                                             benchmark_font_path, 24.f);
+        }
+
+        // A score counter changing every frame, laid out the way the renderer would.
+        return benchmark_run("text_update", count, 200, [&](const std::size_t iteration) {
+            for (engine::game_text_dynamic* text : texts) {
+                text->set_text("Score: {}", iteration * 10);
+                static_cast<void>(text->get_glyphs());
+            }
+        });
+    }
+
+    /**
+     * @brief Check a partial redraw of a retained layer against drawing the layer directly.
+     *
+     * A sprite scaled four times is drawn on a retained layer, then a rectangle is invalidated
+     * that only its scaled quad reaches. The repainted frame has to match the same sprite drawn
+     * without retaining the layer, a skipped redraw leaves a transparent hole in the texture.
+     *
+     * @note Throws an `error_message` when the frames differ.
+     */
+    void retained_layer_check(engine::game_renderer& renderer) {
+        constexpr int layer = 1;
+        constexpr int texture_size = 8;
+        constexpr float scale = 4.f;
+
+        // Solid white, so a hole shows as black wherever it is.
+        SDL_Texture* texture =
+            SDL_CreateTexture(renderer.get_sdl_renderer(), SDL_PIXELFORMAT_RGBA32,
+                              SDL_TEXTUREACCESS_STATIC, texture_size, texture_size);
+        if (texture == nullptr) {
+            throw engine::error_message("Failed to create the retained layer check texture: {}",
+                                        SDL_GetError());
+        }
+
+        const std::vector<std::uint32_t> white(texture_size * texture_size, 0xFFFFFFFF);
+        SDL_UpdateTexture(texture, nullptr, white.data(), texture_size * sizeof(std::uint32_t));
+
+        const glm::vec2 size = {texture_size, texture_size};
+        engine::game_sprite sprite("retained_layer_check", texture, size);
+        sprite.set_scale({scale, scale});
+
+        renderer.draw_begin();
+        const engine::game_view_transform* view = renderer.get_view();
+        const glm::vec2 position = (view != nullptr)
+                                       ? (view->visible_min + view->visible_max) * 0.5f
+                                       : renderer.get_output_size() * 0.5f;
+
+        // Right of what the unscaled sprite reaches in any rotation, inside the scaled quad.
+        const glm::vec2 dirty_min = {position.x + glm::length(size) + 1.f, position.y};
+        const glm::vec2 dirty_max = {position.x + (size.x - sprite.get_origin().x) * scale - 1.f,
+                                     position.y + 1.f};
+
+        const auto frame_draw = [&] {
+            renderer.draw_begin();
+            renderer.sprite_queue_world(&sprite, position, layer);
+            renderer.sprite_batch_flush();
+
+            SDL_Surface* pixels = SDL_RenderReadPixels(renderer.get_sdl_renderer(), nullptr);
+            if (pixels == nullptr) {
+                throw engine::error_message("Failed to read the retained layer check frame: {}",
+                                            SDL_GetError());
+            }
+
+            SDL_Surface* converted = SDL_ConvertSurface(pixels, SDL_PIXELFORMAT_RGBA32);
+            SDL_DestroySurface(pixels);
+            return converted;
+        };
+
+        renderer.layer_retain(layer);
+        SDL_DestroySurface(frame_draw());
+
+        renderer.layer_invalidate(layer, dirty_min, dirty_max);
+        SDL_Surface* retained = frame_draw();
+        const std::uint32_t layers_redrawn = renderer.get_stats().layers_redrawn;
+
+        renderer.layer_release(layer);
+        SDL_Surface* expected = frame_draw();
+
+        std::size_t differing = 0;
+        if (retained != nullptr && expected != nullptr) {
+            for (int y = 0; y < expected->h; ++y) {
+                const auto* row_expected =
+                    static_cast<const std::uint8_t*>(expected->pixels) + y * expected->pitch;
+                const auto* row_retained =
+                    static_cast<const std::uint8_t*>(retained->pixels) + y * retained->pitch;
+
+                // Compositing the texture may round differently than drawing directly.
+                for (int i = 0; i < expected->w * 4; ++i) {
+                    differing += (std::abs(row_expected[i] - row_retained[i]) > 2) ? 1 : 0;
+                }
+            }
+        }
+
+        const bool is_compared = retained != nullptr && expected != nullptr;
+        SDL_DestroySurface(retained);
+        SDL_DestroySurface(expected);
+        SDL_DestroyTexture(texture);
+
+        if (is_compared == false) {
+            throw engine::error_message("Failed to convert the retained layer check frames: {}",
+                                        SDL_GetError());
+        }
+
+        // A partial redraw counts as one, without it nothing above ran the partial path.
+        if (layers_redrawn != 1) {
+            throw engine::error_message("Retained layer check redrew {} layers instead of one",
+                                        layers_redrawn);
+        }
+
+        if (differing > 0) {
+            throw engine::error_message(
+                "Retained layer differs from direct drawing in {} channels after a partial "
+                "redraw",
+                differing);
+        }
+    }
+
+    bool snapshot_bytes_match(const engine::game_snapshot& expected,
+                              const engine::game_snapshot& actual) {
+        const std::span<const std::byte> a = expected.get_data();
+        const std::span<const std::byte> b = actual.get_data();
+        return std::equal(a.begin(), a.end(), b.begin(), b.end());
+    }
+
+    /**
+     * @brief Check that snapshots restore exactly and that the ring rebuilds them from deltas.
+     *
+     * A restored registry has to write the same bytes it was read from, and hand out the same
+     * identifier for the next created entity as the registry the snapshot was taken from.
+     * Destroyed entities leave released identifiers behind, so the free list is covered too.
+     *
+     * @note Throws an `error_message` on the first mismatch.
+     */
+    void snapshot_check(engine::game_entities& entities) {
+        constexpr std::size_t count = 1'000;
+        constexpr std::size_t ticks = 50;
+
+        entities.clear();
+
+        std::mt19937 rng(benchmark_seed);
+        std::vector<entt::entity> created(count);
+        for (entt::entity& entity : created) {
+            entity = entities.sprite_create_interpolated("sprite");
+            entities.set_transform_position(entity, random_point(rng, {2000.f, 2000.f}));
+            entities.set_velocity_linear(entity, random_point(rng, {100.f, 100.f}));
+        }
+
+        for (std::size_t i = 0; i < count; i += 7) {
+            entities.destroy(created[i]);
+        }
+
+        entities.systems_update(benchmark_tick_interval);
+
+        engine::game_snapshot written;
+        entities.snapshot_write(written, 0);
+        const entt::entity next_expected = entities.create();
+
+        entities.snapshot_read(written);
+        const entt::entity next_actual = entities.create();
+        if (next_actual != next_expected) {
+            throw engine::error_message(
+                "Restored snapshot created entity {} instead of {}",
+                static_cast<std::uint32_t>(next_actual), static_cast<std::uint32_t>(next_expected));
+        }
+
+        entities.destroy(next_actual);
+        entities.snapshot_read(written);
+
+        engine::game_snapshot rewritten;
+        entities.snapshot_write(rewritten, 0);
+        if (snapshot_bytes_match(written, rewritten) == false) {
+            throw engine::error_message(
+                "Restored snapshot writes {} bytes that differ from the {} it was read from",
+                rewritten.get_data().size(), written.get_data().size());
+        }
+
+        // Short keyframe intervals, so most snapshots are rebuilt through several deltas.
+        engine::game_snapshot_ring ring(ticks - 10, 8);
+        std::vector<engine::game_snapshot> pushed(ticks);
+        for (std::size_t tick = 0; tick < ticks; ++tick) {
+            entities.systems_update(benchmark_tick_interval);
+            entities.snapshot_write(pushed[tick], tick);
+            ring.push(pushed[tick]);
+        }
+
+        engine::game_snapshot rebuilt;
+        for (std::size_t age = 0; age < ring.get_count(); ++age) {
+            const engine::game_snapshot& expected = pushed[ticks - 1 - age];
+            if (ring.get(age, rebuilt) == false) {
+                throw engine::error_message("Snapshot ring holds no snapshot of age {}", age);
+            }
+
+            if (rebuilt.get_tick() != expected.get_tick() ||
+                snapshot_bytes_match(expected, rebuilt) == false) {
+                throw engine::error_message(
+                    "Snapshot ring rebuilt tick {} at age {} differently than tick {} was pushed",
+                    rebuilt.get_tick(), age, expected.get_tick());
+            }
+        }
+
+        entities.clear();
+    }
+
+    std::string results_to_json(const std::vector<benchmark_result>& results) {
+        std::string json = "{\n";
+        json += std::format("  \"project\": \"{}\",\n", engine::project_name);
+        json += std::format("  \"version\": \"{}\",\n", engine::version::full);
+        json += std::format("  \"build_type\": \"{}\",\n", engine::build_type);
+        json += std::format("  \"compiler\": \"{} {}\",\n", engine::compiler_id,
+                            engine::compiler_version);
+        json += std::format("  \"system\": \"{} {}\",\n", engine::system_name,
+                            engine::system_processor);
+        json += std::format("  \"physics_isa\": \"{}\",\n",
+                            engine::physics_kernel_isa_name(engine::physics_kernels_best().isa));
+        json += "  \"results\": [\n";
+
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            const benchmark_result& result = results[i];
+            json += std::format(
+                "    {{\"name\": \"{}\", \"entities\": {}, \"iterations\": {}, "
+                "\"mean_ms\": {:.6f}, \"median_ms\": {:.6f}, \"min_ms\": {:.6f}, "
+                "\"max_ms\": {:.6f}}}{}\n",
+                result.name, result.entities, result.iterations, result.mean_ms,
+                result.median_ms, result.min_ms, result.max_ms,
+                (i + 1 < results.size()) ? "," : "");
+        }
+
+        json += "  ]\n}\n";
+        return json;
+    }
+}  // namespace
+
+void game_entry_point() {
+    // Resolve the output before moving next to the binary, where the copied assets are.
+    std::filesystem::path output_path;
+    if (const char* output = std::getenv("HELIPAD_BENCHMARK_OUTPUT"); output != nullptr) {
+        output_path = std::filesystem::absolute(output);
+    }
+
+    if (const char* base_path = SDL_GetBasePath(); base_path != nullptr) {
+        std::filesystem::current_path(base_path);
+    }
+
+    // No display or GPU needed, and logging per created resource would skew the timings.
+    SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "dummy");
+    SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+    SDL_SetLogPriority(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_WARN);
+
+    // Timings of kernels that disagree with the scalar ones are meaningless, fail instead.
+    physics_kernels_check(engine::physics_kernels_best());
+
+    engine::game_engine engine("Benchmarks", {1280, 720}, nullptr, {},
+                               engine::game_window_type::hidden);
+
+    engine::game_scenes* scenes = engine.get_scenes();
+    scenes->load_scene(benchmark_scene_name, nullptr, {});
+    scenes->activate_scene(benchmark_scene_name);
+
+    engine::game_scene* scene = scenes->get_active_scene();
+    scene->get_resources()->sprite_get_or_create("sprite", benchmark_sprite_path);
+
+    retained_layer_check(*engine.get_renderer());
+    snapshot_check(*scene->get_entities());
+
+    std::vector<benchmark_result> results;
+    for (const std::size_t count : {1'000, 10'000, 100'000}) {
+        results.push_back(benchmark_physics_tick(*scene, count));
+
+        for (benchmark_result& result : benchmark_physics_passes(*scene, count)) {
+            results.push_back(std::move(result));
+        }
+    }
+
+    results.push_back(benchmark_physics_kernel(engine::physics_kernels_scalar(),
+                                               "physics_kernel_scalar", 100'000));
+    results.push_back(benchmark_physics_kernel(engine::physics_kernels_best(),
+                                               "physics_kernel_best", 100'000));
+    results.push_back(benchmark_lifetime_churn(*scene, 1'000));
+    results.push_back(benchmark_render_queue(engine, *scene, 5'000));
+    results.push_back(benchmark_particles(engine, *scene, 100'000));
+    results.push_back(benchmark_animation(engine, *scene, 10'000));
+
+    for (benchmark_result& result : benchmark_snapshot(*scene, 10'000)) {
+        results.push_back(std::move(result));
+    }
+
+    for (benchmark_result& result : benchmark_resource_lookup(*scene, 1'000)) {
+        results.push_back(std::move(result));
+    }
+
+    results.push_back(benchmark_text_update(*scene, 100));
+
+    scene->get_entities()->clear();
+    scenes->deactivate_current_scene();
+    scenes->unload_scene(benchmark_scene_name);
+
+    const std::string json = results_to_json(results);
+    if (output_path.empty() == true) {
+        std::fwrite(json.data(), 1, json.size(), stdout);
+        return;
+    }
+
+    std::ofstream stream(output_path, std::ios::binary | std::ios::trunc);
+    if (stream.is_open() == false) {
+        throw engine::error_message("Failed to write benchmark results to: {}",
+                                    output_path.string());
+    }
+
+    stream.write(json.data(), static_cast<std::streamsize>(json.size()));
+    std::printf("Wrote %zu benchmark results to: %s\n", results.size(),
+                output_path.string().c_str());
+}
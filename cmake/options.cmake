@@ -14,7 +14,19 @@ string(TIMESTAMP ENGINE_BUILD_TIME "%H:%M:%S" UTC)
 option(ENGINE_LOG_INFO "Compile info logging" ON)
 option(ENGINE_LOG_WARNING "Compile warning logging" ON)
 option(ENGINE_LOG_ERROR "Compile error logging" ON)
+option(ENGINE_LOG_ASYNC "Queue log messages and write them on a background thread" ON)
 option(ENGINE_PARANOID "Enable paranoid build checks" ON)
+option(ENGINE_PROFILE "Compile profiler zones and the profiler overlay" OFF)
+
+# Debug builds read loose files by default so edited assets show up without a re-cook.
+set(ENGINE_ASSET_ARCHIVE_DEFAULT ON)
+
+if(CMAKE_BUILD_TYPE STREQUAL "Debug")
+  set(ENGINE_ASSET_ARCHIVE_DEFAULT OFF)
+endif()
+
+option(ENGINE_ASSET_ARCHIVE "Load assets from the cooked archive, falling back to loose files"
+       ${ENGINE_ASSET_ARCHIVE_DEFAULT})
 
 function(engine_option_to_cpp_bool VARIABLE_NAME)
   if(${VARIABLE_NAME})
@@ -37,7 +49,10 @@ function(engine_generate_header TEMPLATE_NAME)
   engine_option_to_cpp_bool(ENGINE_LOG_INFO)
   engine_option_to_cpp_bool(ENGINE_LOG_WARNING)
   engine_option_to_cpp_bool(ENGINE_LOG_ERROR)
+  engine_option_to_cpp_bool(ENGINE_LOG_ASYNC)
   engine_option_to_cpp_bool(ENGINE_PARANOID)
+  engine_option_to_cpp_bool(ENGINE_PROFILE)
+  engine_option_to_cpp_bool(ENGINE_ASSET_ARCHIVE)
 
   configure_file(
     "${CMAKE_SOURCE_DIR}/src/${TEMPLATE_NAME}.hxx.in"
@@ -16,9 +16,10 @@ void scene_on_load(engine::game_scene* scene) {
     engine::game_entities* entities = scene->get_entities();
     engine::game_resources* resources = scene->get_resources();
 
-    // Create a sprite from an image file with the scene's resource manager.
-    auto* player_sprite =
-        resources->sprite_get_or_create("player_sprite", "assets/space_war/player/default.png");
+    // Create a sprite from an image file with the scene's resource manager, packed into a shared
+    // atlas page so every sprite on it draws in a single batch.
+    auto* player_sprite = resources->sprite_get_or_create_packed(
+        "player_sprite", "assets/space_war/player/default.png");
 
     // Set the sprite's render/rotation origin to the center of the image.
     player_sprite->set_origin({16, 24});
@@ -30,6 +31,7 @@ void scene_on_load(engine::game_scene* scene) {
     entities->set_velocity_linear_max(state->player, 500.f);
     entities->set_velocity_angular_drag(state->player, 0.3f);
     entities->set_velocity_angular_max(state->player, 360.f);
+    entities->add_collider_circle(state->player, 16.f);
 
     // Create some dynamic text that follows the player around and scales with the camera zoom.
     auto* player_label = resources->text_dynamic_get_or_create(
@@ -40,13 +42,14 @@ void scene_on_load(engine::game_scene* scene) {
     entities->set_transform_position(state->player_label, {200, 230});
     entities->set_transform_scale(state->player_label, {0.25f, 0.25f});
 
-    auto* asteroid_sprite =
-        resources->sprite_get_or_create("asteroid_sprite", "assets/space_war/asteroids/ice_1.png");
+    auto* asteroid_sprite = resources->sprite_get_or_create_packed(
+        "asteroid_sprite", "assets/space_war/asteroids/ice_1.png");
     asteroid_sprite->set_size({64, 64});
     asteroid_sprite->set_origin(asteroid_sprite->get_size() * 0.5f);
     state->asteroid = entities->sprite_create_interpolated("asteroid_sprite");
     entities->set_transform_position(state->asteroid, {400, 200});
     entities->set_velocity_angular(state->asteroid, 90.f);
+    entities->add_collider_circle(state->asteroid, 28.f);
 
     state->is_free_camera = false;
     state->free_camera_speed = 300.f;
@@ -57,11 +60,27 @@ void scene_on_load(engine::game_scene* scene) {
 }
 
 void scene_on_tick(engine::game_scene* scene, const float tick_interval) {
+    auto* state = scene->get_state<demo_scene_state>();
     engine::game_entities* entities = scene->get_entities();
 
-    // Update ECS systems at fixed tick rate.
-    entities->system_lifetime_update(tick_interval);
-    entities->system_physics_update(tick_interval);
+    // Update ECS systems at fixed tick rate, spread across the engine's job pool.
+    entities->systems_update(tick_interval);
+
+    // Bounce the player off the asteroid while it is heading into it.
+    entities->collision_pairs_for_each([&](entt::entity first, entt::entity second) {
+        const bool is_player_hit = (first == state->player && second == state->asteroid) ||
+                                   (first == state->asteroid && second == state->player);
+        if (is_player_hit == false) {
+            return;
+        }
+
+        auto& velocity = entities->get<engine::component_velocity_linear>(state->player);
+        const glm::vec2 to_asteroid = entities->get_transform_position(state->asteroid) -
+                                      entities->get_transform_position(state->player);
+        if (glm::dot(velocity.value, to_asteroid) > 0.f) {
+            velocity.value = -velocity.value;
+        }
+    });
 }
 
 void scene_on_input(engine::game_scene* scene) {
@@ -87,6 +106,12 @@ void scene_on_input(engine::game_scene* scene) {
     if (input->is_key_pressed(engine::game_input_key::p)) {
         camera->zoom_additive(0.2f);
     }
+
+    // Toggle the profiler overlay on F3 key press, builds need ENGINE_PROFILE for it to show.
+    if (input->is_key_pressed(engine::game_input_key::f3)) {
+        engine::game_profiler* profiler = engine->get_profiler();
+        profiler->set_overlay_visible(profiler->is_overlay_visible() == false);
+    }
 }
 
 void scene_on_frame(engine::game_scene* scene, const float frame_interval) {
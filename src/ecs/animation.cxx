@@ -0,0 +1,81 @@
+/**
+ * @file animation.cxx
+ * @brief Animation clip tables and their registry library.
+ */
+
+#include "animation.hxx"
+
+#include <algorithm>
+#include <string>
+
+namespace engine {
+    game_animation_clip::game_animation_clip(std::span<const game_animation_frame> frames,
+                                             const bool is_looping)
+        : m_frames(frames.begin(), frames.end()), m_duration(0.f), m_is_looping(is_looping) {
+        if (m_frames.empty() == true) {
+            m_frames.emplace_back();
+        }
+
+        // A frame the tick can never leave would freeze the clip, or spin forever on zero.
+        for (game_animation_frame& frame : m_frames) {
+            frame.duration = std::max(frame.duration, frame_duration_min);
+            m_duration += frame.duration;
+        }
+    }
+
+    std::vector<game_animation_frame> game_animation_clip::frames_from_grid(
+        const glm::vec4& sheet_uv, const glm::ivec2& grid, const std::size_t first,
+        const std::size_t count, const float frame_duration) {
+        const glm::ivec2 cells = {std::max(grid.x, 1), std::max(grid.y, 1)};
+        const auto cell_count = static_cast<std::size_t>(cells.x) * cells.y;
+        if (first >= cell_count) {
+            return {};
+        }
+
+        const glm::vec2 cell_size = {(sheet_uv.z - sheet_uv.x) / static_cast<float>(cells.x),
+                                     (sheet_uv.w - sheet_uv.y) / static_cast<float>(cells.y)};
+
+        std::vector<game_animation_frame> frames(std::min(count, cell_count - first));
+        for (std::size_t i = 0; i < frames.size(); ++i) {
+            const std::size_t cell = first + i;
+            const glm::vec2 min = {
+                sheet_uv.x + cell_size.x * static_cast<float>(cell % cells.x),
+                sheet_uv.y + cell_size.y * static_cast<float>(cell / cells.x)};
+
+            frames[i].uv = {min.x, min.y, min.x + cell_size.x, min.y + cell_size.y};
+            frames[i].duration = frame_duration;
+        }
+
+        return frames;
+    }
+
+    game_animation_clip::handle game_animation_clips::create(
+        std::string_view key, std::span<const game_animation_frame> frames,
+        const bool is_looping) {
+        destroy(key);
+
+        const game_animation_clip::handle handle =
+            m_clips.insert(std::make_unique<game_animation_clip>(frames, is_looping));
+        m_handles.insert_or_assign(std::string(key), handle);
+
+        return handle;
+    }
+
+    game_animation_clip::handle game_animation_clips::handle_get(std::string_view key) const {
+        auto it = m_handles.find(key);
+        return (it != m_handles.end()) ? it->second : game_animation_clip::handle{};
+    }
+
+    void game_animation_clips::destroy(std::string_view key) {
+        auto it = m_handles.find(key);
+        if (it != m_handles.end()) {
+            m_clips.erase(it->second);
+            m_handles.erase(it);
+        }
+    }
+
+    void game_animation_clips::clear() {
+        m_clips.clear();
+        m_handles.clear();
+    }
+}  // namespace engine
@@ -0,0 +1,143 @@
+/**
+ * @file animation.hxx
+ * @brief Sprite sheet animation clips advanced by `system_animation`.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "../utils/handles.hxx"
+#include "../utils/string_map.hxx"
+
+namespace engine {
+    /**
+     * @brief One frame of a clip, the part of the sprite's texture it shows and for how long.
+     */
+    struct game_animation_frame {
+        glm::vec4 uv = {0.f, 0.f, 1.f, 1.f};  ///< Source rect in the texture as (u0, v0, u1, v1).
+        float duration = 0.1f;                ///< Seconds, at a playback speed of one.
+    };
+
+    /**
+     * @brief A precomputed table of frames, shared by every entity playing it.
+     *
+     * Frames are drawn with the texture of the entity's sprite and sized by the share of the
+     * sprite's own source rect they cover, so a frame a quarter as wide as the sheet is drawn a
+     * quarter as wide as the sprite.
+     */
+    class game_animation_clip {
+    public:
+        using uptr = std::unique_ptr<game_animation_clip>;
+        using handle = game_handle<game_animation_clip>;
+
+        /**
+         * @brief Shortest frame duration kept, shorter ones are raised to it.
+         */
+        static constexpr float frame_duration_min = 0.001f;
+
+    public:
+        /**
+         * @param frames Frames in playback order, a clip without frames is given one whole
+         * texture frame.
+         * @param is_looping Whether playback wraps to the first frame or stops on the last.
+         */
+        game_animation_clip(std::span<const game_animation_frame> frames, bool is_looping);
+
+        /**
+         * @brief Build frames from a sheet of equally sized cells, read row by row.
+         * @param sheet_uv Source rect of the whole sheet, such as `game_sprite::get_uv`.
+         * @param grid Number of columns and rows in the sheet.
+         * @param first Cell of the first frame, counted from the top left.
+         * @param count Number of frames, clamped to the cells after `first`.
+         * @param frame_duration Seconds every frame is shown.
+         */
+        [[nodiscard]] static std::vector<game_animation_frame> frames_from_grid(
+            const glm::vec4& sheet_uv, const glm::ivec2& grid, std::size_t first,
+            std::size_t count, float frame_duration);
+
+        [[nodiscard]] std::span<const game_animation_frame> get_frames() const noexcept;
+        [[nodiscard]] std::size_t get_frame_count() const noexcept;
+
+        /**
+         * @brief Get the seconds one playback of every frame takes.
+         */
+        [[nodiscard]] float get_duration() const noexcept;
+        [[nodiscard]] bool is_looping() const noexcept;
+
+    private:
+        std::vector<game_animation_frame> m_frames;
+        float m_duration;
+        bool m_is_looping;
+    };
+
+    /**
+     * @brief The clips of a registry, kept in its context by `game_entities`.
+     *
+     * Keys are only looked up when an animation starts playing, entities keep the clip's handle
+     * and `system_animation` resolves it with an index and a generation compare.
+     */
+    class game_animation_clips {
+    public:
+        game_animation_clips() = default;
+
+        /**
+         * @brief Create a clip under a key, replacing the clip it had before.
+         * @note Entities playing a replaced clip stop advancing until they play it again.
+         */
+        game_animation_clip::handle create(std::string_view key,
+                                           std::span<const game_animation_frame> frames,
+                                           bool is_looping = true);
+
+        /**
+         * @return The clip's handle, or an invalid handle if no clip uses this key.
+         */
+        [[nodiscard]] game_animation_clip::handle handle_get(std::string_view key) const;
+
+        /**
+         * @return The clip, or nullptr if the handle is invalid or its clip was destroyed.
+         */
+        [[nodiscard]] const game_animation_clip* get(
+            game_animation_clip::handle handle) const noexcept;
+
+        void destroy(std::string_view key);
+        void clear();
+
+        [[nodiscard]] std::size_t get_count() const noexcept;
+
+    private:
+        game_handle_pool<game_animation_clip> m_clips;
+        string_map<game_animation_clip::handle> m_handles;
+    };
+
+    inline std::span<const game_animation_frame> game_animation_clip::get_frames() const noexcept {
+        return m_frames;
+    }
+
+    inline std::size_t game_animation_clip::get_frame_count() const noexcept {
+        return m_frames.size();
+    }
+
+    inline float game_animation_clip::get_duration() const noexcept {
+        return m_duration;
+    }
+
+    inline bool game_animation_clip::is_looping() const noexcept {
+        return m_is_looping;
+    }
+
+    inline const game_animation_clip* game_animation_clips::get(
+        const game_animation_clip::handle handle) const noexcept {
+        return m_clips.get(handle);
+    }
+
+    inline std::size_t game_animation_clips::get_count() const noexcept {
+        return m_clips.get_size();
+    }
+}  // namespace engine
@@ -0,0 +1,244 @@
+/**
+ * @file commands.cxx
+ * @brief Entity command buffer implementation.
+ */
+
+#include "commands.hxx"
+
+#include <algorithm>
+#include <iterator>
+
+#include "components.hxx"
+
+namespace engine {
+    game_entity_commands::game_entity_commands()
+        : m_mutex(std::make_unique<std::mutex>()),
+          m_creates(),
+          m_create_groups(),
+          m_components(),
+          m_destroys(),
+          m_resolved(),
+          m_spawn_scratch(),
+          m_create_order(),
+          m_blocks(),
+          m_block_index(0),
+          m_block_offset(0) {
+    }
+
+    game_entity_commands::~game_entity_commands() {
+        clear();
+    }
+
+    game_entity_commands& game_entity_commands::operator=(game_entity_commands&& other) noexcept {
+        if (this != &other) {
+            // Pending payloads are destroyed here, the defaulted assignment would leak them.
+            clear();
+
+            m_mutex = std::move(other.m_mutex);
+            m_creates = std::move(other.m_creates);
+            m_create_groups = std::move(other.m_create_groups);
+            m_components = std::move(other.m_components);
+            m_destroys = std::move(other.m_destroys);
+            m_resolved = std::move(other.m_resolved);
+            m_spawn_scratch = std::move(other.m_spawn_scratch);
+            m_create_order = std::move(other.m_create_order);
+            m_blocks = std::move(other.m_blocks);
+            m_block_index = std::exchange(other.m_block_index, 0);
+            m_block_offset = std::exchange(other.m_block_offset, 0);
+        }
+
+        return *this;
+    }
+
+    game_deferred_entity game_entity_commands::create() {
+        const std::lock_guard lock(*m_mutex);
+        return create_record(nullptr, {0.f, 0.f}, 0.f);
+    }
+
+    game_deferred_entity game_entity_commands::spawn(const game_prefab& prefab,
+                                                     const glm::vec2& position,
+                                                     const float rotation) {
+        const std::lock_guard lock(*m_mutex);
+        return create_record(&prefab, position, rotation);
+    }
+
+    void game_entity_commands::destroy(const entt::entity entity) {
+        const std::lock_guard lock(*m_mutex);
+        m_destroys.push_back(entity);
+    }
+
+    void game_entity_commands::flush(entt::registry& registry) {
+        const std::lock_guard lock(*m_mutex);
+
+        if (m_creates.empty() == true && m_components.empty() == true &&
+            m_destroys.empty() == true) {
+            return;
+        }
+
+        // Creations are bucketed by group in one pass, in recording order within each group.
+        std::uint32_t offset = 0;
+        for (create_group& group : m_create_groups) {
+            group.offset = offset;
+            offset += group.count;
+        }
+
+        m_create_order.resize(m_creates.size());
+        for (std::uint32_t i = 0; i < m_creates.size(); ++i) {
+            m_create_order[m_create_groups[m_creates[i].group].offset++] = i;
+        }
+
+        // Each group is created and filled with one ranged create and insert per component.
+        m_resolved.assign(m_creates.size(), entt::null);
+        for (const create_group& group : m_create_groups) {
+            const game_prefab* prefab = group.prefab;
+
+            m_spawn_scratch.resize(group.count);
+            if (prefab != nullptr) {
+                prefab->spawn(registry, m_spawn_scratch);
+            } else {
+                registry.create(m_spawn_scratch.begin(), m_spawn_scratch.end());
+            }
+
+            // The bucketing pass left the offset at the end of the group's creations.
+            const std::uint32_t first = group.offset - group.count;
+            for (std::uint32_t spawned = 0; spawned < group.count; ++spawned) {
+                const std::uint32_t index = m_create_order[first + spawned];
+                const command_create& create = m_creates[index];
+
+                const entt::entity entity = m_spawn_scratch[spawned];
+                m_resolved[index] = entity;
+
+                if (prefab == nullptr) {
+                    continue;
+                }
+
+                // Matching previous values keep a new entity from interpolating in from zero.
+                if (auto* position = registry.try_get<component_position>(entity)) {
+                    position->value = create.position;
+                }
+
+                if (auto* rotation = registry.try_get<component_rotation>(entity)) {
+                    rotation->value = create.rotation;
+                }
+
+                if (auto* interp = registry.try_get<component_interpolation>(entity)) {
+                    interp->previous_position = create.position;
+                    interp->previous_rotation = create.rotation;
+                }
+            }
+        }
+
+        for (command_component& command : m_components) {
+            const entt::entity entity =
+                (command.deferred_index != game_deferred_entity::index_invalid)
+                    ? m_resolved[command.deferred_index]
+                    : command.entity;
+
+            if (registry.valid(entity) == true) {
+                command.apply(registry, entity, command.payload);
+            } else if (command.discard != nullptr) {
+                command.discard(command.payload);
+            }
+        }
+
+        for (const entt::entity entity : m_destroys) {
+            if (registry.valid(entity) == true) {
+                registry.destroy(entity);
+            }
+        }
+
+        commands_reset();
+    }
+
+    void game_entity_commands::clear() {
+        if (m_mutex == nullptr) {
+            return;
+        }
+
+        const std::lock_guard lock(*m_mutex);
+
+        for (command_component& command : m_components) {
+            if (command.discard != nullptr) {
+                command.discard(command.payload);
+            }
+        }
+
+        m_resolved.clear();
+        commands_reset();
+    }
+
+    entt::entity game_entity_commands::resolve(const game_deferred_entity entity) const {
+        const std::lock_guard lock(*m_mutex);
+
+        if (m_creates.empty() == false || entity.index >= m_resolved.size()) {
+            return entt::null;
+        }
+
+        return m_resolved[entity.index];
+    }
+
+    bool game_entity_commands::is_empty() const {
+        const std::lock_guard lock(*m_mutex);
+        return m_creates.empty() == true && m_components.empty() == true &&
+               m_destroys.empty() == true;
+    }
+
+    game_deferred_entity game_entity_commands::create_record(const game_prefab* prefab,
+                                                             const glm::vec2& position,
+                                                             const float rotation) {
+        // Runs of the same prefab are the common case, so the last group is tried first.
+        auto group_it = m_create_groups.end();
+        if (m_create_groups.empty() == false && m_create_groups.back().prefab == prefab) {
+            group_it = std::prev(m_create_groups.end());
+        } else {
+            group_it = std::find_if(m_create_groups.begin(), m_create_groups.end(),
+                                    [prefab](const create_group& group) {
+                                        return group.prefab == prefab;
+                                    });
+        }
+
+        if (group_it == m_create_groups.end()) {
+            group_it = m_create_groups.insert(m_create_groups.end(), {prefab, 0, 0});
+        }
+
+        group_it->count++;
+
+        const auto group = static_cast<std::uint32_t>(group_it - m_create_groups.begin());
+        m_creates.push_back({prefab, position, rotation, group});
+
+        return {static_cast<std::uint32_t>(m_creates.size() - 1)};
+    }
+
+    void* game_entity_commands::payload_allocate(const std::size_t size,
+                                                 const std::size_t alignment) {
+        while (true) {
+            if (m_block_index < m_blocks.size()) {
+                arena_block& block = m_blocks[m_block_index];
+                const std::size_t offset = (m_block_offset + alignment - 1) & ~(alignment - 1);
+
+                if (offset + size <= block.size) {
+                    m_block_offset = offset + size;
+                    return block.data.get() + offset;
+                }
+
+                // Blocks are kept between flushes, try the next one before growing.
+                m_block_index++;
+                m_block_offset = 0;
+                continue;
+            }
+
+            const std::size_t block_size = std::max(arena_block_size, size);
+            m_blocks.push_back({std::make_unique<std::byte[]>(block_size), block_size});
+        }
+    }
+
+    void game_entity_commands::commands_reset() {
+        m_creates.clear();
+        m_create_groups.clear();
+        m_components.clear();
+        m_destroys.clear();
+
+        m_block_index = 0;
+        m_block_offset = 0;
+    }
+}  // namespace engine
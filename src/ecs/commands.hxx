@@ -0,0 +1,223 @@
+/**
+ * @file commands.hxx
+ * @brief Deferred entity creation, destruction and component changes, applied at a sync point.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+
+#include "prefab.hxx"
+
+namespace engine {
+    /**
+     * @brief An entity recorded for creation, it only exists once the commands are flushed.
+     */
+    struct game_deferred_entity {
+        static constexpr std::uint32_t index_invalid = UINT32_MAX;
+
+        std::uint32_t index = index_invalid;
+
+        [[nodiscard]] constexpr bool is_valid() const noexcept;
+    };
+
+    constexpr bool game_deferred_entity::is_valid() const noexcept {
+        return index != index_invalid;
+    }
+
+    /**
+     * @brief Records structural changes while the registry is being iterated or shared.
+     *
+     * Systems that run in parallel, or that iterate a view, cannot create or destroy entities
+     * without invalidating what others are reading. They record the change here instead and
+     * `flush` applies everything in one pass once nobody else touches the registry:
+     *
+     * 1. Creations, grouped by prefab so each group spawns with one batched insertion.
+     * 2. Component additions and removals, in the order they were recorded.
+     * 3. Destructions, skipping entities that are already gone.
+     *
+     * Component values are placed in reusable memory blocks, so recording does not allocate
+     * once the buffer has grown to the game's spawn rate. Recording is thread safe.
+     *
+     * @note Prefabs passed to `spawn` must live until the next flush.
+     */
+    class game_entity_commands {
+    public:
+        /**
+         * @brief Size of the blocks component values are recorded into.
+         */
+        static constexpr std::size_t arena_block_size = 16 * 1024;
+
+    public:
+        game_entity_commands();
+        ~game_entity_commands();
+
+        game_entity_commands(const game_entity_commands&) = delete;
+        game_entity_commands& operator=(const game_entity_commands&) = delete;
+
+        /**
+         * @brief Move the recorded commands along with a registry context.
+         * @note The moved-from buffer must not record again, moving while recording is a bug.
+         */
+        game_entity_commands(game_entity_commands&& other) noexcept = default;
+        game_entity_commands& operator=(game_entity_commands&& other) noexcept;
+
+        /**
+         * @brief Record the creation of an empty entity.
+         */
+        game_deferred_entity create();
+
+        /**
+         * @brief Record the creation of an entity from a prefab.
+         * @param prefab Template to spawn, must live until the next flush.
+         * @param position Written to the spawned `component_position` and interpolation.
+         * @param rotation Written the same way as the position.
+         */
+        game_deferred_entity spawn(const game_prefab& prefab,
+                                   const glm::vec2& position = {0.f, 0.f}, float rotation = 0.f);
+
+        void destroy(entt::entity entity);
+
+        /**
+         * @brief Record adding a component, replacing it if the entity already has one.
+         */
+        template <class Component, class... Args>
+        void add(entt::entity entity, Args&&... args);
+
+        template <class Component, class... Args>
+        void add(game_deferred_entity entity, Args&&... args);
+
+        template <class Component>
+        void remove(entt::entity entity);
+
+        /**
+         * @brief Apply and forget every recorded command.
+         * @note Call while no other thread uses the registry.
+         */
+        void flush(entt::registry& registry);
+
+        /**
+         * @brief Forget every recorded command without applying it.
+         */
+        void clear();
+
+        /**
+         * @brief Get the entity a deferred creation produced in the last flush.
+         * @return The entity, `entt::null` before the flush or after new creations were recorded.
+         */
+        [[nodiscard]] entt::entity resolve(game_deferred_entity entity) const;
+
+        [[nodiscard]] bool is_empty() const;
+
+    private:
+        using apply_function = void (*)(entt::registry& registry, entt::entity entity,
+                                        void* payload);
+        using discard_function = void (*)(void* payload);
+
+        struct command_create {
+            const game_prefab* prefab;  ///< Null for an empty entity.
+            glm::vec2 position;
+            float rotation;
+            std::uint32_t group;  ///< Creations spawned together, in order of first appearance.
+        };
+
+        struct create_group {
+            const game_prefab* prefab;
+            std::uint32_t count;   ///< Creations recorded in the group.
+            std::uint32_t offset;  ///< First of the group's creations in the flush order.
+        };
+
+        struct command_component {
+            entt::entity entity;
+            std::uint32_t deferred_index;
+            apply_function apply;
+            discard_function discard;  ///< Destroys the payload of a command that is not applied.
+            void* payload;
+        };
+
+        struct arena_block {
+            std::unique_ptr<std::byte[]> data;
+            std::size_t size;
+        };
+
+        [[nodiscard]] game_deferred_entity create_record(const game_prefab* prefab,
+                                                         const glm::vec2& position, float rotation);
+
+        [[nodiscard]] void* payload_allocate(std::size_t size, std::size_t alignment);
+
+        template <class Component, class... Args>
+        void add_record(entt::entity entity, std::uint32_t deferred_index, Args&&... args);
+
+        void commands_reset();
+
+    private:
+        std::unique_ptr<std::mutex> m_mutex;
+
+        std::vector<command_create> m_creates;
+        std::vector<create_group> m_create_groups;
+        std::vector<command_component> m_components;
+        std::vector<entt::entity> m_destroys;
+
+        std::vector<entt::entity> m_resolved;  ///< Entities of the last flush's creations.
+        std::vector<entt::entity> m_spawn_scratch;
+        std::vector<std::uint32_t> m_create_order;  ///< Creations bucketed by group for a flush.
+
+        std::vector<arena_block> m_blocks;
+        std::size_t m_block_index;
+        std::size_t m_block_offset;
+    };
+
+    template <class Component, class... Args>
+    void game_entity_commands::add(const entt::entity entity, Args&&... args) {
+        add_record<Component>(entity, game_deferred_entity::index_invalid,
+                              std::forward<Args>(args)...);
+    }
+
+    template <class Component, class... Args>
+    void game_entity_commands::add(const game_deferred_entity entity, Args&&... args) {
+        add_record<Component>(entt::null, entity.index, std::forward<Args>(args)...);
+    }
+
+    template <class Component>
+    void game_entity_commands::remove(const entt::entity entity) {
+        const std::lock_guard lock(*m_mutex);
+
+        m_components.push_back(
+            {entity, game_deferred_entity::index_invalid,
+             [](entt::registry& registry, const entt::entity target, void*) {
+                 registry.remove<Component>(target);
+             },
+             nullptr, nullptr});
+    }
+
+    template <class Component, class... Args>
+    void game_entity_commands::add_record(const entt::entity entity,
+                                          const std::uint32_t deferred_index, Args&&... args) {
+        static_assert(alignof(Component) <= alignof(std::max_align_t),
+                      "Over-aligned components cannot be recorded");
+
+        const std::lock_guard lock(*m_mutex);
+
+        void* payload = payload_allocate(sizeof(Component), alignof(Component));
+        ::new (payload) Component{std::forward<Args>(args)...};
+
+        m_components.push_back(
+            {entity, deferred_index,
+             [](entt::registry& registry, const entt::entity target, void* value) {
+                 auto* component = static_cast<Component*>(value);
+                 registry.emplace_or_replace<Component>(target, std::move(*component));
+                 component->~Component();
+             },
+             [](void* value) { static_cast<Component*>(value)->~Component(); }, payload});
+    }
+}  // namespace engine
@@ -1,34 +1,90 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <glm/glm.hpp>
 #include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
 #include "../renderer/sprite.hxx"
+#include "../renderer/text.hxx"
+#include "animation.hxx"
+#include "particles.hxx"
 
 namespace engine {
+    /**
+     * @brief Sprite drawn at the entity's position, resolved from its `component_sprite_key`.
+     *
+     * Adding or replacing a `component_sprite_key` gives the entity this component with an
+     * invalid handle, which the renderer resolves once on first draw.
+     */
     struct component_sprite {
+        game_sprite::handle handle;
+    };
+
+    /**
+     * @brief Resource key a `component_sprite` resolves from, only read while it is unresolved.
+     */
+    struct component_sprite_key {
         std::string resource_key;
 
-        explicit component_sprite(std::string_view key) : resource_key(key) {
+        component_sprite_key() = default;
+        explicit component_sprite_key(std::string_view key) : resource_key(key) {
         }
     };
 
     struct component_text_dynamic {
-        std::string resource_key;
+        game_text_dynamic::handle handle;
         glm::vec4 color = {1.0f, 1.0f, 1.0f, 1.0f};
+    };
+
+    /**
+     * @brief Resource key a `component_text_dynamic` resolves from, added the same way.
+     * @note An existing `component_text_dynamic` keeps its color and is only unresolved.
+     */
+    struct component_text_key {
+        std::string resource_key;
 
-        explicit component_text_dynamic(std::string_view key) : resource_key(key) {
+        component_text_key() = default;
+        explicit component_text_key(std::string_view key) : resource_key(key) {
         }
     };
 
+    /**
+     * @brief Plays a clip on the entity's `component_sprite`, advanced by `system_animation`.
+     *
+     * The renderer draws `uv` from the sprite's texture instead of the sprite's own source rect,
+     * so changing frames never touches the sprite or its key.
+     */
+    struct component_animation {
+        game_animation_clip::handle clip;
+        std::uint32_t frame = 0;
+        float frame_time = 0.f;  ///< Seconds the current frame has been shown.
+        float speed = 1.f;       ///< Playback rate, zero pauses the clip.
+        bool is_playing = true;  ///< Cleared when a clip that does not loop ends.
+        glm::vec4 uv = {0.f, 0.f, 1.f, 1.f};  ///< Source rect of the current frame.
+    };
+
     struct component_renderable {
         bool is_visible = true;
         int layer = 0;
     };
 
-    struct component_transform {
-        glm::vec2 position = {0.0f, 0.0f};
-        float rotation = 0.0f;
-        glm::vec2 scale = {1.0f, 1.0f};
+    /**
+     * @brief World position. Position, rotation and scale are separate storages so each pass
+     * only streams the data it uses.
+     */
+    struct component_position {
+        glm::vec2 value = {0.0f, 0.0f};
+    };
+
+    struct component_rotation {
+        float value = 0.0f;  // degrees
+    };
+
+    struct component_scale {
+        glm::vec2 value = {1.0f, 1.0f};
     };
 
     struct component_interpolation {
@@ -51,4 +107,67 @@ namespace engine {
     struct component_lifetime {
         float remaining_seconds = 5.f;
     };
+
+    enum class collider_shape { circle, aabb };
+
+    /**
+     * @brief Collision bounds placed at the entity's position, scaled but never rotated.
+     */
+    struct component_collider {
+        collider_shape shape = collider_shape::circle;
+        float radius = 16.0f;                   ///< Used by circle colliders.
+        glm::vec2 half_size = {16.0f, 16.0f};  ///< Used by AABB colliders.
+        glm::vec2 offset = {0.0f, 0.0f};       ///< Center offset from the entity's position.
+    };
+
+    /**
+     * @brief Spawns particles at the entity's position into a pool it owns.
+     *
+     * Particles are not entities, `system_particles` simulates the whole pool in one pass and the
+     * renderer draws it as a single block of quads textured with the sprite from `sprite_key`.
+     */
+    struct component_particle_emitter {
+        game_particle_settings settings;
+        game_particle_pool pool;
+        std::string sprite_key;
+        game_sprite::handle sprite;  ///< Resolved from `sprite_key` on first draw.
+        bool is_emitting = true;     ///< Stops spawning at `settings.rate`, bursts still spawn.
+        float spawn_accumulator = 0.f;
+        std::uint32_t burst_pending = 0;  ///< Particles to spawn on the next tick.
+        std::uint32_t random_state = 0x9E3779B9u;
+
+        /**
+         * @brief Create an emitter with an empty pool, such as one about to be restored.
+         */
+        component_particle_emitter() : pool(0) {
+        }
+
+        component_particle_emitter(std::string_view key, const game_particle_settings& emitter,
+                                   std::size_t capacity = game_particle_pool::capacity_default)
+            : settings(emitter), pool(capacity), sprite_key(key) {
+        }
+    };
+
+    // Components the fixed tick and the renderer touch every frame stay plain data, so a cache
+    // line holds eight positions or sixteen rotations and the snapshot archive copies them as
+    // raw bytes.
+    static_assert(std::is_trivially_copyable_v<component_sprite>);
+    static_assert(std::is_trivially_copyable_v<component_text_dynamic>);
+    static_assert(std::is_trivially_copyable_v<component_renderable>);
+    static_assert(std::is_trivially_copyable_v<component_position>);
+    static_assert(std::is_trivially_copyable_v<component_rotation>);
+    static_assert(std::is_trivially_copyable_v<component_scale>);
+    static_assert(std::is_trivially_copyable_v<component_interpolation>);
+    static_assert(std::is_trivially_copyable_v<component_velocity_linear>);
+    static_assert(std::is_trivially_copyable_v<component_velocity_angular>);
+    static_assert(std::is_trivially_copyable_v<component_lifetime>);
+    static_assert(std::is_trivially_copyable_v<component_collider>);
+    static_assert(std::is_trivially_copyable_v<component_animation>);
+
+    static_assert(sizeof(component_sprite) == 8);
+    static_assert(sizeof(component_renderable) == 8);
+    static_assert(sizeof(component_position) == 8);
+    static_assert(sizeof(component_rotation) == 4);
+    static_assert(sizeof(component_scale) == 8);
+    static_assert(sizeof(component_interpolation) == 12);
 }  // namespace engine
@@ -1,14 +1,118 @@
 #include "entities.hxx"
 
+#include <utility>
+
 #include "../engine.hxx"
 
 namespace engine {
+    namespace {
+        /**
+         * @brief Give an entity whose sprite key was added or replaced an unresolved sprite.
+         */
+        void sprite_key_on_assign(entt::registry& registry, const entt::entity entity) {
+            registry.emplace_or_replace<component_sprite>(entity);
+        }
+
+        void text_key_on_assign(entt::registry& registry, const entt::entity entity) {
+            // Keep the color, which may have been set or restored before the key.
+            if (auto* text = registry.try_get<component_text_dynamic>(entity); text != nullptr) {
+                text->handle = {};
+                return;
+            }
+
+            registry.emplace<component_text_dynamic>(entity);
+        }
+    }  // namespace
+
+    game_entities::game_entities(game_jobs* jobs) : m_registry(), m_jobs(jobs), m_scheduler() {
+        registry_setup();
+
+        // Lifetime only records destructions, they are applied once every system has run.
+        m_scheduler.add(
+            "lifetime",
+            [](entt::registry& registry, game_jobs*, const float tick_interval, void*) {
+                system_lifetime::update(registry, tick_interval);
+            },
+            game_system_access{}.write<component_lifetime>());
+
+        m_scheduler.add(
+            "physics",
+            [](entt::registry& registry, game_jobs* jobs, const float tick_interval, void*) {
+                system_physics::update(registry, tick_interval, jobs);
+            },
+            game_system_access{}
+                .write<component_interpolation, component_velocity_linear,
+                       component_velocity_angular, component_position, component_rotation>(),
+            nullptr, system_physics::prepare);
+
+        m_scheduler.add(
+            "particles",
+            [](entt::registry& registry, game_jobs* jobs, const float tick_interval, void*) {
+                system_particles::update(registry, tick_interval, jobs);
+            },
+            game_system_access{}
+                .write<component_particle_emitter>()
+                .read<component_position, component_rotation>());
+
+        m_scheduler.add(
+            "animation",
+            [](entt::registry& registry, game_jobs*, const float tick_interval, void*) {
+                system_animation::update(registry, tick_interval);
+            },
+            game_system_access{}.write<component_animation>());
+
+        m_scheduler.add(
+            "colliders",
+            [](entt::registry& registry, game_jobs*, float, void*) {
+                registry.ctx().get<game_spatial_hash>().rebuild(registry);
+            },
+            game_system_access{}
+                .read<component_position, component_scale, component_collider>()
+                .context_write<game_spatial_hash>());
+
+        m_scheduler.add(
+            "render_index",
+            [](entt::registry& registry, game_jobs*, float, void*) {
+                registry.ctx().get<game_render_index>().rebuild(registry);
+            },
+            game_system_access{}
+                .read<component_position, component_scale, component_interpolation,
+                      component_sprite, component_renderable>()
+                .context_write<game_render_index>());
+    }
+
+    void game_entities::registry_setup() {
+        m_registry.ctx().emplace<game_spatial_hash>();
+        m_registry.ctx().emplace<game_render_index>();
+        m_registry.ctx().emplace<game_entity_commands>();
+        m_registry.ctx().emplace<game_animation_clips>();
+        m_registry.on_construct<component_sprite>().connect<&render_index_on_sprite_construct>();
+        m_registry.on_construct<component_sprite_key>().connect<&sprite_key_on_assign>();
+        m_registry.on_update<component_sprite_key>().connect<&sprite_key_on_assign>();
+        m_registry.on_construct<component_text_key>().connect<&text_key_on_assign>();
+        m_registry.on_update<component_text_key>().connect<&text_key_on_assign>();
+    }
+
+    void game_entities::registry_reset() {
+        // `clear` keeps released identifiers in the entity storage, a restored snapshot has to
+        // start from an empty free list to hand out the same identifiers as the original run.
+        game_animation_clips clips = std::move(get_animation_clips());
+
+        m_registry = entt::registry{};
+        registry_setup();
+
+        get_animation_clips() = std::move(clips);
+    }
+
     void game_entities::system_physics_update(const float tick_interval) {
-        system_physics::update(m_registry, tick_interval);
+        system_physics::update(m_registry, tick_interval, m_jobs);
+        get_spatial_hash().rebuild(m_registry);
+        get_render_index().rebuild(m_registry);
     }
 
     void game_entities::system_lifetime_update(const float tick_interval) {
         system_lifetime::update(m_registry, tick_interval);
+        commands_flush();
     }
 
     void game_entities::system_renderer_update(game_renderer* renderer, game_resources& resources,
@@ -16,12 +120,33 @@ namespace engine {
         system_renderer::update(m_registry, renderer, resources, fraction_to_next_tick);
     }
 
+    void game_entities::render_packet_write(const game_resources& resources,
+                                            game_render_packet& packet) {
+        system_render_packet::write(m_registry, resources, packet);
+    }
+
+    void game_entities::systems_update(const float tick_interval) {
+        m_scheduler.run(m_registry, m_jobs, tick_interval);
+        commands_flush();
+    }
+
+    void game_entities::system_add(std::string_view name, const system_function function,
+                                   const game_system_access& access, void* user_data,
+                                   const system_prepare_function prepare) {
+        m_scheduler.add(name, function, access, user_data, prepare);
+    }
+
+    void game_entities::system_remove(std::string_view name) {
+        m_scheduler.remove(name);
+    }
+
     entt::entity game_entities::sprite_create(std::string_view resource_key) {
         entt::entity entity = m_registry.create();
 
-        m_registry.emplace<component_transform>(entity, glm::vec2{0.0f, 0.0f}, 0.0f,
-                                                glm::vec2{1.0f, 1.0f});
-        m_registry.emplace<component_sprite>(entity, resource_key);
+        m_registry.emplace<component_position>(entity, glm::vec2{0.0f, 0.0f});
+        m_registry.emplace<component_rotation>(entity, 0.0f);
+        m_registry.emplace<component_scale>(entity, glm::vec2{1.0f, 1.0f});
+        m_registry.emplace<component_sprite_key>(entity, resource_key);
         m_registry.emplace<component_renderable>(entity, true, 0);
 
         return entity;
@@ -40,23 +165,90 @@ namespace engine {
     entt::entity game_entities::create_text_dynamic(std::string_view resource_key) {
         entt::entity entity = m_registry.create();
 
-        m_registry.emplace<component_transform>(entity, glm::vec2{0.0f, 0.0f}, 0.0f,
-                                                glm::vec2{1.0f, 1.0f});
-        m_registry.emplace<component_text_dynamic>(entity, resource_key);
+        m_registry.emplace<component_position>(entity, glm::vec2{0.0f, 0.0f});
+        m_registry.emplace<component_rotation>(entity, 0.0f);
+        m_registry.emplace<component_scale>(entity, glm::vec2{1.0f, 1.0f});
+        m_registry.emplace<component_text_key>(entity, resource_key);
         m_registry.emplace<component_renderable>(entity, true, 0);
 
         return entity;
     }
 
+    entt::entity game_entities::particle_emitter_create(std::string_view sprite_key,
+                                                        const game_particle_settings& settings,
+                                                        const std::size_t capacity) {
+        entt::entity entity = m_registry.create();
+
+        m_registry.emplace<component_position>(entity, glm::vec2{0.0f, 0.0f});
+        m_registry.emplace<component_rotation>(entity, 0.0f);
+        m_registry.emplace<component_particle_emitter>(entity, sprite_key, settings, capacity);
+
+        return entity;
+    }
+
+    void game_entities::particles_burst(const entt::entity entity, const std::uint32_t count) {
+        if (auto* emitter = m_registry.try_get<component_particle_emitter>(entity); emitter) {
+            emitter->burst_pending += count;
+        }
+    }
+
+    bool game_entities::animation_play(const entt::entity entity, std::string_view clip_key,
+                                       const float speed) {
+        const game_animation_clip::handle clip = get_animation_clips().handle_get(clip_key);
+        if (clip.is_valid() == false) {
+            return false;
+        }
+
+        animation_play(entity, clip, speed);
+        return true;
+    }
+
+    void game_entities::animation_play(const entt::entity entity,
+                                       const game_animation_clip::handle clip, const float speed) {
+        component_animation animation;
+        animation.clip = clip;
+        animation.speed = speed;
+
+        // Show the first frame right away rather than the whole sheet until the next tick.
+        if (const game_animation_clip* resolved = get_animation_clips().get(clip)) {
+            animation.uv = resolved->get_frames().front().uv;
+        }
+
+        m_registry.emplace_or_replace<component_animation>(entity, animation);
+    }
+
+    void game_entities::set_animation_playing(const entt::entity entity, const bool is_playing) {
+        if (auto* animation = m_registry.try_get<component_animation>(entity); animation) {
+            animation->is_playing = is_playing;
+        }
+    }
+
+    void game_entities::add_collider_circle(entt::entity entity, const float radius) {
+        component_collider collider;
+        collider.shape = collider_shape::circle;
+        collider.radius = radius;
+
+        m_registry.emplace_or_replace<component_collider>(entity, collider);
+    }
+
+    void game_entities::add_collider_aabb(entt::entity entity, const glm::vec2& half_size) {
+        component_collider collider;
+        collider.shape = collider_shape::aabb;
+        collider.half_size = half_size;
+
+        m_registry.emplace_or_replace<component_collider>(entity, collider);
+    }
+
     void game_entities::set_transform_position(entt::entity entity, const glm::vec2& position) {
-        if (auto* transform = m_registry.try_get<component_transform>(entity); transform) {
-            transform->position = position;
+        if (auto* current = m_registry.try_get<component_position>(entity); current) {
+            current->value = position;
+            get_render_index().mark_loose(entity);
         }
     }
 
     glm::vec2 game_entities::get_transform_position(entt::entity entity) const {
-        if (const auto* transform = m_registry.try_get<component_transform>(entity); transform) {
-            return transform->position;
+        if (const auto* position = m_registry.try_get<component_position>(entity); position) {
+            return position->value;
         }
 
         return glm::vec2{0.0f, 0.0f};
@@ -64,13 +256,12 @@ namespace engine {
 
     glm::vec2 game_entities::get_interpolated_position(entt::entity entity,
                                                        float fraction_to_next_tick) const {
-        if (const auto* transform = m_registry.try_get<component_transform>(entity); transform) {
+        if (const auto* position = m_registry.try_get<component_position>(entity); position) {
             if (const auto* interp = m_registry.try_get<component_interpolation>(entity); interp) {
-                return glm::mix(interp->previous_position, transform->position,
-                                fraction_to_next_tick);
+                return glm::mix(interp->previous_position, position->value, fraction_to_next_tick);
             }
 
-            return transform->position;
+            return position->value;
         }
 
         return glm::vec2{0.0f, 0.0f};
@@ -78,35 +269,35 @@ namespace engine {
 
     float game_entities::get_interpolated_rotation(entt::entity entity,
                                                    float fraction_to_next_tick) const {
-        if (const auto* transform = m_registry.try_get<component_transform>(entity)) {
+        if (const auto* rotation = m_registry.try_get<component_rotation>(entity)) {
             if (const auto* interp = m_registry.try_get<component_interpolation>(entity)) {
-                return glm::mix(interp->previous_rotation, transform->rotation,
-                                fraction_to_next_tick);
+                return glm::mix(interp->previous_rotation, rotation->value, fraction_to_next_tick);
             }
 
-            return transform->rotation;
+            return rotation->value;
         }
 
         return 0.f;
     }
 
     void game_entities::set_transform_scale(entt::entity entity, const glm::vec2& new_scale) {
-        if (auto* transform = m_registry.try_get<component_transform>(entity); transform) {
-            transform->scale = new_scale;
+        if (auto* scale = m_registry.try_get<component_scale>(entity); scale) {
+            scale->value = new_scale;
+            get_render_index().mark_loose(entity);
         }
     }
 
     glm::vec2 game_entities::get_transform_scale(entt::entity entity) {
-        if (const auto* transform = m_registry.try_get<component_transform>(entity); transform) {
-            return transform->scale;
+        if (const auto* scale = m_registry.try_get<component_scale>(entity); scale) {
+            return scale->value;
         }
 
         return glm::vec2{1.0f, 1.0f};
     }
 
     glm::vec2 game_entities::get_vector_forward(entt::entity entity) const {
-        if (const auto* transform = m_registry.try_get<component_transform>(entity); transform) {
-            float radians = glm::radians(transform->rotation + 90.f);
+        if (const auto* rotation = m_registry.try_get<component_rotation>(entity); rotation) {
+            float radians = glm::radians(rotation->value + 90.f);
             return glm::vec2{glm::cos(radians), glm::sin(radians)};
         }
 
@@ -114,8 +305,8 @@ namespace engine {
     }
 
     glm::vec2 game_entities::get_vector_right(entt::entity entity) const {
-        if (const auto* transform = m_registry.try_get<component_transform>(entity); transform) {
-            float radians = glm::radians(transform->rotation);
+        if (const auto* rotation = m_registry.try_get<component_rotation>(entity); rotation) {
+            float radians = glm::radians(rotation->value);
             return glm::vec2{glm::cos(radians), glm::sin(radians)};
         }
 
@@ -150,9 +341,9 @@ namespace engine {
 
     void game_entities::add_impulse_relative(entt::entity entity,
                                              const glm::vec2& relative_direction, float magnitude) {
-        if (const auto* transform = m_registry.try_get<component_transform>(entity); transform) {
+        if (const auto* rotation = m_registry.try_get<component_rotation>(entity); rotation) {
             // Rotate the relative direction by the entity's rotation
-            const float radians = glm::radians(transform->rotation);
+            const float radians = glm::radians(rotation->value);
             glm::vec2 rotated_direction = {
                 relative_direction.x * glm::cos(radians) - relative_direction.y * glm::sin(radians),
                 relative_direction.x * glm::sin(radians) +
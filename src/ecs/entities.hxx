@@ -5,21 +5,36 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <span>
 #include <string_view>
 #include <entt/entt.hpp>
 #include "systems.hxx"
+#include "scheduler.hxx"
+#include "spatial_hash.hxx"
+#include "render_index.hxx"
+#include "commands.hxx"
+#include "prefab.hxx"
 #include "components.hxx"
+#include "snapshot.hxx"
 
 namespace engine {
     class game_renderer;
     class game_resources;
+    class game_jobs;
+    struct game_render_packet;
 
     /**
      * @brief ECS wrapper that manages its own registry.
      */
     class game_entities {
     public:
-        game_entities() = default;
+        /**
+         * @brief Create an empty registry with the built-in lifetime and physics systems.
+         * @param jobs Pool used to run systems in parallel, nullptr runs everything inline.
+         */
+        explicit game_entities(game_jobs* jobs = nullptr);
         ~game_entities() = default;
 
         // Rule of 5 - using defaults since no resource management
@@ -38,16 +53,152 @@ namespace engine {
         void system_renderer_update(game_renderer* renderer, game_resources& resources,
                                     float fraction_to_next_tick);
 
+        /**
+         * @brief Snapshot every visible sprite and dynamic text for `system_render_packet::draw`.
+         */
+        void render_packet_write(const game_resources& resources, game_render_packet& packet);
+
+        /**
+         * @brief Run every scheduled system once, in parallel where their access allows it.
+         * @param tick_interval Fixed tick interval in seconds.
+         * @note Runs lifetime, physics and the collider rebuild, then systems from `system_add`,
+         * and finally flushes the command buffer.
+         */
+        void systems_update(float tick_interval);
+
+        /**
+         * @brief Get the buffer systems record deferred creations and destructions into.
+         * @note Stored in the registry context, flushed at the end of `systems_update`.
+         */
+        [[nodiscard]] game_entity_commands& get_commands();
+
+        /**
+         * @brief Apply every recorded command now.
+         */
+        void commands_flush();
+
+        /**
+         * @brief Schedule a system to run in `systems_update` after every system added so far.
+         * @param name Name used to remove the system and in log messages.
+         * @param function The system entry point.
+         * @param access Component types the system reads and writes.
+         * @param user_data Opaque pointer handed back to the system.
+         * @param prepare Optional callback to create the system's groups before its first run.
+         */
+        void system_add(std::string_view name, system_function function,
+                        const game_system_access& access, void* user_data = nullptr,
+                        system_prepare_function prepare = nullptr);
+        void system_remove(std::string_view name);
+
+        [[nodiscard]] game_system_scheduler& get_scheduler();
+
+        /**
+         * @brief Get the collider broadphase, rebuilt after physics in every update.
+         * @note Stored in the registry context so it moves along with the registry. Systems that
+         * query it declare `context_read<game_spatial_hash>()`, so they never run alongside the
+         * `"colliders"` rebuild.
+         */
+        [[nodiscard]] game_spatial_hash& get_spatial_hash();
+        [[nodiscard]] const game_spatial_hash& get_spatial_hash() const;
+
+        /**
+         * @brief Get the sprite index used by the renderer to cull whole viewports.
+         */
+        [[nodiscard]] game_render_index& get_render_index();
+
+        /**
+         * @brief Get the animation clips entities of this registry can play.
+         * @note Not emptied by `clear` or snapshots, restored animations keep their clips.
+         */
+        [[nodiscard]] game_animation_clips& get_animation_clips();
+        [[nodiscard]] const game_animation_clips& get_animation_clips() const;
+
+        /**
+         * @brief Invoke `callback(entity)` for every collider overlapping an axis aligned box.
+         */
+        template <typename F>
+        void query_aabb(const glm::vec2& min, const glm::vec2& max, F&& callback) const;
+
+        /**
+         * @brief Invoke `callback(entity)` for every collider overlapping a circle.
+         */
+        template <typename F>
+        void query_radius(const glm::vec2& center, float radius, F&& callback) const;
+
+        /**
+         * @brief Invoke `callback(first, second)` once for every pair of overlapping colliders.
+         */
+        template <typename F>
+        void collision_pairs_for_each(F&& callback) const;
+
+        void add_collider_circle(entt::entity entity, float radius);
+        void add_collider_aabb(entt::entity entity, const glm::vec2& half_size);
+
         [[nodiscard]] entt::entity create();
         void destroy(entt::entity entity);
 
         [[nodiscard]] bool is_valid(entt::entity entity) const;
         void clear();
 
+        /**
+         * @brief Spawn one entity from a prefab per element of `out`, all in one batch.
+         */
+        void prefab_spawn(const game_prefab& prefab, std::span<entt::entity> out);
+
+        /**
+         * @brief Grow the storages of a prefab's components ahead of a burst of spawns.
+         */
+        void prefab_reserve(const game_prefab& prefab, std::size_t count);
+
         entt::entity sprite_create(std::string_view resource_key);
         entt::entity sprite_create_interpolated(std::string_view resource_key);
         entt::entity create_text_dynamic(std::string_view resource_key);
 
+        /**
+         * @brief Create an entity with a position, rotation and particle emitter.
+         * @param sprite_key Resource key of the sprite every particle is drawn with.
+         * @param capacity Most particles alive at once, further spawns are dropped.
+         */
+        entt::entity particle_emitter_create(
+            std::string_view sprite_key, const game_particle_settings& settings,
+            std::size_t capacity = game_particle_pool::capacity_default);
+
+        /**
+         * @brief Spawn `count` particles from an emitter on the next tick, even if it is not
+         *        emitting.
+         */
+        void particles_burst(entt::entity entity, std::uint32_t count);
+
+        /**
+         * @brief Start playing a clip from its first frame on an entity's sprite.
+         * @return False if no clip uses the key, the entity's animation is left unchanged then.
+         */
+        bool animation_play(entt::entity entity, std::string_view clip_key, float speed = 1.f);
+        void animation_play(entt::entity entity, game_animation_clip::handle clip,
+                            float speed = 1.f);
+
+        /**
+         * @brief Pause or resume an animation where it is, without restarting its clip.
+         */
+        void set_animation_playing(entt::entity entity, bool is_playing);
+
+        /**
+         * @brief Write the entities and their components into a snapshot.
+         * @tparam Components Game specific components to store after the engine's own.
+         * @note Call between ticks, pending commands are not part of the snapshot.
+         */
+        template <class... Components>
+        void snapshot_write(game_snapshot& snapshot, std::uint64_t tick) const;
+
+        /**
+         * @brief Replace every entity with the ones in a snapshot.
+         * @tparam Components The same components the snapshot was written with.
+         * @note Restores into a new registry, so groups and storages created outside of
+         * scheduled systems have to be created again.
+         */
+        template <class... Components>
+        void snapshot_read(const game_snapshot& snapshot);
+
         // Component access - simplified API
         template <typename Component>
         Component& get(entt::entity entity);
@@ -123,8 +274,21 @@ namespace engine {
         void set_renderable_visible(entt::entity entity, bool is_visible);
         void set_renderable_layer(entt::entity entity, int layer);
 
+    private:
+        /**
+         * @brief Create the context variables and connect the signals every registry needs.
+         */
+        void registry_setup();
+
+        /**
+         * @brief Replace the registry with a freshly set up one, keeping the animation clips.
+         */
+        void registry_reset();
+
     private:
         entt::registry m_registry;
+        game_jobs* m_jobs;
+        game_system_scheduler m_scheduler;
     };
 
     // Inline implementations
@@ -136,6 +300,64 @@ namespace engine {
         return m_registry;
     }
 
+    inline game_system_scheduler& game_entities::get_scheduler() {
+        return m_scheduler;
+    }
+
+    inline game_spatial_hash& game_entities::get_spatial_hash() {
+        return m_registry.ctx().get<game_spatial_hash>();
+    }
+
+    inline const game_spatial_hash& game_entities::get_spatial_hash() const {
+        return m_registry.ctx().get<game_spatial_hash>();
+    }
+
+    inline game_render_index& game_entities::get_render_index() {
+        return m_registry.ctx().get<game_render_index>();
+    }
+
+    inline game_animation_clips& game_entities::get_animation_clips() {
+        return m_registry.ctx().get<game_animation_clips>();
+    }
+
+    inline const game_animation_clips& game_entities::get_animation_clips() const {
+        return m_registry.ctx().get<game_animation_clips>();
+    }
+
+    inline game_entity_commands& game_entities::get_commands() {
+        return m_registry.ctx().get<game_entity_commands>();
+    }
+
+    inline void game_entities::commands_flush() {
+        get_commands().flush(m_registry);
+    }
+
+    inline void game_entities::prefab_spawn(const game_prefab& prefab,
+                                            std::span<entt::entity> out) {
+        prefab.spawn(m_registry, out);
+    }
+
+    inline void game_entities::prefab_reserve(const game_prefab& prefab, const std::size_t count) {
+        prefab.reserve(m_registry, count);
+    }
+
+    template <typename F>
+    inline void game_entities::query_aabb(const glm::vec2& min, const glm::vec2& max,
+                                          F&& callback) const {
+        get_spatial_hash().query_aabb(min, max, std::forward<F>(callback));
+    }
+
+    template <typename F>
+    inline void game_entities::query_radius(const glm::vec2& center, const float radius,
+                                            F&& callback) const {
+        get_spatial_hash().query_radius(center, radius, std::forward<F>(callback));
+    }
+
+    template <typename F>
+    inline void game_entities::collision_pairs_for_each(F&& callback) const {
+        get_spatial_hash().pairs_for_each(std::forward<F>(callback));
+    }
+
     inline entt::entity game_entities::create() {
         return m_registry.create();
     }
@@ -151,7 +373,29 @@ namespace engine {
     }
 
     inline void game_entities::clear() {
+        get_commands().clear();
         m_registry.clear();
+        get_spatial_hash().clear();
+        get_render_index().clear();
+    }
+
+    template <class... Components>
+    inline void game_entities::snapshot_write(game_snapshot& snapshot,
+                                              const std::uint64_t tick) const {
+        snapshot.write<Components...>(m_registry, tick);
+    }
+
+    template <class... Components>
+    inline void game_entities::snapshot_read(const game_snapshot& snapshot) {
+        registry_reset();
+        snapshot.read<Components...>(m_registry);
+
+        // Groups are created after loading so they keep the packed order the snapshot stored.
+        m_scheduler.prepare(m_registry);
+
+        // Queries work right away instead of after the next tick's rebuild.
+        get_spatial_hash().rebuild(m_registry);
+        get_render_index().rebuild(m_registry);
     }
 
     template <typename Component>
@@ -0,0 +1,86 @@
+/**
+ * @file particles.cxx
+ * @brief Particle pool implementation.
+ */
+
+#include "particles.hxx"
+
+#include <algorithm>
+#include <utility>
+
+namespace engine {
+    game_particle_pool::game_particle_pool(const std::size_t capacity)
+        : m_data(capacity * field_count), m_capacity(capacity), m_count(0) {
+    }
+
+    bool game_particle_pool::spawn(const glm::vec2& position, const glm::vec2& velocity,
+                                   const float lifetime) {
+        if (m_count == m_capacity) {
+            return false;
+        }
+
+        const std::size_t i = m_count++;
+        field_get(field_position_x)[i] = position.x;
+        field_get(field_position_y)[i] = position.y;
+        field_get(field_previous_x)[i] = position.x;
+        field_get(field_previous_y)[i] = position.y;
+        field_get(field_velocity_x)[i] = velocity.x;
+        field_get(field_velocity_y)[i] = velocity.y;
+        field_get(field_remaining)[i] = lifetime;
+        field_get(field_lifetime)[i] = lifetime;
+
+        return true;
+    }
+
+    void game_particle_pool::expired_remove() noexcept {
+        const float* remaining = field_get(field_remaining);
+
+        std::size_t i = 0;
+        while (i < m_count) {
+            if (remaining[i] > 0.f) {
+                ++i;
+                continue;
+            }
+
+            // Move the last live particle into the hole, it is checked on the next iteration.
+            const std::size_t last = --m_count;
+            for (std::size_t field_index = 0; field_index < field_count; ++field_index) {
+                float* values = field_get(static_cast<field>(field_index));
+                values[i] = values[last];
+            }
+        }
+    }
+
+    void game_particle_pool::clear() noexcept {
+        m_count = 0;
+    }
+
+    void game_particle_pool::set_count(const std::size_t count) noexcept {
+        m_count = std::min(count, m_capacity);
+    }
+
+    void game_particle_pool::set_capacity(const std::size_t capacity) {
+        if (capacity == m_capacity) {
+            return;
+        }
+
+        std::vector<float> data(capacity * field_count);
+        const std::size_t count = std::min(m_count, capacity);
+
+        for (std::size_t field_index = 0; field_index < field_count; ++field_index) {
+            const float* values = field_get(static_cast<field>(field_index));
+            std::copy(values, values + count, data.data() + field_index * capacity);
+        }
+
+        m_data = std::move(data);
+        m_capacity = capacity;
+        m_count = count;
+    }
+
+    game_particle_arrays game_particle_pool::get_arrays() noexcept {
+        return {field_get(field_position_x), field_get(field_position_y),
+                field_get(field_previous_x), field_get(field_previous_y),
+                field_get(field_velocity_x), field_get(field_velocity_y),
+                field_get(field_remaining),  field_get(field_lifetime)};
+    }
+}  // namespace engine
@@ -0,0 +1,180 @@
+/**
+ * @file particles.hxx
+ * @brief Structure of arrays particle pools simulated by `system_particles`.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "../renderer/render_list.hxx"
+
+namespace engine {
+    /**
+     * @brief Pointers to the arrays of a particle pool, index for index.
+     */
+    struct game_particle_arrays {
+        float* position_x;
+        float* position_y;
+        float* previous_x;  ///< Position at the start of the last tick, for interpolation.
+        float* previous_y;
+        float* velocity_x;
+        float* velocity_y;
+        float* remaining;  ///< Seconds left, expired once it reaches zero.
+        float* lifetime;   ///< Seconds the particle was spawned with.
+    };
+
+    /**
+     * @brief Spawn and motion parameters shared by every particle of an emitter.
+     *
+     * Velocities follow the same drag as `component_velocity_linear` and lifetimes count down
+     * like `component_lifetime`, without a registry entity per particle.
+     */
+    struct game_particle_settings {
+        float rate = 0.f;  ///< Particles spawned per second while emitting.
+        float lifetime_min = 0.5f;
+        float lifetime_max = 1.f;
+        float speed_min = 50.f;
+        float speed_max = 100.f;
+        float direction = 0.f;  ///< Degrees, added to the emitter entity's rotation if it has one.
+        float spread = 360.f;   ///< Full width in degrees of the cone around `direction`.
+        glm::vec2 offset = {0.f, 0.f};  ///< Spawn point from the entity, rotated with it.
+        float spawn_radius = 0.f;       ///< Particles spawn anywhere within this distance.
+        glm::vec2 acceleration = {0.f, 0.f};  ///< Constant acceleration such as gravity.
+        float drag = 0.f;
+        game_particle_appearance appearance;
+        int layer = 0;
+    };
+
+    /**
+     * @brief A fixed capacity pool of particles stored as one array per field.
+     *
+     * Live particles are packed at the front of every array, so kernels stream over `count`
+     * floats per field with no gaps. Expired particles are replaced by the last live one, which
+     * keeps the arrays packed without shifting but does not preserve spawn order.
+     */
+    class game_particle_pool {
+    public:
+        static constexpr std::size_t capacity_default = 1024;
+
+    public:
+        explicit game_particle_pool(std::size_t capacity = capacity_default);
+
+        /**
+         * @brief Add a particle at rest for interpolation.
+         * @return False if the pool is full, the particle is dropped then.
+         */
+        bool spawn(const glm::vec2& position, const glm::vec2& velocity, float lifetime);
+
+        /**
+         * @brief Drop every particle whose remaining lifetime ran out.
+         */
+        void expired_remove() noexcept;
+
+        void clear() noexcept;
+
+        /**
+         * @brief Set how many particles at the front of the arrays are live, clamped to the
+         *        capacity.
+         * @note For restoring a pool whose arrays were written through `get_arrays`.
+         */
+        void set_count(std::size_t count) noexcept;
+
+        /**
+         * @brief Change the capacity, dropping the newest particles if it shrinks below count.
+         */
+        void set_capacity(std::size_t capacity);
+
+        [[nodiscard]] std::size_t get_count() const noexcept;
+        [[nodiscard]] std::size_t get_capacity() const noexcept;
+
+        /**
+         * @brief Get the arrays to simulate, valid until the capacity changes.
+         */
+        [[nodiscard]] game_particle_arrays get_arrays() noexcept;
+
+        [[nodiscard]] const float* get_position_x() const noexcept;
+        [[nodiscard]] const float* get_position_y() const noexcept;
+        [[nodiscard]] const float* get_previous_x() const noexcept;
+        [[nodiscard]] const float* get_previous_y() const noexcept;
+        [[nodiscard]] const float* get_velocity_x() const noexcept;
+        [[nodiscard]] const float* get_velocity_y() const noexcept;
+        [[nodiscard]] const float* get_remaining() const noexcept;
+        [[nodiscard]] const float* get_lifetime() const noexcept;
+
+    private:
+        /**
+         * @brief Order of the arrays inside `m_data`, each `m_capacity` floats long.
+         */
+        enum field : std::size_t {
+            field_position_x,
+            field_position_y,
+            field_previous_x,
+            field_previous_y,
+            field_velocity_x,
+            field_velocity_y,
+            field_remaining,
+            field_lifetime,
+            field_count
+        };
+
+        [[nodiscard]] float* field_get(field index) noexcept;
+        [[nodiscard]] const float* field_get(field index) const noexcept;
+
+    private:
+        std::vector<float> m_data;  ///< Every field in one allocation.
+        std::size_t m_capacity;
+        std::size_t m_count;
+    };
+
+    inline std::size_t game_particle_pool::get_count() const noexcept {
+        return m_count;
+    }
+
+    inline std::size_t game_particle_pool::get_capacity() const noexcept {
+        return m_capacity;
+    }
+
+    inline float* game_particle_pool::field_get(const field index) noexcept {
+        return m_data.data() + index * m_capacity;
+    }
+
+    inline const float* game_particle_pool::field_get(const field index) const noexcept {
+        return m_data.data() + index * m_capacity;
+    }
+
+    inline const float* game_particle_pool::get_position_x() const noexcept {
+        return field_get(field_position_x);
+    }
+
+    inline const float* game_particle_pool::get_position_y() const noexcept {
+        return field_get(field_position_y);
+    }
+
+    inline const float* game_particle_pool::get_previous_x() const noexcept {
+        return field_get(field_previous_x);
+    }
+
+    inline const float* game_particle_pool::get_previous_y() const noexcept {
+        return field_get(field_previous_y);
+    }
+
+    inline const float* game_particle_pool::get_velocity_x() const noexcept {
+        return field_get(field_velocity_x);
+    }
+
+    inline const float* game_particle_pool::get_velocity_y() const noexcept {
+        return field_get(field_velocity_y);
+    }
+
+    inline const float* game_particle_pool::get_remaining() const noexcept {
+        return field_get(field_remaining);
+    }
+
+    inline const float* game_particle_pool::get_lifetime() const noexcept {
+        return field_get(field_lifetime);
+    }
+}  // namespace engine
@@ -0,0 +1,605 @@
+#include "physics_kernels.hxx"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#include <SDL3/SDL.h>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define ENGINE_PHYSICS_KERNELS_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define ENGINE_PHYSICS_KERNELS_NEON 1
+#include <arm_neon.h>
+#endif
+
+// AVX code is compiled per function so the rest of the engine keeps the baseline target.
+#if defined(ENGINE_PHYSICS_KERNELS_X86) && (defined(__GNUC__) || defined(__clang__))
+#define ENGINE_TARGET_AVX __attribute__((target("avx")))
+#else
+#define ENGINE_TARGET_AVX
+#endif
+
+namespace engine {
+    // The SIMD kernels load velocities as rows of {x, y, max_speed, drag}.
+    static_assert(sizeof(component_velocity_linear) == 4 * sizeof(float));
+    static_assert(offsetof(component_velocity_linear, value) == 0);
+    static_assert(offsetof(component_velocity_linear, max_speed) == 2 * sizeof(float));
+    static_assert(offsetof(component_velocity_linear, drag) == 3 * sizeof(float));
+    static_assert(sizeof(component_velocity_angular) == 3 * sizeof(float));
+
+    // Positions and rotations are streamed as packed {x, y} pairs and packed floats.
+    static_assert(sizeof(component_position) == 2 * sizeof(float));
+    static_assert(sizeof(component_rotation) == sizeof(float));
+
+    namespace {
+        /**
+         * @brief Wrap an angle into [0, 360) degrees without looping.
+         */
+        [[nodiscard]] float normalize_degrees(const float degrees) noexcept {
+            float result = degrees - 360.0f * std::floor(degrees * (1.0f / 360.0f));
+
+            // Tiny negative angles round up to a full turn, which belongs to zero.
+            if (result >= 360.0f) {
+                result -= 360.0f;
+            }
+
+            return result;
+        }
+
+        void integrate_linear_scalar(component_velocity_linear* velocities,
+                                     component_position* positions, const std::size_t count,
+                                     const float tick_interval) {
+            for (std::size_t i = 0; i < count; ++i) {
+                component_velocity_linear& velocity_linear = velocities[i];
+                glm::vec2 velocity = velocity_linear.value;
+
+                const float drag = std::max(0.0f, velocity_linear.drag);
+                velocity *= std::max(0.0f, 1.0f - (drag * tick_interval));
+
+                const float speed = glm::length(velocity);
+                const float max_speed = velocity_linear.max_speed;
+                if (max_speed > 0.0f && speed > max_speed) {
+                    velocity *= max_speed / speed;
+                }
+
+                velocity_linear.value = velocity;
+                positions[i].value += velocity * tick_interval;
+            }
+        }
+
+        void integrate_angular_scalar(component_velocity_angular* velocities,
+                                      component_rotation* rotations, const std::size_t count,
+                                      const float tick_interval) {
+            for (std::size_t i = 0; i < count; ++i) {
+                component_velocity_angular& velocity_angular = velocities[i];
+                float velocity = velocity_angular.value;
+
+                const float drag = std::max(0.0f, velocity_angular.drag);
+                velocity *= std::max(0.0f, 1.0f - (drag * tick_interval));
+
+                const float max_speed = velocity_angular.max_speed;
+                if (max_speed > 0.0f) {
+                    velocity = std::clamp(velocity, -max_speed, max_speed);
+                }
+
+                velocity_angular.value = velocity;
+                rotations[i].value =
+                    normalize_degrees(rotations[i].value + velocity * tick_interval);
+            }
+        }
+
+        /**
+         * @brief Get the arrays of a pool starting at particle `offset`, for the scalar tail.
+         */
+        [[nodiscard]] game_particle_arrays particle_arrays_advance(
+            const game_particle_arrays& particles, const std::size_t offset) noexcept {
+            return {particles.position_x + offset, particles.position_y + offset,
+                    particles.previous_x + offset, particles.previous_y + offset,
+                    particles.velocity_x + offset, particles.velocity_y + offset,
+                    particles.remaining + offset,  particles.lifetime + offset};
+        }
+
+        void integrate_particles_scalar(const game_particle_arrays& particles,
+                                        const std::size_t count, const glm::vec2 acceleration,
+                                        const float drag, const float tick_interval) {
+            const float drag_factor = std::max(0.0f, 1.0f - (std::max(0.0f, drag) * tick_interval));
+            const glm::vec2 impulse = acceleration * tick_interval;
+
+            for (std::size_t i = 0; i < count; ++i) {
+                particles.previous_x[i] = particles.position_x[i];
+                particles.previous_y[i] = particles.position_y[i];
+
+                particles.velocity_x[i] = particles.velocity_x[i] * drag_factor + impulse.x;
+                particles.velocity_y[i] = particles.velocity_y[i] * drag_factor + impulse.y;
+
+                particles.position_x[i] += particles.velocity_x[i] * tick_interval;
+                particles.position_y[i] += particles.velocity_y[i] * tick_interval;
+                particles.remaining[i] -= tick_interval;
+            }
+        }
+
+#if defined(ENGINE_PHYSICS_KERNELS_X86)
+        inline __m128 select_sse(const __m128 mask, const __m128 if_true, const __m128 if_false) {
+            return _mm_or_ps(_mm_and_ps(mask, if_true), _mm_andnot_ps(mask, if_false));
+        }
+
+        /**
+         * @brief Floor four floats with SSE2 only, exact for magnitudes below 2^31.
+         */
+        inline __m128 floor_sse(const __m128 value) {
+            const __m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(value));
+            return _mm_sub_ps(truncated,
+                              _mm_and_ps(_mm_cmpgt_ps(truncated, value), _mm_set1_ps(1.0f)));
+        }
+
+        void integrate_linear_sse(component_velocity_linear* velocities,
+                                  component_position* positions, const std::size_t count,
+                                  const float tick_interval) {
+            const __m128 dt = _mm_set1_ps(tick_interval);
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 one = _mm_set1_ps(1.0f);
+
+            std::size_t i = 0;
+            for (; i + 4 <= count; i += 4) {
+                float* rows = &velocities[i].value.x;
+
+                __m128 x = _mm_loadu_ps(rows + 0);
+                __m128 y = _mm_loadu_ps(rows + 4);
+                __m128 max_speed = _mm_loadu_ps(rows + 8);
+                __m128 drag = _mm_loadu_ps(rows + 12);
+                _MM_TRANSPOSE4_PS(x, y, max_speed, drag);
+
+                const __m128 drag_factor =
+                    _mm_max_ps(zero, _mm_sub_ps(one, _mm_mul_ps(_mm_max_ps(zero, drag), dt)));
+                x = _mm_mul_ps(x, drag_factor);
+                y = _mm_mul_ps(y, drag_factor);
+
+                const __m128 speed = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)));
+                const __m128 clamp_mask = _mm_and_ps(_mm_cmpgt_ps(max_speed, zero),
+                                                     _mm_cmpgt_ps(speed, max_speed));
+                const __m128 scale = select_sse(clamp_mask, _mm_div_ps(max_speed, speed), one);
+                x = _mm_mul_ps(x, scale);
+                y = _mm_mul_ps(y, scale);
+
+                // Interleave the steps back into {x, y} pairs to add them to four positions.
+                const __m128 step_x = _mm_mul_ps(x, dt);
+                const __m128 step_y = _mm_mul_ps(y, dt);
+                float* position = &positions[i].value.x;
+                _mm_storeu_ps(position + 0, _mm_add_ps(_mm_loadu_ps(position + 0),
+                                                       _mm_unpacklo_ps(step_x, step_y)));
+                _mm_storeu_ps(position + 4, _mm_add_ps(_mm_loadu_ps(position + 4),
+                                                       _mm_unpackhi_ps(step_x, step_y)));
+
+                _MM_TRANSPOSE4_PS(x, y, max_speed, drag);
+                _mm_storeu_ps(rows + 0, x);
+                _mm_storeu_ps(rows + 4, y);
+                _mm_storeu_ps(rows + 8, max_speed);
+                _mm_storeu_ps(rows + 12, drag);
+            }
+
+            integrate_linear_scalar(velocities + i, positions + i, count - i, tick_interval);
+        }
+
+        void integrate_angular_sse(component_velocity_angular* velocities,
+                                   component_rotation* rotations, const std::size_t count,
+                                   const float tick_interval) {
+            const __m128 dt = _mm_set1_ps(tick_interval);
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 one = _mm_set1_ps(1.0f);
+            const __m128 full_turn = _mm_set1_ps(360.0f);
+            const __m128 full_turn_inverse = _mm_set1_ps(1.0f / 360.0f);
+
+            std::size_t i = 0;
+            for (; i + 4 <= count; i += 4) {
+                component_velocity_angular* v = velocities + i;
+
+                // Rows are 12 bytes wide, so gather lanes instead of transposing.
+                __m128 value = _mm_setr_ps(v[0].value, v[1].value, v[2].value, v[3].value);
+                const __m128 max_speed =
+                    _mm_setr_ps(v[0].max_speed, v[1].max_speed, v[2].max_speed, v[3].max_speed);
+                const __m128 drag = _mm_setr_ps(v[0].drag, v[1].drag, v[2].drag, v[3].drag);
+
+                const __m128 drag_factor =
+                    _mm_max_ps(zero, _mm_sub_ps(one, _mm_mul_ps(_mm_max_ps(zero, drag), dt)));
+                value = _mm_mul_ps(value, drag_factor);
+
+                const __m128 clamped =
+                    _mm_min_ps(_mm_max_ps(value, _mm_sub_ps(zero, max_speed)), max_speed);
+                value = select_sse(_mm_cmpgt_ps(max_speed, zero), clamped, value);
+
+                alignas(16) float result[4];
+                _mm_store_ps(result, value);
+                for (std::size_t lane = 0; lane < 4; ++lane) {
+                    v[lane].value = result[lane];
+                }
+
+                float* rotation = &rotations[i].value;
+                __m128 degrees = _mm_add_ps(_mm_loadu_ps(rotation), _mm_mul_ps(value, dt));
+                degrees = _mm_sub_ps(
+                    degrees,
+                    _mm_mul_ps(full_turn, floor_sse(_mm_mul_ps(degrees, full_turn_inverse))));
+                degrees = _mm_sub_ps(degrees,
+                                     _mm_and_ps(_mm_cmpge_ps(degrees, full_turn), full_turn));
+                _mm_storeu_ps(rotation, degrees);
+            }
+
+            integrate_angular_scalar(velocities + i, rotations + i, count - i, tick_interval);
+        }
+
+        void integrate_particles_sse(const game_particle_arrays& particles, const std::size_t count,
+                                     const glm::vec2 acceleration, const float drag,
+                                     const float tick_interval) {
+            const __m128 dt = _mm_set1_ps(tick_interval);
+            const __m128 drag_factor =
+                _mm_set1_ps(std::max(0.0f, 1.0f - (std::max(0.0f, drag) * tick_interval)));
+            const __m128 impulse_x = _mm_set1_ps(acceleration.x * tick_interval);
+            const __m128 impulse_y = _mm_set1_ps(acceleration.y * tick_interval);
+
+            // Every field is its own array, so lanes load straight without transposing.
+            std::size_t i = 0;
+            for (; i + 4 <= count; i += 4) {
+                const __m128 x = _mm_loadu_ps(particles.position_x + i);
+                const __m128 y = _mm_loadu_ps(particles.position_y + i);
+                _mm_storeu_ps(particles.previous_x + i, x);
+                _mm_storeu_ps(particles.previous_y + i, y);
+
+                const __m128 velocity_x = _mm_add_ps(
+                    _mm_mul_ps(_mm_loadu_ps(particles.velocity_x + i), drag_factor), impulse_x);
+                const __m128 velocity_y = _mm_add_ps(
+                    _mm_mul_ps(_mm_loadu_ps(particles.velocity_y + i), drag_factor), impulse_y);
+                _mm_storeu_ps(particles.velocity_x + i, velocity_x);
+                _mm_storeu_ps(particles.velocity_y + i, velocity_y);
+
+                _mm_storeu_ps(particles.position_x + i, _mm_add_ps(x, _mm_mul_ps(velocity_x, dt)));
+                _mm_storeu_ps(particles.position_y + i, _mm_add_ps(y, _mm_mul_ps(velocity_y, dt)));
+                _mm_storeu_ps(particles.remaining + i,
+                              _mm_sub_ps(_mm_loadu_ps(particles.remaining + i), dt));
+            }
+
+            integrate_particles_scalar(particle_arrays_advance(particles, i), count - i,
+                                       acceleration, drag, tick_interval);
+        }
+
+        ENGINE_TARGET_AVX inline __m256 combine_avx(const __m128 low, const __m128 high) {
+            return _mm256_insertf128_ps(_mm256_castps128_ps256(low), high, 1);
+        }
+
+        ENGINE_TARGET_AVX void integrate_linear_avx(component_velocity_linear* velocities,
+                                                    component_position* positions,
+                                                    const std::size_t count,
+                                                    const float tick_interval) {
+            const __m256 dt = _mm256_set1_ps(tick_interval);
+            const __m256 zero = _mm256_setzero_ps();
+            const __m256 one = _mm256_set1_ps(1.0f);
+
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8) {
+                float* rows = &velocities[i].value.x;
+
+                // Transpose each half of eight {x, y, max_speed, drag} rows, then join them.
+                __m128 x_lo = _mm_loadu_ps(rows + 0);
+                __m128 y_lo = _mm_loadu_ps(rows + 4);
+                __m128 max_lo = _mm_loadu_ps(rows + 8);
+                __m128 drag_lo = _mm_loadu_ps(rows + 12);
+                __m128 x_hi = _mm_loadu_ps(rows + 16);
+                __m128 y_hi = _mm_loadu_ps(rows + 20);
+                __m128 max_hi = _mm_loadu_ps(rows + 24);
+                __m128 drag_hi = _mm_loadu_ps(rows + 28);
+                _MM_TRANSPOSE4_PS(x_lo, y_lo, max_lo, drag_lo);
+                _MM_TRANSPOSE4_PS(x_hi, y_hi, max_hi, drag_hi);
+
+                __m256 x = combine_avx(x_lo, x_hi);
+                __m256 y = combine_avx(y_lo, y_hi);
+                const __m256 max_speed = combine_avx(max_lo, max_hi);
+                const __m256 drag = combine_avx(drag_lo, drag_hi);
+
+                const __m256 drag_factor = _mm256_max_ps(
+                    zero, _mm256_sub_ps(one, _mm256_mul_ps(_mm256_max_ps(zero, drag), dt)));
+                x = _mm256_mul_ps(x, drag_factor);
+                y = _mm256_mul_ps(y, drag_factor);
+
+                const __m256 speed =
+                    _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)));
+                const __m256 clamp_mask =
+                    _mm256_and_ps(_mm256_cmp_ps(max_speed, zero, _CMP_GT_OQ),
+                                  _mm256_cmp_ps(speed, max_speed, _CMP_GT_OQ));
+                const __m256 scale =
+                    _mm256_blendv_ps(one, _mm256_div_ps(max_speed, speed), clamp_mask);
+                x = _mm256_mul_ps(x, scale);
+                y = _mm256_mul_ps(y, scale);
+
+                // Unpacking works per 128-bit half, so the halves are swapped back in order.
+                const __m256 step_x = _mm256_mul_ps(x, dt);
+                const __m256 step_y = _mm256_mul_ps(y, dt);
+                const __m256 step_low = _mm256_unpacklo_ps(step_x, step_y);
+                const __m256 step_high = _mm256_unpackhi_ps(step_x, step_y);
+                float* position = &positions[i].value.x;
+                _mm256_storeu_ps(position + 0,
+                                 _mm256_add_ps(_mm256_loadu_ps(position + 0),
+                                               _mm256_permute2f128_ps(step_low, step_high, 0x20)));
+                _mm256_storeu_ps(position + 8,
+                                 _mm256_add_ps(_mm256_loadu_ps(position + 8),
+                                               _mm256_permute2f128_ps(step_low, step_high, 0x31)));
+
+                x_lo = _mm256_castps256_ps128(x);
+                y_lo = _mm256_castps256_ps128(y);
+                x_hi = _mm256_extractf128_ps(x, 1);
+                y_hi = _mm256_extractf128_ps(y, 1);
+                _MM_TRANSPOSE4_PS(x_lo, y_lo, max_lo, drag_lo);
+                _MM_TRANSPOSE4_PS(x_hi, y_hi, max_hi, drag_hi);
+                _mm_storeu_ps(rows + 0, x_lo);
+                _mm_storeu_ps(rows + 4, y_lo);
+                _mm_storeu_ps(rows + 8, max_lo);
+                _mm_storeu_ps(rows + 12, drag_lo);
+                _mm_storeu_ps(rows + 16, x_hi);
+                _mm_storeu_ps(rows + 20, y_hi);
+                _mm_storeu_ps(rows + 24, max_hi);
+                _mm_storeu_ps(rows + 28, drag_hi);
+            }
+
+            integrate_linear_sse(velocities + i, positions + i, count - i, tick_interval);
+        }
+
+        ENGINE_TARGET_AVX void integrate_angular_avx(component_velocity_angular* velocities,
+                                                     component_rotation* rotations,
+                                                     const std::size_t count,
+                                                     const float tick_interval) {
+            const __m256 dt = _mm256_set1_ps(tick_interval);
+            const __m256 zero = _mm256_setzero_ps();
+            const __m256 one = _mm256_set1_ps(1.0f);
+            const __m256 full_turn = _mm256_set1_ps(360.0f);
+            const __m256 full_turn_inverse = _mm256_set1_ps(1.0f / 360.0f);
+
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8) {
+                component_velocity_angular* v = velocities + i;
+
+                __m256 value = _mm256_setr_ps(v[0].value, v[1].value, v[2].value, v[3].value,
+                                              v[4].value, v[5].value, v[6].value, v[7].value);
+                const __m256 max_speed = _mm256_setr_ps(
+                    v[0].max_speed, v[1].max_speed, v[2].max_speed, v[3].max_speed,
+                    v[4].max_speed, v[5].max_speed, v[6].max_speed, v[7].max_speed);
+                const __m256 drag = _mm256_setr_ps(v[0].drag, v[1].drag, v[2].drag, v[3].drag,
+                                                   v[4].drag, v[5].drag, v[6].drag, v[7].drag);
+
+                const __m256 drag_factor = _mm256_max_ps(
+                    zero, _mm256_sub_ps(one, _mm256_mul_ps(_mm256_max_ps(zero, drag), dt)));
+                value = _mm256_mul_ps(value, drag_factor);
+
+                const __m256 clamped = _mm256_min_ps(
+                    _mm256_max_ps(value, _mm256_sub_ps(zero, max_speed)), max_speed);
+                value = _mm256_blendv_ps(value, clamped,
+                                         _mm256_cmp_ps(max_speed, zero, _CMP_GT_OQ));
+
+                alignas(32) float result[8];
+                _mm256_store_ps(result, value);
+                for (std::size_t lane = 0; lane < 8; ++lane) {
+                    v[lane].value = result[lane];
+                }
+
+                float* rotation = &rotations[i].value;
+                __m256 degrees =
+                    _mm256_add_ps(_mm256_loadu_ps(rotation), _mm256_mul_ps(value, dt));
+                degrees = _mm256_sub_ps(
+                    degrees, _mm256_mul_ps(full_turn, _mm256_floor_ps(_mm256_mul_ps(
+                                                          degrees, full_turn_inverse))));
+                degrees = _mm256_sub_ps(
+                    degrees,
+                    _mm256_and_ps(_mm256_cmp_ps(degrees, full_turn, _CMP_GE_OQ), full_turn));
+                _mm256_storeu_ps(rotation, degrees);
+            }
+
+            integrate_angular_sse(velocities + i, rotations + i, count - i, tick_interval);
+        }
+
+        ENGINE_TARGET_AVX void integrate_particles_avx(const game_particle_arrays& particles,
+                                                       const std::size_t count,
+                                                       const glm::vec2 acceleration,
+                                                       const float drag,
+                                                       const float tick_interval) {
+            const __m256 dt = _mm256_set1_ps(tick_interval);
+            const __m256 drag_factor =
+                _mm256_set1_ps(std::max(0.0f, 1.0f - (std::max(0.0f, drag) * tick_interval)));
+            const __m256 impulse_x = _mm256_set1_ps(acceleration.x * tick_interval);
+            const __m256 impulse_y = _mm256_set1_ps(acceleration.y * tick_interval);
+
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8) {
+                const __m256 x = _mm256_loadu_ps(particles.position_x + i);
+                const __m256 y = _mm256_loadu_ps(particles.position_y + i);
+                _mm256_storeu_ps(particles.previous_x + i, x);
+                _mm256_storeu_ps(particles.previous_y + i, y);
+
+                const __m256 velocity_x = _mm256_add_ps(
+                    _mm256_mul_ps(_mm256_loadu_ps(particles.velocity_x + i), drag_factor),
+                    impulse_x);
+                const __m256 velocity_y = _mm256_add_ps(
+                    _mm256_mul_ps(_mm256_loadu_ps(particles.velocity_y + i), drag_factor),
+                    impulse_y);
+                _mm256_storeu_ps(particles.velocity_x + i, velocity_x);
+                _mm256_storeu_ps(particles.velocity_y + i, velocity_y);
+
+                _mm256_storeu_ps(particles.position_x + i,
+                                 _mm256_add_ps(x, _mm256_mul_ps(velocity_x, dt)));
+                _mm256_storeu_ps(particles.position_y + i,
+                                 _mm256_add_ps(y, _mm256_mul_ps(velocity_y, dt)));
+                _mm256_storeu_ps(particles.remaining + i,
+                                 _mm256_sub_ps(_mm256_loadu_ps(particles.remaining + i), dt));
+            }
+
+            integrate_particles_sse(particle_arrays_advance(particles, i), count - i,
+                                    acceleration, drag, tick_interval);
+        }
+#endif
+
+#if defined(ENGINE_PHYSICS_KERNELS_NEON)
+        void integrate_linear_neon(component_velocity_linear* velocities,
+                                   component_position* positions, const std::size_t count,
+                                   const float tick_interval) {
+            const float32x4_t dt = vdupq_n_f32(tick_interval);
+            const float32x4_t zero = vdupq_n_f32(0.0f);
+            const float32x4_t one = vdupq_n_f32(1.0f);
+
+            std::size_t i = 0;
+            for (; i + 4 <= count; i += 4) {
+                float* rows = &velocities[i].value.x;
+
+                // De-interleaves four {x, y, max_speed, drag} rows into one register each.
+                float32x4x4_t lanes = vld4q_f32(rows);
+                float32x4_t x = lanes.val[0];
+                float32x4_t y = lanes.val[1];
+                const float32x4_t max_speed = lanes.val[2];
+                const float32x4_t drag = lanes.val[3];
+
+                const float32x4_t drag_factor =
+                    vmaxq_f32(zero, vsubq_f32(one, vmulq_f32(vmaxq_f32(zero, drag), dt)));
+                x = vmulq_f32(x, drag_factor);
+                y = vmulq_f32(y, drag_factor);
+
+                const float32x4_t speed = vsqrtq_f32(vaddq_f32(vmulq_f32(x, x), vmulq_f32(y, y)));
+                const uint32x4_t clamp_mask =
+                    vandq_u32(vcgtq_f32(max_speed, zero), vcgtq_f32(speed, max_speed));
+                const float32x4_t scale = vbslq_f32(clamp_mask, vdivq_f32(max_speed, speed), one);
+                x = vmulq_f32(x, scale);
+                y = vmulq_f32(y, scale);
+
+                lanes.val[0] = x;
+                lanes.val[1] = y;
+                vst4q_f32(rows, lanes);
+
+                float* position = &positions[i].value.x;
+                float32x4x2_t pairs = vld2q_f32(position);
+                pairs.val[0] = vmlaq_f32(pairs.val[0], x, dt);
+                pairs.val[1] = vmlaq_f32(pairs.val[1], y, dt);
+                vst2q_f32(position, pairs);
+            }
+
+            integrate_linear_scalar(velocities + i, positions + i, count - i, tick_interval);
+        }
+
+        void integrate_angular_neon(component_velocity_angular* velocities,
+                                    component_rotation* rotations, const std::size_t count,
+                                    const float tick_interval) {
+            const float32x4_t dt = vdupq_n_f32(tick_interval);
+            const float32x4_t zero = vdupq_n_f32(0.0f);
+            const float32x4_t one = vdupq_n_f32(1.0f);
+            const float32x4_t full_turn = vdupq_n_f32(360.0f);
+            const float32x4_t full_turn_inverse = vdupq_n_f32(1.0f / 360.0f);
+
+            std::size_t i = 0;
+            for (; i + 4 <= count; i += 4) {
+                float* rows = &velocities[i].value;
+
+                // De-interleaves four {value, max_speed, drag} rows.
+                float32x4x3_t lanes = vld3q_f32(rows);
+                float32x4_t value = lanes.val[0];
+                const float32x4_t max_speed = lanes.val[1];
+                const float32x4_t drag = lanes.val[2];
+
+                const float32x4_t drag_factor =
+                    vmaxq_f32(zero, vsubq_f32(one, vmulq_f32(vmaxq_f32(zero, drag), dt)));
+                value = vmulq_f32(value, drag_factor);
+
+                const float32x4_t clamped = vminq_f32(vmaxq_f32(value, vnegq_f32(max_speed)),
+                                                      max_speed);
+                value = vbslq_f32(vcgtq_f32(max_speed, zero), clamped, value);
+                lanes.val[0] = value;
+                vst3q_f32(rows, lanes);
+
+                float* rotation = &rotations[i].value;
+                float32x4_t degrees = vmlaq_f32(vld1q_f32(rotation), value, dt);
+                degrees = vmlsq_f32(degrees, full_turn,
+                                    vrndmq_f32(vmulq_f32(degrees, full_turn_inverse)));
+                degrees = vsubq_f32(degrees, vreinterpretq_f32_u32(vandq_u32(
+                                                 vcgeq_f32(degrees, full_turn),
+                                                 vreinterpretq_u32_f32(full_turn))));
+                vst1q_f32(rotation, degrees);
+            }
+
+            integrate_angular_scalar(velocities + i, rotations + i, count - i, tick_interval);
+        }
+
+        void integrate_particles_neon(const game_particle_arrays& particles,
+                                      const std::size_t count, const glm::vec2 acceleration,
+                                      const float drag, const float tick_interval) {
+            const float32x4_t dt = vdupq_n_f32(tick_interval);
+            const float32x4_t drag_factor =
+                vdupq_n_f32(std::max(0.0f, 1.0f - (std::max(0.0f, drag) * tick_interval)));
+            const float32x4_t impulse_x = vdupq_n_f32(acceleration.x * tick_interval);
+            const float32x4_t impulse_y = vdupq_n_f32(acceleration.y * tick_interval);
+
+            std::size_t i = 0;
+            for (; i + 4 <= count; i += 4) {
+                const float32x4_t x = vld1q_f32(particles.position_x + i);
+                const float32x4_t y = vld1q_f32(particles.position_y + i);
+                vst1q_f32(particles.previous_x + i, x);
+                vst1q_f32(particles.previous_y + i, y);
+
+                const float32x4_t velocity_x =
+                    vmlaq_f32(impulse_x, vld1q_f32(particles.velocity_x + i), drag_factor);
+                const float32x4_t velocity_y =
+                    vmlaq_f32(impulse_y, vld1q_f32(particles.velocity_y + i), drag_factor);
+                vst1q_f32(particles.velocity_x + i, velocity_x);
+                vst1q_f32(particles.velocity_y + i, velocity_y);
+
+                vst1q_f32(particles.position_x + i, vmlaq_f32(x, velocity_x, dt));
+                vst1q_f32(particles.position_y + i, vmlaq_f32(y, velocity_y, dt));
+                vst1q_f32(particles.remaining + i,
+                          vsubq_f32(vld1q_f32(particles.remaining + i), dt));
+            }
+
+            integrate_particles_scalar(particle_arrays_advance(particles, i), count - i,
+                                       acceleration, drag, tick_interval);
+        }
+#endif
+
+        constexpr physics_kernels kernels_scalar = {
+            physics_kernel_isa::scalar, 1, integrate_linear_scalar, integrate_angular_scalar,
+            integrate_particles_scalar};
+
+        physics_kernels select_best_kernels() noexcept {
+#if defined(ENGINE_PHYSICS_KERNELS_X86)
+            if (SDL_HasAVX() == true) {
+                return {physics_kernel_isa::avx, 8, integrate_linear_avx, integrate_angular_avx,
+                        integrate_particles_avx};
+            }
+
+            if (SDL_HasSSE2() == true) {
+                return {physics_kernel_isa::sse, 4, integrate_linear_sse, integrate_angular_sse,
+                        integrate_particles_sse};
+            }
+#elif defined(ENGINE_PHYSICS_KERNELS_NEON)
+            if (SDL_HasNEON() == true) {
+                return {physics_kernel_isa::neon, 4, integrate_linear_neon,
+                        integrate_angular_neon, integrate_particles_neon};
+            }
+#endif
+            return kernels_scalar;
+        }
+    }  // namespace
+
+    const physics_kernels& physics_kernels_best() noexcept {
+        static const physics_kernels best = select_best_kernels();
+        return best;
+    }
+
+    const physics_kernels& physics_kernels_scalar() noexcept {
+        return kernels_scalar;
+    }
+
+    std::string_view physics_kernel_isa_name(const physics_kernel_isa isa) noexcept {
+        switch (isa) {
+            case physics_kernel_isa::sse:
+                return "sse";
+            case physics_kernel_isa::avx:
+                return "avx";
+            case physics_kernel_isa::neon:
+                return "neon";
+            case physics_kernel_isa::scalar:
+            default:
+                return "scalar";
+        }
+    }
+}  // namespace engine
@@ -0,0 +1,77 @@
+/**
+ * @file physics_kernels.hxx
+ * @brief Vectorized velocity integration kernels with runtime CPU feature selection.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+#include "components.hxx"
+
+namespace engine {
+    /**
+     * @brief Instruction sets a physics kernel can be built for.
+     */
+    enum class physics_kernel_isa { scalar, sse, avx, neon };
+
+    /**
+     * @brief A set of velocity integration kernels for one instruction set.
+     *
+     * Every kernel applies drag and the max speed clamp the same way `system_physics` does and
+     * works on contiguous arrays, such as a single page of an EnTT storage.
+     */
+    struct physics_kernels {
+        physics_kernel_isa isa;
+        std::size_t lanes;  ///< Entities processed per loop iteration.
+
+        /**
+         * @brief Apply drag and max speed to linear velocities and integrate positions.
+         * @param velocities Contiguous linear velocities, updated in place.
+         * @param positions Positions matching `velocities` index for index.
+         * @param count Number of entities in both arrays.
+         * @param tick_interval Fixed tick interval in seconds.
+         */
+        void (*integrate_linear)(component_velocity_linear* velocities,
+                                 component_position* positions, std::size_t count,
+                                 float tick_interval);
+
+        /**
+         * @brief Apply drag and max speed to angular velocities and integrate rotations.
+         * @param velocities Contiguous angular velocities, updated in place.
+         * @param rotations Rotations matching `velocities` index for index, kept in [0, 360).
+         * @param count Number of entities in both arrays.
+         * @param tick_interval Fixed tick interval in seconds.
+         */
+        void (*integrate_angular)(component_velocity_angular* velocities,
+                                  component_rotation* rotations, std::size_t count,
+                                  float tick_interval);
+
+        /**
+         * @brief Store previous positions, apply drag and acceleration, then move and age
+         *        the particles of one pool.
+         * @param particles Arrays of the pool, updated in place.
+         * @param count Number of live particles.
+         * @param acceleration Added to every velocity per second, after drag.
+         * @param drag Applied like `component_velocity_linear::drag`.
+         * @param tick_interval Fixed tick interval in seconds.
+         */
+        void (*integrate_particles)(const game_particle_arrays& particles, std::size_t count,
+                                    glm::vec2 acceleration, float drag, float tick_interval);
+    };
+
+    /**
+     * @brief Get the widest kernels supported by the running CPU.
+     * @return Kernels selected once on first call, falling back to scalar ones.
+     */
+    [[nodiscard]] const physics_kernels& physics_kernels_best() noexcept;
+
+    /**
+     * @brief Get the portable scalar kernels.
+     * @return Reference kernels matching the original per-entity implementation.
+     */
+    [[nodiscard]] const physics_kernels& physics_kernels_scalar() noexcept;
+
+    [[nodiscard]] std::string_view physics_kernel_isa_name(physics_kernel_isa isa) noexcept;
+}  // namespace engine
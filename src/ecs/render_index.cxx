@@ -0,0 +1,120 @@
+/**
+ * @file render_index.cxx
+ * @brief Sprite render index implementation.
+ */
+
+#include "render_index.hxx"
+
+#include <algorithm>
+
+#include "components.hxx"
+
+namespace engine {
+    void game_render_index::rebuild(entt::registry& registry) {
+        m_hash.clear();
+        loose_clear();
+        m_scale_max = 1.0f;
+
+        auto view = registry.view<component_position, component_scale, component_sprite,
+                                  component_renderable>();
+        for (auto [entity, position, scale_comp, sprite, renderable] : view.each()) {
+            glm::vec2 min = position.value;
+            glm::vec2 max = position.value;
+
+            if (const auto* interp = registry.try_get<component_interpolation>(entity)) {
+                min = glm::min(min, interp->previous_position);
+                max = glm::max(max, interp->previous_position);
+            }
+
+            const glm::vec2 scale = glm::abs(scale_comp.value);
+            m_scale_max = std::max({m_scale_max, scale.x, scale.y});
+
+            m_hash.insert_aabb(entity, min, max);
+        }
+
+        m_hash.build();
+        m_is_built = true;
+    }
+
+    void game_render_index::clear() {
+        m_hash.clear();
+        loose_clear();
+        m_visible.clear();
+        m_scale_max = 1.0f;
+        m_is_built = false;
+    }
+
+    void game_render_index::mark_loose(const entt::entity entity) {
+        if (m_is_built == false) {
+            return;
+        }
+
+        const auto index = static_cast<std::size_t>(entt::to_entity(entity));
+        if (index >= m_loose_slots.size()) {
+            m_loose_slots.resize(index + 1, 0);
+        }
+
+        // A recycled identifier replaces the destroyed entity that last used its index.
+        if (const std::uint32_t slot = m_loose_slots[index]; slot != 0) {
+            m_loose[slot - 1] = entity;
+            return;
+        }
+
+        m_loose.push_back(entity);
+        m_loose_slots[index] = static_cast<std::uint32_t>(m_loose.size());
+    }
+
+    void game_render_index::loose_clear() noexcept {
+        for (const entt::entity entity : m_loose) {
+            m_loose_slots[static_cast<std::size_t>(entt::to_entity(entity))] = 0;
+        }
+
+        m_loose.clear();
+    }
+
+    std::span<const entt::entity> game_render_index::visible_collect(entt::registry& registry,
+                                                                     const glm::vec2& min,
+                                                                     const glm::vec2& max) {
+        m_sort_scratch.clear();
+        m_visible.clear();
+
+        const auto& sprites = registry.storage<component_sprite>();
+
+        // Entities can be destroyed or lose their sprite between rebuilds.
+        const auto is_drawable = [&](const entt::entity entity) {
+            return registry.valid(entity) == true && sprites.contains(entity) == true &&
+                   registry.all_of<component_position, component_rotation, component_scale,
+                                   component_renderable>(entity) == true;
+        };
+
+        m_hash.query_aabb(min, max, [&](const entt::entity entity) {
+            if (is_drawable(entity) == true) {
+                m_sort_scratch.emplace_back(sprites.index(entity), entity);
+            }
+        });
+
+        for (const entt::entity entity : m_loose) {
+            if (is_drawable(entity) == true) {
+                m_sort_scratch.emplace_back(sprites.index(entity), entity);
+            }
+        }
+
+        // Storage order keeps the draw order identical to iterating the whole view, and puts
+        // loose entities that were also indexed next to their duplicate.
+        std::sort(m_sort_scratch.begin(), m_sort_scratch.end());
+
+        for (std::size_t i = 0; i < m_sort_scratch.size(); ++i) {
+            if (i == 0 || m_sort_scratch[i].second != m_sort_scratch[i - 1].second) {
+                m_visible.push_back(m_sort_scratch[i].second);
+            }
+        }
+
+        return m_visible;
+    }
+
+    void render_index_on_sprite_construct(entt::registry& registry, const entt::entity entity) {
+        if (auto* index = registry.ctx().find<game_render_index>()) {
+            index->mark_loose(entity);
+        }
+    }
+}  // namespace engine
@@ -0,0 +1,104 @@
+/**
+ * @file render_index.hxx
+ * @brief Spatial index of sprite entities used to cull whole viewports at once.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+
+#include "spatial_hash.hxx"
+
+namespace engine {
+    /**
+     * @brief Indexes the positions of sprite entities once per tick for viewport queries.
+     *
+     * Each entity is indexed by the box spanning its previous and current position, which covers
+     * every interpolated position until the next tick. Sprite sizes live in the resources, so
+     * callers inflate queries by the largest sprite extent instead of indexing real bounds.
+     *
+     * Entities that get a sprite, or are moved through the `game_entities` helpers, between two
+     * rebuilds are kept on a loose list that every query returns as well.
+     *
+     * @note Transforms written directly through the registry are only seen after the next
+     * rebuild, use `mark_loose` for entities teleported outside of a tick.
+     */
+    class game_render_index {
+    public:
+        game_render_index() = default;
+        ~game_render_index() = default;
+
+        game_render_index(const game_render_index&) = default;
+        game_render_index& operator=(const game_render_index&) = default;
+        game_render_index(game_render_index&&) = default;
+        game_render_index& operator=(game_render_index&&) = default;
+
+        /**
+         * @brief Index every entity with a position, scale, sprite and renderable component.
+         */
+        void rebuild(entt::registry& registry);
+        void clear();
+
+        /**
+         * @brief Return an entity from every query until the next rebuild.
+         * @note Does nothing before the first rebuild, when the index is never queried. Marking
+         * an entity again is free, each is kept at most once.
+         */
+        void mark_loose(entt::entity entity);
+
+        /**
+         * @brief Collect sprite entities that may overlap a world space box.
+         * @param registry The registry the index was built from.
+         * @param min Top-left corner of the box, already inflated by the sprite extent.
+         * @param max Bottom-right corner of the box, already inflated by the sprite extent.
+         * @return Candidates in sprite storage order, valid until the next call.
+         */
+        [[nodiscard]] std::span<const entt::entity> visible_collect(entt::registry& registry,
+                                                                   const glm::vec2& min,
+                                                                   const glm::vec2& max);
+
+        /**
+         * @brief Whether the index was built at least once and can be queried.
+         */
+        [[nodiscard]] bool is_built() const noexcept;
+
+        /**
+         * @brief Get the largest absolute transform scale seen by the last rebuild.
+         */
+        [[nodiscard]] float get_scale_max() const noexcept;
+
+    private:
+        void loose_clear() noexcept;
+
+    private:
+        game_spatial_hash m_hash;
+        std::vector<entt::entity> m_loose;
+        std::vector<std::uint32_t> m_loose_slots;  ///< Loose position plus one per entity index.
+
+        std::vector<std::pair<std::size_t, entt::entity>> m_sort_scratch;
+        std::vector<entt::entity> m_visible;
+
+        float m_scale_max = 1.0f;
+        bool m_is_built = false;
+    };
+
+    /**
+     * @brief Registry signal handler that marks an entity loose in the context's render index.
+     */
+    void render_index_on_sprite_construct(entt::registry& registry, entt::entity entity);
+
+    inline bool game_render_index::is_built() const noexcept {
+        return m_is_built;
+    }
+
+    inline float game_render_index::get_scale_max() const noexcept {
+        return m_scale_max;
+    }
+}  // namespace engine
@@ -0,0 +1,178 @@
+/**
+ * @file scheduler.cxx
+ * @brief ECS system scheduler implementation.
+ */
+
+#include "scheduler.hxx"
+
+#include <algorithm>
+
+#include "../utils/jobs.hxx"
+#include "../utils/profiler.hxx"
+#include "../logger.hxx"
+
+namespace engine {
+    bool game_system_access::is_conflicting(const game_system_access& other) const noexcept {
+        if (m_is_exclusive == true || other.m_is_exclusive == true) {
+            return true;
+        }
+
+        return is_overlapping(m_writes, other.m_writes) ||
+               is_overlapping(m_writes, other.m_reads) || is_overlapping(m_reads, other.m_writes);
+    }
+
+    void game_system_access::storages_create(entt::registry& registry) const {
+        for (const storage_create_function create : m_storage_creators) {
+            create(registry);
+        }
+    }
+
+    bool game_system_access::is_overlapping(const std::vector<entt::id_type>& lhs,
+                                            const std::vector<entt::id_type>& rhs) noexcept {
+        // Access lists hold a handful of types, a linear scan beats keeping them sorted.
+        for (const entt::id_type id : lhs) {
+            if (std::find(rhs.begin(), rhs.end(), id) != rhs.end()) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void game_system_scheduler::add(std::string_view name, const system_function function,
+                                    const game_system_access& access, void* user_data,
+                                    const system_prepare_function prepare) {
+        if (function == nullptr) {
+            log_warning("Ignoring system '{}' without a function.", name);
+            return;
+        }
+
+        // Zones keep their name by pointer, which has to survive the system being removed.
+        const char* zone_name = nullptr;
+        if constexpr (should_profile) {
+            zone_name = game_profiler::get().name_intern(name);
+        }
+
+        m_systems.push_back(
+            {std::string(name), function, prepare, user_data, access, 0, zone_name});
+        m_is_dirty = true;
+        m_is_prepared = false;
+    }
+
+    void game_system_scheduler::remove(std::string_view name) {
+        const auto removed = std::erase_if(
+            m_systems, [name](const system_entry& system) { return system.name == name; });
+
+        if (removed == 0) {
+            log_warning("System '{}' is not scheduled and cannot be removed.", name);
+            return;
+        }
+
+        m_is_dirty = true;
+    }
+
+    void game_system_scheduler::clear() {
+        m_systems.clear();
+        m_stage_offsets.clear();
+        m_is_dirty = false;
+        m_is_prepared = true;
+    }
+
+    void game_system_scheduler::run(entt::registry& registry, game_jobs* jobs,
+                                    const float tick_interval) {
+        if (m_is_dirty == true) {
+            stages_build();
+        }
+
+        if (m_is_prepared == false) {
+            prepare(registry);
+        }
+
+        stage_context context = {this, &registry, jobs, tick_interval};
+        const job_function stage_job = [](void* context, std::size_t begin, std::size_t) {
+            const auto* stage = static_cast<stage_context*>(context);
+            stage->scheduler->system_run(begin, *stage->registry, stage->jobs,
+                                         stage->tick_interval);
+        };
+
+        for (std::size_t stage = 0; stage + 1 < m_stage_offsets.size(); ++stage) {
+            const std::size_t first = m_stage_offsets[stage];
+            const std::size_t last = m_stage_offsets[stage + 1];
+
+            if (jobs == nullptr || last - first == 1) {
+                for (std::size_t i = first; i < last; ++i) {
+                    system_run(i, registry, jobs, tick_interval);
+                }
+
+                continue;
+            }
+
+            // The first system runs here while the rest are picked up by the workers.
+            game_job_counter counter;
+            for (std::size_t i = first + 1; i < last; ++i) {
+                jobs->submit(stage_job, &context, i, i + 1, counter);
+            }
+
+            system_run(first, registry, jobs, tick_interval);
+            jobs->wait(counter);
+        }
+    }
+
+    std::size_t game_system_scheduler::get_stage_count() {
+        if (m_is_dirty == true) {
+            stages_build();
+        }
+
+        return m_stage_offsets.empty() == true ? 0 : m_stage_offsets.size() - 1;
+    }
+
+    void game_system_scheduler::stages_build() {
+        std::size_t stage_count = 0;
+
+        for (std::size_t i = 0; i < m_systems.size(); ++i) {
+            system_entry& system = m_systems[i];
+            system.stage = 0;
+
+            for (std::size_t j = 0; j < i; ++j) {
+                if (system.access.is_conflicting(m_systems[j].access) == true) {
+                    system.stage = std::max(system.stage, m_systems[j].stage + 1);
+                }
+            }
+
+            stage_count = std::max(stage_count, system.stage + 1);
+        }
+
+        // Conflicting systems never share a stage, so a stable sort keeps their relative order.
+        std::stable_sort(m_systems.begin(), m_systems.end(),
+                         [](const system_entry& lhs, const system_entry& rhs) {
+                             return lhs.stage < rhs.stage;
+                         });
+
+        m_stage_offsets.assign(stage_count + 1, m_systems.size());
+        for (std::size_t i = m_systems.size(); i-- > 0;) {
+            m_stage_offsets[m_systems[i].stage] = i;
+        }
+
+        m_stage_offsets[0] = 0;
+        m_is_dirty = false;
+    }
+
+    void game_system_scheduler::prepare(entt::registry& registry) {
+        for (const system_entry& system : m_systems) {
+            system.access.storages_create(registry);
+
+            if (system.prepare != nullptr) {
+                system.prepare(registry);
+            }
+        }
+
+        m_is_prepared = true;
+    }
+
+    void game_system_scheduler::system_run(const std::size_t index, entt::registry& registry,
+                                           game_jobs* jobs, const float tick_interval) {
+        const system_entry& system = m_systems[index];
+        const game_profile_zone zone(system.zone_name);
+        system.function(registry, jobs, tick_interval, system.user_data);
+    }
+}  // namespace engine
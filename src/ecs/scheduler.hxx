@@ -0,0 +1,209 @@
+/**
+ * @file scheduler.hxx
+ * @brief Runs ECS systems in parallel stages based on their declared component access.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+namespace engine {
+    class game_jobs;
+
+    /**
+     * @brief A system entry point run by `game_system_scheduler`.
+     * @param registry The registry the system works on.
+     * @param jobs Pool for splitting work further, nullptr when running single threaded.
+     * @param tick_interval Fixed tick interval in seconds.
+     * @param user_data The pointer given when the system was added.
+     */
+    using system_function = void (*)(entt::registry& registry, game_jobs* jobs,
+                                     float tick_interval, void* user_data);
+
+    /**
+     * @brief Called once on the scheduling thread before a system's first run.
+     * @note Use it to create the groups a system uses, creating them concurrently is not safe.
+     */
+    using system_prepare_function = void (*)(entt::registry& registry);
+
+    /**
+     * @brief The component types and registry context variables a system reads and writes.
+     *
+     * @code
+     * const auto access = engine::game_system_access{}
+     *                         .read<component_velocity_linear>()
+     *                         .write<component_position>()
+     *                         .context_read<game_spatial_hash>();
+     * @endcode
+     */
+    class game_system_access {
+    public:
+        template <class... Components>
+        game_system_access& read();
+
+        template <class... Components>
+        game_system_access& write();
+
+        /**
+         * @brief Declare reads of variables in the registry context, such as `game_spatial_hash`.
+         * @note Unlike components, context variables are never created by the scheduler.
+         */
+        template <class... Types>
+        game_system_access& context_read();
+
+        template <class... Types>
+        game_system_access& context_write();
+
+        /**
+         * @brief Run the system alone, for systems that create or destroy entities or components.
+         */
+        game_system_access& exclusive() noexcept;
+
+        /**
+         * @brief Check whether two systems may not run at the same time.
+         */
+        [[nodiscard]] bool is_conflicting(const game_system_access& other) const noexcept;
+
+        /**
+         * @brief Create every declared storage, so parallel systems never add one to the registry.
+         */
+        void storages_create(entt::registry& registry) const;
+
+    private:
+        using storage_create_function = void (*)(entt::registry& registry);
+
+        template <class Component>
+        void track(std::vector<entt::id_type>& ids);
+
+        [[nodiscard]] static bool is_overlapping(const std::vector<entt::id_type>& lhs,
+                                                 const std::vector<entt::id_type>& rhs) noexcept;
+
+    private:
+        std::vector<entt::id_type> m_reads;
+        std::vector<entt::id_type> m_writes;
+        std::vector<storage_create_function> m_storage_creators;
+        bool m_is_exclusive = false;
+    };
+
+    /**
+     * @brief Groups systems into stages and runs each stage's systems concurrently.
+     *
+     * Systems keep the order they were added in whenever their access conflicts, a system lands
+     * in the first stage after every earlier system it conflicts with. Systems sharing a stage are
+     * submitted to the job pool and the stage waits for all of them before the next one starts.
+     */
+    class game_system_scheduler {
+    public:
+        game_system_scheduler() = default;
+        ~game_system_scheduler() = default;
+
+        game_system_scheduler(const game_system_scheduler&) = default;
+        game_system_scheduler& operator=(const game_system_scheduler&) = default;
+        game_system_scheduler(game_system_scheduler&&) = default;
+        game_system_scheduler& operator=(game_system_scheduler&&) = default;
+
+        /**
+         * @brief Add a system after every system added so far.
+         * @param name Name used in log messages.
+         * @param function The system entry point.
+         * @param access Component types the system reads and writes.
+         * @param user_data Opaque pointer handed back to the system.
+         * @param prepare Optional callback run once before the system's first run.
+         */
+        void add(std::string_view name, system_function function, const game_system_access& access,
+                 void* user_data = nullptr, system_prepare_function prepare = nullptr);
+        void remove(std::string_view name);
+        void clear();
+
+        /**
+         * @brief Run every system once, stage by stage.
+         * @param registry The registry the systems work on.
+         * @param jobs Pool to run stages on, nullptr runs every system in order on this thread.
+         * @param tick_interval Fixed tick interval in seconds.
+         */
+        void run(entt::registry& registry, game_jobs* jobs, float tick_interval);
+
+        /**
+         * @brief Create every system's storages and run their prepare callbacks now.
+         * @note Runs by itself before the first `run`, call it again after replacing the registry.
+         */
+        void prepare(entt::registry& registry);
+
+        [[nodiscard]] std::size_t get_system_count() const noexcept;
+        [[nodiscard]] std::size_t get_stage_count();
+
+    private:
+        struct system_entry {
+            std::string name;
+            system_function function;
+            system_prepare_function prepare;
+            void* user_data;
+            game_system_access access;
+            std::size_t stage;
+            const char* zone_name;  ///< The name interned for profiler zones.
+        };
+
+        struct stage_context {
+            game_system_scheduler* scheduler;
+            entt::registry* registry;
+            game_jobs* jobs;
+            float tick_interval;
+        };
+
+        void stages_build();
+        void system_run(std::size_t index, entt::registry& registry, game_jobs* jobs,
+                        float tick_interval);
+
+    private:
+        std::vector<system_entry> m_systems;  ///< Sorted by stage, stable in insertion order.
+        std::vector<std::size_t> m_stage_offsets;  ///< Start index of each stage, plus the end.
+
+        bool m_is_dirty = false;    ///< Stages need rebuilding.
+        bool m_is_prepared = true;  ///< Prepare callbacks and storages ran for every system.
+    };
+
+    template <class... Components>
+    game_system_access& game_system_access::read() {
+        (track<Components>(m_reads), ...);
+        return *this;
+    }
+
+    template <class... Components>
+    game_system_access& game_system_access::write() {
+        (track<Components>(m_writes), ...);
+        return *this;
+    }
+
+    template <class... Types>
+    game_system_access& game_system_access::context_read() {
+        (m_reads.push_back(entt::type_hash<Types>::value()), ...);
+        return *this;
+    }
+
+    template <class... Types>
+    game_system_access& game_system_access::context_write() {
+        (m_writes.push_back(entt::type_hash<Types>::value()), ...);
+        return *this;
+    }
+
+    inline game_system_access& game_system_access::exclusive() noexcept {
+        m_is_exclusive = true;
+        return *this;
+    }
+
+    template <class Component>
+    void game_system_access::track(std::vector<entt::id_type>& ids) {
+        ids.push_back(entt::type_hash<Component>::value());
+        m_storage_creators.push_back(
+            [](entt::registry& registry) { static_cast<void>(registry.storage<Component>()); });
+    }
+
+    inline std::size_t game_system_scheduler::get_system_count() const noexcept {
+        return m_systems.size();
+    }
+}  // namespace engine
@@ -0,0 +1,453 @@
+/**
+ * @file snapshot.cxx
+ * @brief Snapshot archives, files and the delta encoded snapshot ring.
+ */
+
+#include "snapshot.hxx"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+#include "../logger.hxx"
+#include "../safety.hxx"
+
+namespace engine {
+    namespace {
+        /**
+         * @brief Equal bytes shorter than this stay in a delta's literal run, where they cost
+         *        less than the lengths of a new run.
+         */
+        constexpr std::size_t delta_skip_min = 4;
+
+        void varint_write(std::vector<std::byte>& out, std::uint64_t value) {
+            while (value >= 0x80) {
+                out.push_back(static_cast<std::byte>((value & 0x7F) | 0x80));
+                value >>= 7;
+            }
+
+            out.push_back(static_cast<std::byte>(value));
+        }
+
+        [[nodiscard]] std::uint64_t varint_read(std::span<const std::byte> in,
+                                                std::size_t& offset) {
+            std::uint64_t value = 0;
+
+            for (int shift = 0; shift < 64; shift += 7) {
+                paranoid_ensure(offset < in.size(), "Snapshot delta ends inside a length");
+
+                const auto byte = static_cast<std::uint64_t>(in[offset++]);
+                value |= (byte & 0x7F) << shift;
+
+                if ((byte & 0x80) == 0) {
+                    break;
+                }
+            }
+
+            return value;
+        }
+
+        /**
+         * @brief Encode `target` as runs of bytes equal to `base` and literal bytes.
+         *
+         * The delta starts with the target size, followed by (skip, literal) length pairs,
+         * each followed by its literal bytes. Bytes past the end of `base` are always literal.
+         */
+        void delta_encode(std::span<const std::byte> base, std::span<const std::byte> target,
+                          std::vector<std::byte>& out) {
+            out.clear();
+            varint_write(out, target.size());
+
+            const std::size_t size = target.size();
+            const std::size_t common = std::min(base.size(), size);
+
+            const auto equal_run = [&](const std::size_t from, const std::size_t limit) {
+                std::size_t length = 0;
+                while (from + length < common && length < limit &&
+                       target[from + length] == base[from + length]) {
+                    length++;
+                }
+
+                return length;
+            };
+
+            std::size_t position = 0;
+            while (position < size) {
+                const std::size_t skip = equal_run(position, size);
+                const std::size_t literal_first = position + skip;
+
+                // Extend the literal until an equal run long enough to be worth a skip.
+                std::size_t literal_end = literal_first;
+                while (literal_end < size) {
+                    const std::size_t run = equal_run(literal_end, delta_skip_min);
+                    if (run >= delta_skip_min) {
+                        break;
+                    }
+
+                    literal_end += std::max<std::size_t>(run, 1);
+                }
+
+                varint_write(out, skip);
+                varint_write(out, literal_end - literal_first);
+                out.insert(out.end(), target.begin() + literal_first,
+                           target.begin() + literal_end);
+
+                position = literal_end;
+            }
+        }
+
+        void delta_decode(std::span<const std::byte> base, std::span<const std::byte> delta,
+                          std::vector<std::byte>& out) {
+            std::size_t offset = 0;
+            const auto size = static_cast<std::size_t>(varint_read(delta, offset));
+            out.resize(size);
+
+            std::size_t position = 0;
+            while (position < size) {
+                const auto skip = static_cast<std::size_t>(varint_read(delta, offset));
+                const auto literal = static_cast<std::size_t>(varint_read(delta, offset));
+
+                paranoid_ensure(position + skip <= base.size() &&
+                                    position + skip + literal <= size &&
+                                    offset + literal <= delta.size(),
+                                "Snapshot delta does not match its base");
+
+                std::memcpy(out.data() + position, base.data() + position, skip);
+                position += skip;
+
+                std::memcpy(out.data() + position, delta.data() + offset, literal);
+                position += literal;
+                offset += literal;
+            }
+        }
+    }  // namespace
+
+    game_snapshot_writer::game_snapshot_writer(std::vector<std::byte>& data) : m_data(&data) {
+    }
+
+    void game_snapshot_writer::operator()(const component_renderable& renderable) {
+        (*this)(renderable.is_visible);
+        (*this)(renderable.layer);
+    }
+
+    void game_snapshot_writer::operator()(const component_animation& animation) {
+        (*this)(animation.clip);
+        (*this)(animation.frame);
+        (*this)(animation.frame_time);
+        (*this)(animation.speed);
+        (*this)(animation.is_playing);
+        (*this)(animation.uv);
+    }
+
+    void game_snapshot_writer::operator()(const component_sprite_key& key) {
+        string_write(key.resource_key);
+    }
+
+    void game_snapshot_writer::operator()(const component_text_key& key) {
+        string_write(key.resource_key);
+    }
+
+    void game_snapshot_writer::operator()(const component_text_dynamic& text) {
+        (*this)(text.color);
+    }
+
+    void game_snapshot_writer::operator()(const component_particle_emitter& emitter) {
+        (*this)(emitter.settings);
+        string_write(emitter.sprite_key);
+        (*this)(emitter.is_emitting);
+        (*this)(emitter.spawn_accumulator);
+        (*this)(emitter.burst_pending);
+        (*this)(emitter.random_state);
+
+        // Only live particles are written, the pool's capacity is restored empty past them.
+        const game_particle_pool& pool = emitter.pool;
+        const std::size_t count = pool.get_count();
+        (*this)(static_cast<std::uint64_t>(pool.get_capacity()));
+        (*this)(static_cast<std::uint64_t>(count));
+
+        for (const float* field : {pool.get_position_x(), pool.get_position_y(),
+                                   pool.get_previous_x(), pool.get_previous_y(),
+                                   pool.get_velocity_x(), pool.get_velocity_y(),
+                                   pool.get_remaining(), pool.get_lifetime()}) {
+            bytes_write(field, count * sizeof(float));
+        }
+    }
+
+    void game_snapshot_writer::bytes_write(const void* data, const std::size_t size) {
+        const auto* bytes = static_cast<const std::byte*>(data);
+        m_data->insert(m_data->end(), bytes, bytes + size);
+    }
+
+    void game_snapshot_writer::string_write(std::string_view value) {
+        (*this)(static_cast<std::uint32_t>(value.size()));
+        bytes_write(value.data(), value.size());
+    }
+
+    game_snapshot_reader::game_snapshot_reader(std::span<const std::byte> data)
+        : m_data(data), m_offset(0) {
+    }
+
+    void game_snapshot_reader::operator()(component_renderable& renderable) {
+        (*this)(renderable.is_visible);
+        (*this)(renderable.layer);
+    }
+
+    void game_snapshot_reader::operator()(component_animation& animation) {
+        (*this)(animation.clip);
+        (*this)(animation.frame);
+        (*this)(animation.frame_time);
+        (*this)(animation.speed);
+        (*this)(animation.is_playing);
+        (*this)(animation.uv);
+    }
+
+    void game_snapshot_reader::operator()(component_sprite_key& key) {
+        string_read(key.resource_key);
+    }
+
+    void game_snapshot_reader::operator()(component_text_key& key) {
+        string_read(key.resource_key);
+    }
+
+    void game_snapshot_reader::operator()(component_text_dynamic& text) {
+        text.handle = {};
+        (*this)(text.color);
+    }
+
+    void game_snapshot_reader::operator()(component_particle_emitter& emitter) {
+        (*this)(emitter.settings);
+        string_read(emitter.sprite_key);
+        emitter.sprite = {};
+        (*this)(emitter.is_emitting);
+        (*this)(emitter.spawn_accumulator);
+        (*this)(emitter.burst_pending);
+        (*this)(emitter.random_state);
+
+        std::uint64_t capacity = 0;
+        std::uint64_t count = 0;
+        (*this)(capacity);
+        (*this)(count);
+
+        if (count > capacity) {
+            throw error_message("Snapshot particle pool holds {} particles but fits {}", count,
+                                capacity);
+        }
+
+        game_particle_pool& pool = emitter.pool;
+        pool.set_capacity(static_cast<std::size_t>(capacity));
+
+        const game_particle_arrays arrays = pool.get_arrays();
+        for (float* field : {arrays.position_x, arrays.position_y, arrays.previous_x,
+                             arrays.previous_y, arrays.velocity_x, arrays.velocity_y,
+                             arrays.remaining, arrays.lifetime}) {
+            bytes_read(field, static_cast<std::size_t>(count) * sizeof(float));
+        }
+
+        pool.set_count(static_cast<std::size_t>(count));
+    }
+
+    void game_snapshot_reader::bytes_read(void* data, const std::size_t size) {
+        const std::size_t available = m_data.size() - m_offset;
+        if (size > available) {
+            throw error_message("Snapshot data ends {} bytes early", size - available);
+        }
+
+        std::memcpy(data, m_data.data() + m_offset, size);
+        m_offset += size;
+    }
+
+    void game_snapshot_reader::string_read(std::string& value) {
+        std::uint32_t size = 0;
+        (*this)(size);
+
+        value.resize(size);
+        bytes_read(value.data(), size);
+    }
+
+    void game_snapshot::set_data(std::span<const std::byte> data, const std::uint64_t tick) {
+        m_data.assign(data.begin(), data.end());
+        m_tick = tick;
+    }
+
+    bool game_snapshot::save(std::string_view file_path) const {
+        std::ofstream stream{std::string(file_path), std::ios::binary | std::ios::trunc};
+        if (stream.is_open() == false) {
+            log_error("Failed to open the snapshot file: {}", file_path);
+            return false;
+        }
+
+        const game_snapshot_header header = {snapshot_magic, snapshot_version, m_tick,
+                                             m_data.size()};
+        stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        stream.write(reinterpret_cast<const char*>(m_data.data()),
+                     static_cast<std::streamsize>(m_data.size()));
+
+        return stream.good();
+    }
+
+    bool game_snapshot::load(std::string_view file_path) {
+        std::ifstream stream{std::string(file_path), std::ios::binary};
+        if (stream.is_open() == false) {
+            log_error("Failed to open the snapshot file: {}", file_path);
+            return false;
+        }
+
+        game_snapshot_header header = {};
+        stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+        if (stream.good() == false || header.magic != snapshot_magic ||
+            header.version != snapshot_version) {
+            log_error("Not a snapshot of version {}: {}", snapshot_version, file_path);
+            return false;
+        }
+
+        std::vector<std::byte> data(static_cast<std::size_t>(header.size));
+        stream.read(reinterpret_cast<char*>(data.data()),
+                    static_cast<std::streamsize>(data.size()));
+
+        if (stream.gcount() != static_cast<std::streamsize>(data.size())) {
+            log_error("Snapshot file is truncated: {}", file_path);
+            return false;
+        }
+
+        m_data = std::move(data);
+        m_tick = header.tick;
+
+        return true;
+    }
+
+    void game_snapshot::engine_components_write(const entt::snapshot& snapshot,
+                                                game_snapshot_writer& archive) {
+        // Text components must come before the text keys, see `engine_components_read`.
+        snapshot.get<entt::entity>(archive)
+            .get<component_position>(archive)
+            .get<component_rotation>(archive)
+            .get<component_scale>(archive)
+            .get<component_interpolation>(archive)
+            .get<component_velocity_linear>(archive)
+            .get<component_velocity_angular>(archive)
+            .get<component_lifetime>(archive)
+            .get<component_collider>(archive)
+            .get<component_animation>(archive)
+            .get<component_renderable>(archive)
+            .get<component_text_dynamic>(archive)
+            .get<component_sprite_key>(archive)
+            .get<component_text_key>(archive)
+            .get<component_particle_emitter>(archive);
+    }
+
+    void game_snapshot::engine_components_read(entt::snapshot_loader& loader,
+                                               game_snapshot_reader& archive) {
+        // Restoring a key gives the entity an unresolved sprite or text, which keeps the
+        // color of the text restored just before.
+        loader.get<entt::entity>(archive)
+            .get<component_position>(archive)
+            .get<component_rotation>(archive)
+            .get<component_scale>(archive)
+            .get<component_interpolation>(archive)
+            .get<component_velocity_linear>(archive)
+            .get<component_velocity_angular>(archive)
+            .get<component_lifetime>(archive)
+            .get<component_collider>(archive)
+            .get<component_animation>(archive)
+            .get<component_renderable>(archive)
+            .get<component_text_dynamic>(archive)
+            .get<component_sprite_key>(archive)
+            .get<component_text_key>(archive)
+            .get<component_particle_emitter>(archive);
+    }
+
+    game_snapshot_ring::game_snapshot_ring(const std::size_t capacity,
+                                           const std::size_t keyframe_interval)
+        : m_entries(std::max<std::size_t>(capacity, 1)),
+          m_first(0),
+          m_count(0),
+          m_keyframe_interval(std::max<std::size_t>(keyframe_interval, 1)),
+          m_since_keyframe(0),
+          m_last() {
+    }
+
+    void game_snapshot_ring::push(const game_snapshot& snapshot) {
+        if (m_count == m_entries.size()) {
+            // The oldest snapshot is always a keyframe, the one after it becomes the new one.
+            if (m_count > 1 && entry_at(1).is_keyframe == false) {
+                ring_entry& next = entry_at(1);
+                std::vector<std::byte> whole;
+                delta_decode(entry_at(0).data, next.data, whole);
+
+                next.data = std::move(whole);
+                next.is_keyframe = true;
+            }
+
+            m_first = (m_first + 1) % m_entries.size();
+            m_count--;
+        }
+
+        const std::span<const std::byte> data = snapshot.get_data();
+        ring_entry& entry = entry_at(m_count);
+        entry.tick = snapshot.get_tick();
+        entry.is_keyframe = (m_count == 0 || m_since_keyframe + 1 >= m_keyframe_interval);
+
+        if (entry.is_keyframe == false) {
+            delta_encode(m_last, data, entry.data);
+
+            // A reordered storage can shift every byte, a whole snapshot is smaller then.
+            entry.is_keyframe = (entry.data.size() >= data.size());
+        }
+
+        if (entry.is_keyframe == true) {
+            entry.data.assign(data.begin(), data.end());
+            m_since_keyframe = 0;
+        } else {
+            m_since_keyframe++;
+        }
+
+        m_last.assign(data.begin(), data.end());
+        m_count++;
+    }
+
+    bool game_snapshot_ring::get(const std::size_t age, game_snapshot& out) const {
+        if (age >= m_count) {
+            return false;
+        }
+
+        const std::size_t index = m_count - 1 - age;
+        if (age == 0) {
+            out.set_data(m_last, entry_at(index).tick);
+            return true;
+        }
+
+        std::size_t keyframe = index;
+        while (entry_at(keyframe).is_keyframe == false) {
+            keyframe--;
+        }
+
+        std::vector<std::byte> current = entry_at(keyframe).data;
+        std::vector<std::byte> next;
+
+        for (std::size_t i = keyframe + 1; i <= index; ++i) {
+            delta_decode(current, entry_at(i).data, next);
+            current.swap(next);
+        }
+
+        out.set_data(current, entry_at(index).tick);
+        return true;
+    }
+
+    void game_snapshot_ring::clear() noexcept {
+        m_first = 0;
+        m_count = 0;
+        m_since_keyframe = 0;
+        m_last.clear();
+    }
+
+    std::size_t game_snapshot_ring::get_stored_size() const noexcept {
+        std::size_t size = 0;
+        for (std::size_t i = 0; i < m_count; ++i) {
+            size += entry_at(i).data.size();
+        }
+
+        return size;
+    }
+}  // namespace engine
@@ -0,0 +1,291 @@
+/**
+ * @file snapshot.hxx
+ * @brief Binary registry snapshots for saving, rewinding and replaying the simulation.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "components.hxx"
+
+namespace engine {
+    /**
+     * @brief Identifies snapshot files, the bytes "HSNP" read as a little endian integer.
+     */
+    constexpr std::uint32_t snapshot_magic = 0x504E5348;
+    constexpr std::uint32_t snapshot_version = 3;
+
+    /**
+     * @brief Fixed size header in front of a snapshot saved to a file.
+     */
+    struct game_snapshot_header {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint64_t tick;
+        std::uint64_t size;  ///< Bytes of snapshot data following the header.
+    };
+
+    static_assert(sizeof(game_snapshot_header) == 24, "The header layout is part of the format");
+
+    /**
+     * @brief EnTT output archive appending to a byte buffer.
+     *
+     * Plain data components are copied as their raw bytes, so a storage is written as a run of
+     * (entity, value) records in its packed order. Components holding strings or pools have
+     * overloads writing a length before their contents.
+     */
+    class game_snapshot_writer {
+    public:
+        explicit game_snapshot_writer(std::vector<std::byte>& data);
+
+        template <class T>
+            requires std::is_trivially_copyable_v<T>
+        void operator()(const T& value);
+
+        /**
+         * @note Written field by field, so padding never makes equal states differ in bytes.
+         */
+        void operator()(const component_renderable& renderable);
+        void operator()(const component_animation& animation);
+        void operator()(const component_sprite_key& key);
+        void operator()(const component_text_key& key);
+
+        /**
+         * @note Only the color is written, handles are resolved again from the text's key.
+         */
+        void operator()(const component_text_dynamic& text);
+        void operator()(const component_particle_emitter& emitter);
+
+        void bytes_write(const void* data, std::size_t size);
+
+    private:
+        void string_write(std::string_view value);
+
+    private:
+        std::vector<std::byte>* m_data;
+    };
+
+    /**
+     * @brief EnTT input archive reading what `game_snapshot_writer` wrote.
+     * @note Throws an `error_message` when reading past the end of the data.
+     */
+    class game_snapshot_reader {
+    public:
+        explicit game_snapshot_reader(std::span<const std::byte> data);
+
+        template <class T>
+            requires std::is_trivially_copyable_v<T>
+        void operator()(T& value);
+
+        void operator()(component_renderable& renderable);
+        void operator()(component_animation& animation);
+        void operator()(component_sprite_key& key);
+        void operator()(component_text_key& key);
+        void operator()(component_text_dynamic& text);
+        void operator()(component_particle_emitter& emitter);
+
+        void bytes_read(void* data, std::size_t size);
+
+        [[nodiscard]] bool is_at_end() const noexcept;
+
+    private:
+        void string_read(std::string& value);
+
+    private:
+        std::span<const std::byte> m_data;
+        std::size_t m_offset;
+    };
+
+    /**
+     * @brief The entities and engine components of a registry at one tick, as bytes.
+     *
+     * Entities are written with their versions and the registry's free list, so a restored
+     * registry hands out the same identifiers in the same order and replays deterministically.
+     * Sprite and text handles are not stored, they resolve again from the entities' resource
+     * keys on first draw. Animation clip handles are stored as they are, so clips must be
+     * created in the same order before restoring into another `game_entities`.
+     *
+     * Game specific components are appended by naming them, in the same order for `write`
+     * and `read`. They must be trivially copyable or have archive overloads of their own.
+     *
+     * @code
+     * engine::game_snapshot snapshot;
+     * entities->snapshot_write(snapshot, engine->get_tick_stats().ticks);
+     * snapshot.save("quicksave.hsnp");
+     * @endcode
+     */
+    class game_snapshot {
+    public:
+        game_snapshot() = default;
+
+        /**
+         * @brief Replace the snapshot with the registry's current state.
+         */
+        template <class... Components>
+        void write(const entt::registry& registry, std::uint64_t tick);
+
+        /**
+         * @brief Restore the snapshot into a registry.
+         * @param registry Registry to restore into, must be newly constructed. `clear` keeps
+         * released identifiers and their versions, which the restored ones would not match.
+         */
+        template <class... Components>
+        void read(entt::registry& registry) const;
+
+        /**
+         * @brief Replace the snapshot data, such as with bytes rebuilt by a snapshot ring.
+         */
+        void set_data(std::span<const std::byte> data, std::uint64_t tick);
+
+        bool save(std::string_view file_path) const;
+
+        /**
+         * @return Whether the file exists and holds a snapshot of this version.
+         */
+        bool load(std::string_view file_path);
+
+        [[nodiscard]] std::span<const std::byte> get_data() const noexcept;
+        [[nodiscard]] std::uint64_t get_tick() const noexcept;
+
+    private:
+        static void engine_components_write(const entt::snapshot& snapshot,
+                                            game_snapshot_writer& archive);
+        static void engine_components_read(entt::snapshot_loader& loader,
+                                           game_snapshot_reader& archive);
+
+    private:
+        std::vector<std::byte> m_data;
+        std::uint64_t m_tick = 0;
+    };
+
+    /**
+     * @brief A ring of the most recent snapshots, stored as deltas between keyframes.
+     *
+     * Every `keyframe_interval`th snapshot is kept whole, the others only keep the byte ranges
+     * that differ from the snapshot before them. Storages are written in packed order, which
+     * rarely changes between ticks, so most deltas are a small fraction of a full snapshot.
+     * Getting a snapshot replays the deltas since its keyframe. Buffers are reused once the
+     * ring is full.
+     */
+    class game_snapshot_ring {
+    public:
+        static constexpr std::size_t keyframe_interval_default = 30;
+
+    public:
+        explicit game_snapshot_ring(std::size_t capacity,
+                                    std::size_t keyframe_interval = keyframe_interval_default);
+
+        /**
+         * @brief Add a snapshot as the newest, dropping the oldest one when the ring is full.
+         */
+        void push(const game_snapshot& snapshot);
+
+        /**
+         * @brief Rebuild a snapshot.
+         * @param age Zero for the newest snapshot, one for the one before it and so on.
+         * @return False if the ring holds fewer than `age + 1` snapshots.
+         */
+        bool get(std::size_t age, game_snapshot& out) const;
+
+        void clear() noexcept;
+
+        [[nodiscard]] std::size_t get_count() const noexcept;
+        [[nodiscard]] std::size_t get_capacity() const noexcept;
+
+        /**
+         * @brief Get the bytes currently stored for all snapshots, keyframes and deltas.
+         */
+        [[nodiscard]] std::size_t get_stored_size() const noexcept;
+
+    private:
+        struct ring_entry {
+            std::vector<std::byte> data;  ///< Whole snapshot or delta to the entry before.
+            std::uint64_t tick;
+            bool is_keyframe;
+        };
+
+        [[nodiscard]] const ring_entry& entry_at(std::size_t index) const noexcept;
+        [[nodiscard]] ring_entry& entry_at(std::size_t index) noexcept;
+
+    private:
+        std::vector<ring_entry> m_entries;
+        std::size_t m_first;  ///< Slot of the oldest snapshot.
+        std::size_t m_count;
+        std::size_t m_keyframe_interval;
+        std::size_t m_since_keyframe;  ///< Snapshots pushed since the last keyframe.
+
+        std::vector<std::byte> m_last;  ///< Whole newest snapshot, the base of the next delta.
+    };
+
+    template <class T>
+        requires std::is_trivially_copyable_v<T>
+    void game_snapshot_writer::operator()(const T& value) {
+        bytes_write(&value, sizeof(T));
+    }
+
+    template <class T>
+        requires std::is_trivially_copyable_v<T>
+    void game_snapshot_reader::operator()(T& value) {
+        bytes_read(&value, sizeof(T));
+    }
+
+    inline bool game_snapshot_reader::is_at_end() const noexcept {
+        return m_offset == m_data.size();
+    }
+
+    template <class... Components>
+    void game_snapshot::write(const entt::registry& registry, const std::uint64_t tick) {
+        m_data.clear();
+        m_tick = tick;
+
+        game_snapshot_writer archive(m_data);
+        const entt::snapshot snapshot{registry};
+
+        engine_components_write(snapshot, archive);
+        (snapshot.template get<Components>(archive), ...);
+    }
+
+    template <class... Components>
+    void game_snapshot::read(entt::registry& registry) const {
+        game_snapshot_reader archive(m_data);
+        entt::snapshot_loader loader{registry};
+
+        engine_components_read(loader, archive);
+        (loader.template get<Components>(archive), ...);
+    }
+
+    inline std::span<const std::byte> game_snapshot::get_data() const noexcept {
+        return m_data;
+    }
+
+    inline std::uint64_t game_snapshot::get_tick() const noexcept {
+        return m_tick;
+    }
+
+    inline std::size_t game_snapshot_ring::get_count() const noexcept {
+        return m_count;
+    }
+
+    inline std::size_t game_snapshot_ring::get_capacity() const noexcept {
+        return m_entries.size();
+    }
+
+    inline const game_snapshot_ring::ring_entry& game_snapshot_ring::entry_at(
+        const std::size_t index) const noexcept {
+        return m_entries[(m_first + index) % m_entries.size()];
+    }
+
+    inline game_snapshot_ring::ring_entry& game_snapshot_ring::entry_at(
+        const std::size_t index) noexcept {
+        return m_entries[(m_first + index) % m_entries.size()];
+    }
+}  // namespace engine
@@ -0,0 +1,191 @@
+/**
+ * @file spatial_hash.cxx
+ * @brief Uniform grid broadphase implementation.
+ */
+
+#include "spatial_hash.hxx"
+
+#include <algorithm>
+#include <bit>
+
+#include "../safety.hxx"
+
+namespace engine {
+    game_spatial_hash::game_spatial_hash(const float cell_size)
+        : m_cell_size(1.0f),
+          m_cell_size_inverse(1.0f),
+          m_entries(),
+          m_bucket_offsets(),
+          m_bucket_items(),
+          m_bucket_mask(0) {
+        set_cell_size(cell_size);
+    }
+
+    void game_spatial_hash::rebuild(entt::registry& registry) {
+        m_entries.clear();
+
+        auto view = registry.view<component_position, component_scale, component_collider>();
+        for (auto [entity, position, scale_comp, collider] : view.each()) {
+            const glm::vec2 scale = glm::abs(scale_comp.value);
+            const glm::vec2 center = position.value + collider.offset * scale_comp.value;
+
+            if (collider.shape == collider_shape::circle) {
+                insert_circle(entity, center, collider.radius * std::max(scale.x, scale.y));
+            } else {
+                const glm::vec2 half_size = collider.half_size * scale;
+                insert_aabb(entity, center - half_size, center + half_size);
+            }
+        }
+
+        build();
+    }
+
+    void game_spatial_hash::insert_aabb(const entt::entity entity, const glm::vec2& min,
+                                        const glm::vec2& max) {
+        entry item = {};
+        item.entity = entity;
+        item.shape = collider_shape::aabb;
+        item.center = (min + max) * 0.5f;
+        item.half_size = (max - min) * 0.5f;
+        item.radius = glm::length(item.half_size);
+        item.cell_min = cell_of(min);
+        item.cell_max = cell_of(max);
+
+        m_entries.push_back(item);
+    }
+
+    void game_spatial_hash::insert_circle(const entt::entity entity, const glm::vec2& center,
+                                          const float radius) {
+        entry item = {};
+        item.entity = entity;
+        item.shape = collider_shape::circle;
+        item.center = center;
+        item.half_size = {radius, radius};
+        item.radius = radius;
+        item.cell_min = cell_of(center - item.half_size);
+        item.cell_max = cell_of(center + item.half_size);
+
+        m_entries.push_back(item);
+    }
+
+    void game_spatial_hash::build() {
+        std::size_t cell_reference_count = 0;
+        for (const entry& item : m_entries) {
+            const glm::ivec2 cell_span = item.cell_max - item.cell_min + 1;
+            cell_reference_count +=
+                static_cast<std::size_t>(cell_span.x) * static_cast<std::size_t>(cell_span.y);
+        }
+
+        // Keep the table at most half full so unrelated cells rarely share a bucket.
+        const std::size_t bucket_count =
+            std::bit_ceil(std::max<std::size_t>(64, cell_reference_count * 2));
+        m_bucket_mask = bucket_count - 1;
+        m_bucket_offsets.assign(bucket_count + 1, 0);
+
+        // Counting sort pass one: count references per bucket, shifted by one for the prefix sum.
+        for (const entry& item : m_entries) {
+            for (int cell_y = item.cell_min.y; cell_y <= item.cell_max.y; ++cell_y) {
+                for (int cell_x = item.cell_min.x; cell_x <= item.cell_max.x; ++cell_x) {
+                    m_bucket_offsets[bucket_of(cell_x, cell_y) + 1]++;
+                }
+            }
+        }
+
+        for (std::size_t bucket = 0; bucket < bucket_count; ++bucket) {
+            m_bucket_offsets[bucket + 1] += m_bucket_offsets[bucket];
+        }
+
+        // Pass two: scatter entry indices, using each bucket's start as its write cursor.
+        m_bucket_items.resize(cell_reference_count);
+        for (std::uint32_t index = 0; index < m_entries.size(); ++index) {
+            const entry& item = m_entries[index];
+
+            for (int cell_y = item.cell_min.y; cell_y <= item.cell_max.y; ++cell_y) {
+                for (int cell_x = item.cell_min.x; cell_x <= item.cell_max.x; ++cell_x) {
+                    m_bucket_items[m_bucket_offsets[bucket_of(cell_x, cell_y)]++] = index;
+                }
+            }
+        }
+
+        // The cursors ended on the next bucket's start, shift them back into place.
+        for (std::size_t bucket = bucket_count; bucket > 0; --bucket) {
+            m_bucket_offsets[bucket] = m_bucket_offsets[bucket - 1];
+        }
+
+        m_bucket_offsets[0] = 0;
+    }
+
+    void game_spatial_hash::clear() {
+        m_entries.clear();
+        m_bucket_offsets.clear();
+        m_bucket_items.clear();
+        m_bucket_mask = 0;
+    }
+
+    std::size_t game_spatial_hash::query_aabb(const glm::vec2& min, const glm::vec2& max,
+                                              std::span<entt::entity> out) const {
+        std::size_t count = 0;
+        query_aabb(min, max, [&](const entt::entity entity) {
+            if (count < out.size()) {
+                out[count++] = entity;
+            }
+        });
+
+        return count;
+    }
+
+    std::size_t game_spatial_hash::query_radius(const glm::vec2& center, const float radius,
+                                                std::span<entt::entity> out) const {
+        std::size_t count = 0;
+        query_radius(center, radius, [&](const entt::entity entity) {
+            if (count < out.size()) {
+                out[count++] = entity;
+            }
+        });
+
+        return count;
+    }
+
+    void game_spatial_hash::set_cell_size(const float cell_size) {
+        paranoid_ensure(cell_size > 0.0f, "Spatial hash cell size must be positive");
+
+        m_cell_size = std::max(cell_size, 1.0f);
+        m_cell_size_inverse = 1.0f / m_cell_size;
+    }
+
+    bool game_spatial_hash::is_overlapping_aabb(const entry& item, const glm::vec2& min,
+                                                const glm::vec2& max) noexcept {
+        if (item.shape == collider_shape::circle) {
+            const glm::vec2 closest = glm::clamp(item.center, min, max);
+            const glm::vec2 delta = item.center - closest;
+            return glm::dot(delta, delta) <= item.radius * item.radius;
+        }
+
+        const glm::vec2 item_min = item.center - item.half_size;
+        const glm::vec2 item_max = item.center + item.half_size;
+        return item_min.x <= max.x && item_max.x >= min.x && item_min.y <= max.y &&
+               item_max.y >= min.y;
+    }
+
+    bool game_spatial_hash::is_overlapping_circle(const entry& item, const glm::vec2& center,
+                                                  const float radius) noexcept {
+        if (item.shape == collider_shape::circle) {
+            const glm::vec2 delta = item.center - center;
+            const float reach = item.radius + radius;
+            return glm::dot(delta, delta) <= reach * reach;
+        }
+
+        const glm::vec2 closest =
+            glm::clamp(center, item.center - item.half_size, item.center + item.half_size);
+        const glm::vec2 delta = center - closest;
+        return glm::dot(delta, delta) <= radius * radius;
+    }
+
+    bool game_spatial_hash::is_overlapping(const entry& lhs, const entry& rhs) noexcept {
+        if (rhs.shape == collider_shape::circle) {
+            return is_overlapping_circle(lhs, rhs.center, rhs.radius);
+        }
+
+        return is_overlapping_aabb(lhs, rhs.center - rhs.half_size, rhs.center + rhs.half_size);
+    }
+}  // namespace engine
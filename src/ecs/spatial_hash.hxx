@@ -0,0 +1,297 @@
+/**
+ * @file spatial_hash.hxx
+ * @brief Uniform grid broadphase for entities with a `component_collider`.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+
+#include "components.hxx"
+
+namespace engine {
+    /**
+     * @brief A spatial hash of collider bounds, rebuilt from the registry once per tick.
+     *
+     * Colliders are bucketed into square cells hashed into a power of two table. Buckets are
+     * stored back to back in a single array filled with a counting sort, so rebuilding only
+     * allocates when the collider count grows and queries never allocate. The same entity can
+     * show up in several cells, queries only report it from the first cell it shares with the
+     * queried box, which needs no per-query state.
+     *
+     * @note Queries only read the hash and may run concurrently with each other, but not with
+     * `rebuild` or `build`.
+     */
+    class game_spatial_hash {
+    public:
+        /**
+         * @param cell_size Width of a grid cell in world units, a couple of times the size of a
+         * typical collider works best.
+         */
+        explicit game_spatial_hash(float cell_size = 128.0f);
+        ~game_spatial_hash() = default;
+
+        game_spatial_hash(const game_spatial_hash&) = default;
+        game_spatial_hash& operator=(const game_spatial_hash&) = default;
+        game_spatial_hash(game_spatial_hash&&) = default;
+        game_spatial_hash& operator=(game_spatial_hash&&) = default;
+
+        /**
+         * @brief Replace the contents with every entity with a position, a scale and a collider.
+         */
+        void rebuild(entt::registry& registry);
+        void clear();
+
+        /**
+         * @brief Stage a box for the next `build`, for indexing bounds that are not colliders.
+         * @note Call `clear` first to start over, queries are only valid again after `build`.
+         */
+        void insert_aabb(entt::entity entity, const glm::vec2& min, const glm::vec2& max);
+
+        /**
+         * @brief Stage a circle for the next `build`.
+         */
+        void insert_circle(entt::entity entity, const glm::vec2& center, float radius);
+
+        /**
+         * @brief Bucket every staged entry so it can be queried.
+         */
+        void build();
+
+        /**
+         * @brief Invoke `callback(entity)` for every collider overlapping an axis aligned box.
+         */
+        template <class F>
+            requires std::is_invocable_v<F&, entt::entity>
+        void query_aabb(const glm::vec2& min, const glm::vec2& max, F&& callback) const;
+
+        /**
+         * @brief Write colliders overlapping an axis aligned box into `out`.
+         * @return Number of entities written, stops once `out` is full.
+         */
+        std::size_t query_aabb(const glm::vec2& min, const glm::vec2& max,
+                               std::span<entt::entity> out) const;
+
+        /**
+         * @brief Invoke `callback(entity)` for every collider overlapping a circle.
+         */
+        template <class F>
+            requires std::is_invocable_v<F&, entt::entity>
+        void query_radius(const glm::vec2& center, float radius, F&& callback) const;
+
+        /**
+         * @brief Write colliders overlapping a circle into `out`.
+         * @return Number of entities written, stops once `out` is full.
+         */
+        std::size_t query_radius(const glm::vec2& center, float radius,
+                                 std::span<entt::entity> out) const;
+
+        /**
+         * @brief Invoke `callback(first, second)` once for every pair of overlapping colliders.
+         */
+        template <class F>
+            requires std::is_invocable_v<F&, entt::entity, entt::entity>
+        void pairs_for_each(F&& callback) const;
+
+        [[nodiscard]] float get_cell_size() const noexcept;
+
+        /**
+         * @brief Change the cell size, takes effect on the next rebuild.
+         */
+        void set_cell_size(float cell_size);
+
+        [[nodiscard]] std::size_t get_size() const noexcept;
+        [[nodiscard]] bool is_empty() const noexcept;
+
+    private:
+        struct entry {
+            entt::entity entity;
+            collider_shape shape;
+            glm::vec2 center;
+            glm::vec2 half_size;  ///< Bounding box half size, for circles both equal the radius.
+            float radius;
+            glm::ivec2 cell_min;
+            glm::ivec2 cell_max;
+        };
+
+        [[nodiscard]] glm::ivec2 cell_of(const glm::vec2& position) const noexcept;
+        [[nodiscard]] std::size_t bucket_of(int cell_x, int cell_y) const noexcept;
+
+        /**
+         * @brief Check whether a bucket item is the one to report an entry from a cell.
+         * @param item Index into the bucket items.
+         * @param bucket_first Index of the first item of the bucket holding `item`.
+         * @param cell_first First cell of the box visiting the entry, the entry is only reported
+         * from the first cell both cover.
+         * @note Copies of an entry whose cells hash to the same bucket sit next to each other,
+         * only the first of them is reported.
+         */
+        [[nodiscard]] bool is_reported_from(std::uint32_t item, std::uint32_t bucket_first,
+                                            const glm::ivec2& cell,
+                                            const glm::ivec2& cell_first) const noexcept;
+
+        /**
+         * @brief Visit every entry in the cells covering a box, each at most once.
+         */
+        template <class F>
+        void entries_visit(const glm::vec2& min, const glm::vec2& max, F&& visitor) const;
+
+        [[nodiscard]] static bool is_overlapping_aabb(const entry& item, const glm::vec2& min,
+                                                      const glm::vec2& max) noexcept;
+        [[nodiscard]] static bool is_overlapping_circle(const entry& item,
+                                                        const glm::vec2& center,
+                                                        float radius) noexcept;
+        [[nodiscard]] static bool is_overlapping(const entry& lhs, const entry& rhs) noexcept;
+
+    private:
+        float m_cell_size;
+        float m_cell_size_inverse;
+
+        std::vector<entry> m_entries;
+        std::vector<std::uint32_t> m_bucket_offsets;  ///< Bucket count plus one prefix sums.
+        std::vector<std::uint32_t> m_bucket_items;    ///< Entry indices grouped by bucket.
+        std::size_t m_bucket_mask;
+    };
+
+    template <class F>
+    void game_spatial_hash::entries_visit(const glm::vec2& min, const glm::vec2& max,
+                                          F&& visitor) const {
+        if (m_entries.empty() == true) {
+            return;
+        }
+
+        const glm::ivec2 cell_min = cell_of(min);
+        const glm::ivec2 cell_max = cell_of(max);
+
+        // Boxes covering more cells than there are buckets would visit buckets repeatedly.
+        const auto cell_count = static_cast<std::uint64_t>(cell_max.x - cell_min.x + 1) *
+                                static_cast<std::uint64_t>(cell_max.y - cell_min.y + 1);
+        if (cell_count > m_bucket_mask) {
+            for (const entry& item : m_entries) {
+                visitor(item);
+            }
+
+            return;
+        }
+
+        for (int cell_y = cell_min.y; cell_y <= cell_max.y; ++cell_y) {
+            for (int cell_x = cell_min.x; cell_x <= cell_max.x; ++cell_x) {
+                const std::size_t bucket = bucket_of(cell_x, cell_y);
+
+                const std::uint32_t first = m_bucket_offsets[bucket];
+
+                for (std::uint32_t i = first; i < m_bucket_offsets[bucket + 1]; ++i) {
+                    if (is_reported_from(i, first, {cell_x, cell_y}, cell_min) == true) {
+                        visitor(m_entries[m_bucket_items[i]]);
+                    }
+                }
+            }
+        }
+    }
+
+    template <class F>
+        requires std::is_invocable_v<F&, entt::entity>
+    void game_spatial_hash::query_aabb(const glm::vec2& min, const glm::vec2& max,
+                                       F&& callback) const {
+        entries_visit(min, max, [&](const entry& item) {
+            if (is_overlapping_aabb(item, min, max) == true) {
+                callback(item.entity);
+            }
+        });
+    }
+
+    template <class F>
+        requires std::is_invocable_v<F&, entt::entity>
+    void game_spatial_hash::query_radius(const glm::vec2& center, const float radius,
+                                         F&& callback) const {
+        const glm::vec2 extent = {radius, radius};
+        entries_visit(center - extent, center + extent, [&](const entry& item) {
+            if (is_overlapping_circle(item, center, radius) == true) {
+                callback(item.entity);
+            }
+        });
+    }
+
+    template <class F>
+        requires std::is_invocable_v<F&, entt::entity, entt::entity>
+    void game_spatial_hash::pairs_for_each(F&& callback) const {
+        if (m_bucket_offsets.empty() == true) {
+            return;
+        }
+
+        for (std::uint32_t index = 0; index < m_entries.size(); ++index) {
+            const entry& item = m_entries[index];
+
+            for (int cell_y = item.cell_min.y; cell_y <= item.cell_max.y; ++cell_y) {
+                for (int cell_x = item.cell_min.x; cell_x <= item.cell_max.x; ++cell_x) {
+                    const std::size_t bucket = bucket_of(cell_x, cell_y);
+                    const std::uint32_t first = m_bucket_offsets[bucket];
+
+                    for (std::uint32_t i = first; i < m_bucket_offsets[bucket + 1]; ++i) {
+                        // Only pair with later entries so every pair is reported once.
+                        const std::uint32_t other = m_bucket_items[i];
+                        if (other <= index ||
+                            is_reported_from(i, first, {cell_x, cell_y}, item.cell_min) == false) {
+                            continue;
+                        }
+
+                        if (is_overlapping(item, m_entries[other]) == true) {
+                            callback(item.entity, m_entries[other].entity);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    inline float game_spatial_hash::get_cell_size() const noexcept {
+        return m_cell_size;
+    }
+
+    inline std::size_t game_spatial_hash::get_size() const noexcept {
+        return m_entries.size();
+    }
+
+    inline bool game_spatial_hash::is_empty() const noexcept {
+        return m_entries.empty();
+    }
+
+    inline glm::ivec2 game_spatial_hash::cell_of(const glm::vec2& position) const noexcept {
+        return glm::ivec2(glm::floor(position * m_cell_size_inverse));
+    }
+
+    inline bool game_spatial_hash::is_reported_from(const std::uint32_t item,
+                                                    const std::uint32_t bucket_first,
+                                                    const glm::ivec2& cell,
+                                                    const glm::ivec2& cell_first) const noexcept {
+        const std::uint32_t index = m_bucket_items[item];
+        if (item > bucket_first && m_bucket_items[item - 1] == index) {
+            return false;
+        }
+
+        // Entries of other cells hashed into the same bucket are reported from their own cells.
+        const entry& candidate = m_entries[index];
+        if (cell.x < candidate.cell_min.x || cell.x > candidate.cell_max.x ||
+            cell.y < candidate.cell_min.y || cell.y > candidate.cell_max.y) {
+            return false;
+        }
+
+        return cell.x == std::max(candidate.cell_min.x, cell_first.x) &&
+               cell.y == std::max(candidate.cell_min.y, cell_first.y);
+    }
+
+    inline std::size_t game_spatial_hash::bucket_of(const int cell_x,
+                                                    const int cell_y) const noexcept {
+        const std::uint32_t hash = (static_cast<std::uint32_t>(cell_x) * 73856093u) ^
+                                   (static_cast<std::uint32_t>(cell_y) * 19349663u);
+        return hash & m_bucket_mask;
+    }
+}  // namespace engine
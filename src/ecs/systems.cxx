@@ -3,160 +3,588 @@
 #include <glm/glm.hpp>
 #include "../engine.hxx"
 #include "../utils/resources.hxx"
+#include "../utils/jobs.hxx"
+#include "../renderer/render_packet.hxx"
+#include "physics_kernels.hxx"
+#include "render_index.hxx"
+#include "commands.hxx"
 
 #include <algorithm>
+#include <cstdint>
+#include <span>
 #include <vector>
 #include <cmath>
 
 namespace engine {
-    void system_physics::update(entt::registry& registry, const float tick_interval) {
-        integrate_velocity(registry, tick_interval);
-    }
-
-    void system_physics::integrate_velocity(entt::registry& registry, float tick_interval) {
-        auto view = registry.view<component_transform>();
-
-        for (auto [entity, transform] : view.each()) {
-            // If interpolation component exists, store previous position and rotation for later.
-            if (auto* interpolation = registry.try_get<component_interpolation>(entity)) {
-                interpolation->previous_position = transform.position;
-                interpolation->previous_rotation = transform.rotation;
+    namespace {
+        /**
+         * @brief Interpolate between two angles in degrees along the shorter way around.
+         */
+        [[nodiscard]] float rotation_lerp(const float previous, const float current,
+                                          const float fraction) noexcept {
+            float rotation_diff = current - previous;
+            if (rotation_diff > 180.0f) {
+                rotation_diff -= 360.0f;
+            } else if (rotation_diff < -180.0f) {
+                rotation_diff += 360.0f;
             }
 
-            if (auto* velocity_linear = registry.try_get<component_velocity_linear>(entity)) {
-                glm::vec2 velocity = velocity_linear->value;
+            return previous + (rotation_diff * fraction);
+        }
 
-                if (velocity_linear->drag > 0.0f) {
-                    const float drag_factor = 1.0f - (velocity_linear->drag * tick_interval);
-                    velocity *= std::max(0.0f, drag_factor);
-                    velocity_linear->value = velocity;
+        /**
+         * @brief Run `function(begin, end)` over `[0, count)` in page sized chunks.
+         * @note Runs inline when there is no job pool to split the work across.
+         */
+        template <class F>
+        void for_each_page_chunk(game_jobs* jobs, const std::size_t count,
+                                 const std::size_t page_size, F&& function) {
+            if (jobs == nullptr) {
+                for (std::size_t first = 0; first < count; first += page_size) {
+                    function(first, std::min(first + page_size, count));
                 }
 
-                if (velocity_linear->max_speed > 0.0f) {
-                    const float speed = glm::length(velocity);
-                    if (speed > velocity_linear->max_speed) {
-                        velocity = (velocity / speed) * velocity_linear->max_speed;
-                        velocity_linear->value = velocity;
-                    }
-                }
+                return;
+            }
+
+            jobs->parallel_for(count, page_size, function);
+        }
+
+        /**
+         * @brief Step an emitter's xorshift state and map it to [0, 1).
+         */
+        [[nodiscard]] float particle_random(std::uint32_t& state) noexcept {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return static_cast<float>(state >> 8) * (1.0f / 16777216.0f);
+        }
 
-                transform.position += velocity * tick_interval;
+        /**
+         * @brief Spawn the particles from the emitter's rate and pending burst for one tick.
+         * @param origin Position of the emitter entity.
+         * @param rotation Rotation of the emitter entity in degrees.
+         */
+        void particles_spawn(component_particle_emitter& emitter, const glm::vec2& origin,
+                             const float rotation, const float tick_interval) {
+            const game_particle_settings& settings = emitter.settings;
+
+            std::uint32_t count = emitter.burst_pending;
+            emitter.burst_pending = 0;
+
+            if (emitter.is_emitting == true && settings.rate > 0.0f) {
+                emitter.spawn_accumulator += settings.rate * tick_interval;
+                const float whole = std::floor(emitter.spawn_accumulator);
+                emitter.spawn_accumulator -= whole;
+                count += static_cast<std::uint32_t>(whole);
             }
 
-            if (auto* angular_velocity = registry.try_get<component_velocity_angular>(entity)) {
-                float velocity = angular_velocity->value;
+            if (count == 0) {
+                return;
+            }
 
-                if (angular_velocity->drag > 0.0f) {
-                    const float drag_factor = 1.0f - (angular_velocity->drag * tick_interval);
-                    velocity *= std::max(0.0f, drag_factor);
-                    angular_velocity->value = velocity;
+            const float radians = glm::radians(rotation);
+            const float cos_r = std::cos(radians);
+            const float sin_r = std::sin(radians);
+            const glm::vec2 center = {
+                origin.x + settings.offset.x * cos_r - settings.offset.y * sin_r,
+                origin.y + settings.offset.x * sin_r + settings.offset.y * cos_r};
+
+            std::uint32_t& random = emitter.random_state;
+            for (std::uint32_t i = 0; i < count; ++i) {
+                glm::vec2 position = center;
+                if (settings.spawn_radius > 0.0f) {
+                    // The square root spreads spawn points evenly over the disc.
+                    const float distance =
+                        settings.spawn_radius * std::sqrt(particle_random(random));
+                    const float angle = glm::radians(360.0f * particle_random(random));
+                    position += glm::vec2{std::cos(angle), std::sin(angle)} * distance;
                 }
 
-                if (angular_velocity->max_speed > 0.0f) {
-                    if (std::abs(velocity) > angular_velocity->max_speed) {
-                        velocity = std::copysign(angular_velocity->max_speed, velocity);
-                        angular_velocity->value = velocity;
-                    }
+                const float direction = glm::radians(
+                    rotation + settings.direction +
+                    (particle_random(random) - 0.5f) * settings.spread);
+                const float speed = glm::mix(settings.speed_min, settings.speed_max,
+                                             particle_random(random));
+                const float lifetime = glm::mix(settings.lifetime_min, settings.lifetime_max,
+                                                particle_random(random));
+
+                const glm::vec2 velocity = {std::cos(direction) * speed,
+                                            std::sin(direction) * speed};
+                if (emitter.pool.spawn(position, velocity, lifetime) == false) {
+                    break;
                 }
+            }
+        }
+
+        /**
+         * @brief Resolve a sprite from the entity's cold key, for first use or a replaced sprite.
+         */
+        [[nodiscard]] game_sprite::handle sprite_handle_resolve(const entt::registry& registry,
+                                                                const entt::entity entity,
+                                                                const game_resources& resources) {
+            const auto* key = registry.try_get<component_sprite_key>(entity);
+            return (key != nullptr) ? resources.sprite_handle_get(key->resource_key)
+                                    : game_sprite::handle{};
+        }
 
-                transform.rotation += velocity * tick_interval;
+        [[nodiscard]] game_text_dynamic::handle text_handle_resolve(
+            const entt::registry& registry, const entt::entity entity,
+            const game_resources& resources) {
+            const auto* key = registry.try_get<component_text_key>(entity);
+            return (key != nullptr) ? resources.text_dynamic_handle_get(key->resource_key)
+                                    : game_text_dynamic::handle{};
+        }
+    }  // namespace
 
-                // Normalize rotation.
-                while (transform.rotation >= 360.0f) {
-                    transform.rotation -= 360.0f;
-                }
+    void system_physics::update(entt::registry& registry, const float tick_interval,
+                                game_jobs* jobs) {
+        snapshot_interpolation(registry, jobs);
+        integrate_velocity_linear(registry, tick_interval, jobs);
+        integrate_velocity_angular(registry, tick_interval, jobs);
+    }
 
-                while (transform.rotation < 0.0f) {
-                    transform.rotation += 360.0f;
-                }
+    void system_physics::prepare(entt::registry& registry) {
+        static_cast<void>(registry.group<component_interpolation>(
+            entt::get<component_position, component_rotation>));
+        static_cast<void>(registry.group<component_velocity_linear, component_position>());
+        static_cast<void>(registry.group<component_velocity_angular, component_rotation>());
+    }
+
+    void system_physics::snapshot_interpolation(entt::registry& registry, game_jobs* jobs) {
+        auto group = registry.group<component_interpolation>(
+            entt::get<component_position, component_rotation>);
+
+        auto& interpolations = registry.storage<component_interpolation>();
+        const auto& positions = registry.storage<component_position>();
+        const auto& rotations = registry.storage<component_rotation>();
+        constexpr std::size_t page_size =
+            entt::component_traits<component_interpolation>::page_size;
+
+        // Store previous position and rotation so rendering can blend towards this tick.
+        for_each_page_chunk(jobs, group.size(), page_size,
+                            [&](const std::size_t begin, const std::size_t end) {
+                                component_interpolation* page =
+                                    interpolations.raw()[begin / page_size];
+                                const entt::entity* entities = interpolations.data();
+
+                                for (std::size_t i = begin; i < end; ++i) {
+                                    component_interpolation& interp = page[i % page_size];
+                                    interp.previous_position = positions.get(entities[i]).value;
+                                    interp.previous_rotation = rotations.get(entities[i]).value;
+                                }
+                            });
+    }
+
+    void system_physics::integrate_velocity_linear(entt::registry& registry,
+                                                   const float tick_interval, game_jobs* jobs) {
+        // Owning both storages keeps velocities and positions packed index for index at the
+        // front of their pools, so the kernels can stream over whole storage pages.
+        auto group = registry.group<component_velocity_linear, component_position>();
+        const physics_kernels& kernels = physics_kernels_best();
+
+        auto& velocities = registry.storage<component_velocity_linear>();
+        auto& positions = registry.storage<component_position>();
+
+        constexpr std::size_t page_size =
+            entt::component_traits<component_velocity_linear>::page_size;
+        static_assert(page_size == entt::component_traits<component_position>::page_size);
+
+        for_each_page_chunk(jobs, group.size(), page_size,
+                            [&](const std::size_t begin, const std::size_t end) {
+                                const std::size_t page = begin / page_size;
+                                kernels.integrate_linear(velocities.raw()[page],
+                                                         positions.raw()[page], end - begin,
+                                                         tick_interval);
+                            });
+    }
+
+    void system_physics::integrate_velocity_angular(entt::registry& registry,
+                                                    const float tick_interval, game_jobs* jobs) {
+        // Rotations have their own storage, so this group owns them the way the linear group
+        // owns positions and the kernels integrate them in the same pass.
+        auto group = registry.group<component_velocity_angular, component_rotation>();
+        const physics_kernels& kernels = physics_kernels_best();
+
+        auto& velocities = registry.storage<component_velocity_angular>();
+        auto& rotations = registry.storage<component_rotation>();
+
+        constexpr std::size_t page_size =
+            entt::component_traits<component_velocity_angular>::page_size;
+        static_assert(page_size == entt::component_traits<component_rotation>::page_size);
+
+        for_each_page_chunk(jobs, group.size(), page_size,
+                            [&](const std::size_t begin, const std::size_t end) {
+                                const std::size_t page = begin / page_size;
+                                kernels.integrate_angular(velocities.raw()[page],
+                                                          rotations.raw()[page], end - begin,
+                                                          tick_interval);
+                            });
+    }
+
+    void system_particles::update(entt::registry& registry, const float tick_interval,
+                                  game_jobs* jobs) {
+        auto& emitters = registry.storage<component_particle_emitter>();
+        const auto& positions = registry.storage<component_position>();
+        const auto& rotations = registry.storage<component_rotation>();
+        const physics_kernels& kernels = physics_kernels_best();
+
+        const std::size_t count = emitters.size();
+        const entt::entity* entities = emitters.data();
+
+        // Pools are independent, so every emitter is a job of its own and only reads the
+        // position and rotation storages of the entities.
+        const auto emitters_update = [&](const std::size_t begin, const std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                const entt::entity entity = entities[i];
+                component_particle_emitter& emitter = emitters.get(entity);
+                game_particle_pool& pool = emitter.pool;
+
+                kernels.integrate_particles(pool.get_arrays(), pool.get_count(),
+                                            emitter.settings.acceleration, emitter.settings.drag,
+                                            tick_interval);
+                pool.expired_remove();
+
+                const glm::vec2 origin = (positions.contains(entity) == true)
+                                             ? positions.get(entity).value
+                                             : glm::vec2{0.0f, 0.0f};
+                const float rotation =
+                    (rotations.contains(entity) == true) ? rotations.get(entity).value : 0.0f;
+                particles_spawn(emitter, origin, rotation, tick_interval);
             }
+        };
+
+        if (jobs == nullptr) {
+            emitters_update(0, count);
+            return;
         }
+
+        jobs->parallel_for(count, 1, emitters_update);
     }
 
     void system_renderer::update(entt::registry& registry, game_renderer* renderer,
                                  game_resources& resources, const float fraction_to_next_tick) {
-        // TODO: Optimize all of this rubbish. Also, make the layering work.
-
-        // Render sprites.
-        auto resource_sprite_view =
-            registry.view<component_transform, component_renderable, component_sprite>();
-        for (auto [entity, transform, renderable, sprite_comp] : resource_sprite_view.each()) {
+        // Sprites and dynamic text are collected once into the renderer's render list, which
+        // every render pass then culls, sorts by layer and texture, and draws.
+        game_render_list& list = renderer->render_list_begin();
+
+        const auto sprite_queue = [&](const entt::entity entity, const component_position& position,
+                                      const component_rotation& rotation,
+                                      const component_scale& scale,
+                                      const component_renderable& renderable,
+                                      component_sprite& sprite_comp) {
             if (renderable.is_visible == false) {
-                continue;
+                return;
             }
 
-            if (auto* sprite = resources.sprite_get(sprite_comp.resource_key)) {
-                glm::vec2 render_position = transform.position;
-                float render_rotation = transform.rotation;
+            game_sprite* sprite = resources.sprite_get(sprite_comp.handle);
+            if (sprite == nullptr) {
+                // First draw or the sprite was replaced, resolve the key once and cache it.
+                sprite_comp.handle = sprite_handle_resolve(registry, entity, resources);
+                sprite = resources.sprite_get(sprite_comp.handle);
+            }
+
+            if (sprite != nullptr) {
+                glm::vec2 render_position = position.value;
+                float render_rotation = rotation.value;
 
                 // Apply interpolation if available
                 if (auto* interp = registry.try_get<component_interpolation>(entity)) {
-                    render_position = glm::mix(interp->previous_position, transform.position,
+                    render_position = glm::mix(interp->previous_position, position.value,
                                                fraction_to_next_tick);
 
                     // Interpolate rotation with wrap-around
-                    const float previous_rotation = interp->previous_rotation;
-                    const float current_rotation = transform.rotation;
-
-                    float rotation_diff = current_rotation - previous_rotation;
-                    if (rotation_diff > 180.0f) {
-                        rotation_diff -= 360.0f;
-                    } else if (rotation_diff < -180.0f) {
-                        rotation_diff += 360.0f;
-                    }
-
-                    render_rotation = previous_rotation + (rotation_diff * fraction_to_next_tick);
+                    render_rotation = rotation_lerp(interp->previous_rotation, rotation.value,
+                                                    fraction_to_next_tick);
                 }
 
-                sprite->set_rotation(render_rotation);
-                sprite->set_scale(transform.scale);
+                const auto* animation = registry.try_get<component_animation>(entity);
+                const glm::vec4 uv = (animation != nullptr) ? animation->uv : sprite->get_uv();
 
-                renderer->sprite_draw_world(sprite, render_position);
+                list.sprites.push_back({sprite, render_position, render_rotation, scale.value,
+                                        uv, renderable.layer});
             }
+        };
+
+        // With render passes, the index is queried once for what any of their cameras sees.
+        glm::vec2 visible_min = {0.f, 0.f};
+        glm::vec2 visible_max = {0.f, 0.f};
+        bool has_visible_area = false;
+
+        if (renderer->get_pass_count() > 0) {
+            has_visible_area = renderer->passes_visible_area(visible_min, visible_max);
+        } else if (const game_view_transform* view = renderer->get_view(); view != nullptr) {
+            visible_min = view->visible_min;
+            visible_max = view->visible_max;
+            has_visible_area = true;
         }
 
-        // Render dynamic text
-        auto dynamic_text_view =
-            registry.view<component_transform, component_renderable, component_text_dynamic>();
-        for (auto [entity, transform, renderable, text_comp] : dynamic_text_view.each()) {
+        // Queue sprites, only visiting indexed candidates near the view when possible.
+        auto* render_index = registry.ctx().find<game_render_index>();
+
+        if (render_index != nullptr && render_index->is_built() == true &&
+            has_visible_area == true) {
+            // Retained layers render past the view so panning can reuse them.
+            const float margin = resources.sprite_extent_max() * render_index->get_scale_max() +
+                                 renderer->get_layer_retain_margin_world();
+            const glm::vec2 extent = {margin, margin};
+
+            for (const entt::entity entity : render_index->visible_collect(
+                     registry, visible_min - extent, visible_max + extent)) {
+                auto [position, rotation, scale, renderable, sprite_comp] =
+                    registry.get<component_position, component_rotation, component_scale,
+                                 component_renderable, component_sprite>(entity);
+                sprite_queue(entity, position, rotation, scale, renderable, sprite_comp);
+            }
+        } else {
+            auto resource_sprite_view =
+                registry.view<component_position, component_rotation, component_scale,
+                              component_renderable, component_sprite>();
+            for (auto [entity, position, rotation, scale, renderable, sprite_comp] :
+                 resource_sprite_view.each()) {
+                sprite_queue(entity, position, rotation, scale, renderable, sprite_comp);
+            }
+        }
+
+        // Queue dynamic text
+        auto dynamic_text_view = registry.view<component_position, component_rotation,
+                                               component_scale, component_renderable,
+                                               component_text_dynamic>();
+        for (auto [entity, position, rotation, scale, renderable, text_comp] :
+             dynamic_text_view.each()) {
             if (renderable.is_visible == false) {
                 continue;
             }
 
-            if (auto* text = resources.text_dynamic_get(text_comp.resource_key)) {
-                glm::vec2 render_position = transform.position;
+            game_text_dynamic* text = resources.text_dynamic_get(text_comp.handle);
+            if (text == nullptr) {
+                text_comp.handle = text_handle_resolve(registry, entity, resources);
+                text = resources.text_dynamic_get(text_comp.handle);
+            }
+
+            if (text != nullptr) {
+                glm::vec2 render_position = position.value;
 
                 // Apply interpolation if available
                 if (auto* interp = registry.try_get<component_interpolation>(entity)) {
-                    render_position = glm::mix(interp->previous_position, transform.position,
+                    render_position = glm::mix(interp->previous_position, position.value,
                                                fraction_to_next_tick);
                 }
 
-                // Apply transform properties
-                text->set_scale(transform.scale);
-                text->set_rotation(transform.rotation);
+                list.texts.push_back(
+                    {text, render_position, rotation.value, scale.value, renderable.layer});
+            }
+        }
+
+        // Queue particle emitters, the list points at their pools instead of copying them.
+        auto emitter_view = registry.view<component_particle_emitter>();
+        for (auto [entity, emitter] : emitter_view.each()) {
+            const game_particle_pool& pool = emitter.pool;
+            if (pool.get_count() == 0) {
+                continue;
+            }
 
-                renderer->text_draw_world(text, render_position);
+            game_sprite* sprite = resources.sprite_get(emitter.sprite);
+            if (sprite == nullptr) {
+                emitter.sprite = resources.sprite_handle_get(emitter.sprite_key);
+                sprite = resources.sprite_get(emitter.sprite);
+            }
+
+            if (sprite != nullptr) {
+                list.particles.push_back({sprite, pool.get_position_x(), pool.get_position_y(),
+                                          pool.get_previous_x(), pool.get_previous_y(),
+                                          pool.get_remaining(), pool.get_lifetime(),
+                                          pool.get_count(), fraction_to_next_tick,
+                                          emitter.settings.appearance, emitter.settings.layer});
             }
         }
+
+        renderer->render_list_draw();
+    }
+
+    void system_render_packet::write(entt::registry& registry, const game_resources& resources,
+                                     game_render_packet& packet) {
+        auto sprite_view = registry.view<component_position, component_rotation, component_scale,
+                                         component_renderable, component_sprite>();
+        for (auto [entity, position, rotation, scale, renderable, sprite_comp] :
+             sprite_view.each()) {
+            if (renderable.is_visible == false) {
+                continue;
+            }
+
+            // First write or the sprite was replaced, same resolution as `system_renderer`.
+            if (resources.sprite_get(sprite_comp.handle) == nullptr) {
+                sprite_comp.handle = sprite_handle_resolve(registry, entity, resources);
+            }
+
+            game_render_packet_sprite& entry = packet.sprites.emplace_back();
+            entry.sprite = sprite_comp.handle;
+            entry.position = position.value;
+            entry.rotation = rotation.value;
+            entry.scale = scale.value;
+            entry.layer = renderable.layer;
+
+            if (const auto* animation = registry.try_get<component_animation>(entity)) {
+                entry.uv = animation->uv;
+            } else if (const game_sprite* sprite = resources.sprite_get(sprite_comp.handle)) {
+                entry.uv = sprite->get_uv();
+            }
+
+            if (const auto* interp = registry.try_get<component_interpolation>(entity)) {
+                entry.position_previous = interp->previous_position;
+                entry.rotation_previous = interp->previous_rotation;
+            } else {
+                entry.position_previous = position.value;
+                entry.rotation_previous = rotation.value;
+            }
+        }
+
+        auto text_view = registry.view<component_position, component_rotation, component_scale,
+                                       component_renderable, component_text_dynamic>();
+        for (auto [entity, position, rotation, scale, renderable, text_comp] : text_view.each()) {
+            if (renderable.is_visible == false) {
+                continue;
+            }
+
+            if (resources.text_dynamic_get(text_comp.handle) == nullptr) {
+                text_comp.handle = text_handle_resolve(registry, entity, resources);
+            }
+
+            game_render_packet_text& entry = packet.texts.emplace_back();
+            entry.text = text_comp.handle;
+            entry.position = position.value;
+            entry.rotation = rotation.value;
+            entry.scale = scale.value;
+            entry.layer = renderable.layer;
+
+            const auto* interp = registry.try_get<component_interpolation>(entity);
+            entry.position_previous =
+                (interp != nullptr) ? interp->previous_position : position.value;
+        }
+
+        // Pools keep changing on this thread, so their arrays are copied into the packet.
+        auto emitter_view = registry.view<component_particle_emitter>();
+        for (auto [entity, emitter] : emitter_view.each()) {
+            const game_particle_pool& pool = emitter.pool;
+            const std::size_t count = pool.get_count();
+            if (count == 0) {
+                continue;
+            }
+
+            if (resources.sprite_get(emitter.sprite) == nullptr) {
+                emitter.sprite = resources.sprite_handle_get(emitter.sprite_key);
+            }
+
+            game_render_packet_particles& entry = packet.particles.emplace_back();
+            entry.sprite = emitter.sprite;
+            entry.first = packet.particle_data.size();
+            entry.count = count;
+            entry.appearance = emitter.settings.appearance;
+            entry.layer = emitter.settings.layer;
+
+            for (const float* field : {pool.get_position_x(), pool.get_position_y(),
+                                       pool.get_previous_x(), pool.get_previous_y(),
+                                       pool.get_remaining(), pool.get_lifetime()}) {
+                packet.particle_data.insert(packet.particle_data.end(), field, field + count);
+            }
+        }
+    }
+
+    void system_render_packet::draw(const game_render_packet& packet, game_renderer* renderer,
+                                    game_resources& resources) {
+        const float fraction = packet.fraction_to_next_tick;
+        game_render_list& list = renderer->render_list_begin();
+
+        for (const game_render_packet_sprite& entry : packet.sprites) {
+            if (game_sprite* sprite = resources.sprite_get(entry.sprite); sprite != nullptr) {
+                list.sprites.push_back(
+                    {sprite, glm::mix(entry.position_previous, entry.position, fraction),
+                     rotation_lerp(entry.rotation_previous, entry.rotation, fraction),
+                     entry.scale, entry.uv, entry.layer});
+            }
+        }
+
+        for (const game_render_packet_text& entry : packet.texts) {
+            if (game_text_dynamic* text = resources.text_dynamic_get(entry.text); text != nullptr) {
+                list.texts.push_back({text,
+                                      glm::mix(entry.position_previous, entry.position, fraction),
+                                      entry.rotation, entry.scale, entry.layer});
+            }
+        }
+
+        for (const game_render_packet_particles& entry : packet.particles) {
+            if (game_sprite* sprite = resources.sprite_get(entry.sprite); sprite != nullptr) {
+                const float* data = packet.particle_data.data() + entry.first;
+                const std::size_t count = entry.count;
+
+                list.particles.push_back({sprite, data, data + count, data + count * 2,
+                                          data + count * 3, data + count * 4, data + count * 5,
+                                          count, fraction, entry.appearance, entry.layer});
+            }
+        }
+
+        renderer->render_list_draw();
+    }
+
+    void system_animation::update(entt::registry& registry, const float tick_interval) {
+        const auto* clips = registry.ctx().find<game_animation_clips>();
+        if (clips == nullptr) {
+            return;
+        }
+
+        auto view = registry.view<component_animation>();
+        for (auto [entity, animation] : view.each()) {
+            if (animation.is_playing == false || animation.speed <= 0.f) {
+                continue;
+            }
+
+            const game_animation_clip* clip = clips->get(animation.clip);
+            if (clip == nullptr) {
+                continue;
+            }
+
+            const std::span<const game_animation_frame> frames = clip->get_frames();
+            animation.frame_time += tick_interval * animation.speed;
+
+            // Whole loops skipped at once, so a fast clip costs at most one pass per tick.
+            if (clip->is_looping() == true && animation.frame_time >= clip->get_duration()) {
+                animation.frame_time = std::fmod(animation.frame_time, clip->get_duration());
+            }
+
+            std::uint32_t frame = std::min<std::uint32_t>(
+                animation.frame, static_cast<std::uint32_t>(frames.size() - 1));
+
+            while (animation.frame_time >= frames[frame].duration) {
+                if (frame + 1 < frames.size()) {
+                    animation.frame_time -= frames[frame].duration;
+                    frame++;
+                } else if (clip->is_looping() == true) {
+                    animation.frame_time -= frames[frame].duration;
+                    frame = 0;
+                } else {
+                    animation.frame_time = 0.f;
+                    animation.is_playing = false;
+                    break;
+                }
+            }
+
+            animation.frame = frame;
+            animation.uv = frames[frame].uv;
+        }
     }
 
     // Lifetime System Implementation
     void system_lifetime::update(entt::registry& registry, float tick_interval) {
         auto view = registry.view<component_lifetime>();
-        std::vector<entt::entity> entities_to_destroy;
+        auto& commands = registry.ctx().get<game_entity_commands>();
 
         for (auto [entity, lifetime] : view.each()) {
             lifetime.remaining_seconds -= tick_interval;
 
+            // Once expired it stays expired, destroy the entity on the next flush.
             if (lifetime.remaining_seconds <= 0.0f) {
-                entities_to_destroy.push_back(entity);
+                commands.destroy(entity);
             }
         }
-
-        // Destroy expired entities.
-        for (auto entity : entities_to_destroy) {
-            registry.destroy(entity);
-        }
     }
 }  // namespace engine
@@ -6,18 +6,88 @@
 namespace engine {
     class game_renderer;
     class game_resources;
+    class game_jobs;
+    struct game_render_packet;
 
+    /**
+     * @brief Physics system that integrates linear and angular velocities.
+     *
+     * Runs as separate passes over EnTT owning groups, so each pass walks the packed arrays of the
+     * components it owns: linear velocities with positions, angular velocities with rotations.
+     * Only the interpolation snapshot fetches positions and rotations per entity.
+     *
+     * Velocity passes hand whole storage pages to the kernels from `physics_kernels_best`, which
+     * use the widest SIMD instruction set the CPU reports.
+     *
+     * @note The groups own `component_interpolation`, `component_velocity_linear`,
+     * `component_velocity_angular`, `component_position` and `component_rotation`, those storages
+     * must not be sorted or owned elsewhere.
+     */
     class system_physics {
     public:
-        static void update(entt::registry& registry, float tick_interval);
+        /**
+         * @brief Run every physics pass once.
+         * @param registry The registry to update.
+         * @param tick_interval Fixed tick interval in seconds.
+         * @param jobs Pool to split each pass across by storage page, nullptr runs inline.
+         */
+        static void update(entt::registry& registry, float tick_interval,
+                           game_jobs* jobs = nullptr);
+
+        /**
+         * @brief Create the groups used by `update` ahead of time.
+         */
+        static void prepare(entt::registry& registry);
 
     private:
-        static void integrate_velocity(entt::registry& registry, float tick_interval);
+        static void snapshot_interpolation(entt::registry& registry, game_jobs* jobs);
+        static void integrate_velocity_linear(entt::registry& registry, float tick_interval,
+                                              game_jobs* jobs);
+        static void integrate_velocity_angular(entt::registry& registry, float tick_interval,
+                                               game_jobs* jobs);
+    };
+
+    /**
+     * @brief Spawns, moves and expires the particles of every `component_particle_emitter`.
+     *
+     * Each pool is integrated by one call to the particle kernel from `physics_kernels_best`,
+     * which streams its arrays with the widest SIMD instruction set the CPU reports, and emitters
+     * are spread across the job pool. New particles spawn after integration at the emitter
+     * entity's `component_position`, turned by its `component_rotation` when it has one.
+     */
+    class system_particles {
+    public:
+        /**
+         * @param jobs Pool to split emitters across, nullptr runs inline.
+         */
+        static void update(entt::registry& registry, float tick_interval,
+                           game_jobs* jobs = nullptr);
+    };
+
+    /**
+     * @brief Advances every playing `component_animation` through its clip's frame table.
+     *
+     * Clips are resolved by handle from the registry context's `game_animation_clips`, and each
+     * entity's current frame rect is written to its component, so drawing it is a plain copy.
+     * Entities whose clip was destroyed keep their last frame.
+     */
+    class system_animation {
+    public:
+        static void update(entt::registry& registry, float tick_interval);
     };
 
     /**
      * @brief Rendering system for sprites with ECS components
-     * @note currently only renders entities with sprites and with interpolated transform components
+     * @note Sprites and dynamic text are collected into the renderer's render list once and drawn
+     * by every render pass in `component_renderable::layer` order, ties keep a deterministic
+     * per-texture order.
+     *
+     * When the registry context holds a built `game_render_index` and the renderer has a view,
+     * only sprites the index reports near the visible area are visited. With render passes that
+     * area covers every pass's camera.
+     *
+     * Particle emitters are added to the list by pointing at their pools, so the renderer reads
+     * particles straight from the arrays `system_particles` wrote.
      */
     class system_renderer {
     public:
@@ -25,8 +95,33 @@ namespace engine {
                            game_resources& resources, float fraction_to_next_tick);
     };
 
+    /**
+     * @brief Copies renderable state out of the registry so it can be drawn on another thread.
+     *
+     * `write` runs on the thread that owns the registry and resolves resource handles once,
+     * `draw` only reads the packet and the resources and never touches a registry.
+     */
+    class system_render_packet {
+    public:
+        /**
+         * @brief Fill a packet with every visible sprite, dynamic text and particle.
+         * @note Reads resources without modifying them, which may run alongside `draw`.
+         */
+        static void write(entt::registry& registry, const game_resources& resources,
+                          game_render_packet& packet);
+
+        /**
+         * @brief Queue a packet's sprites and text into the renderer, interpolated by the
+         *        packet's own fraction, and flush the batch.
+         */
+        static void draw(const game_render_packet& packet, game_renderer* renderer,
+                         game_resources& resources);
+    };
+
     /**
      * @brief Lifetime system that handles entity expiration
+     * @note Expired entities are recorded into the registry context's `game_entity_commands`
+     * and only destroyed when it is flushed, so the system can run alongside others.
      */
     class system_lifetime {
     public:
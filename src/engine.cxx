@@ -1,5 +1,7 @@
 #include "engine.hxx"
 
+#include <algorithm>
+#include <cmath>
 #include <stdexcept>
 
 #include <SDL3/SDL_main.h>
@@ -10,24 +12,52 @@
 
 namespace engine {
     game_engine::game_engine(std::string_view title, const glm::ivec2& size, void* game_state,
-                             const game_engine_callbacks& callbacks)
+                             const game_engine_callbacks& callbacks,
+                             const game_window_type window_type)
         : m_wrapper(),
           m_is_running(false),
           m_state(game_state),
           m_callbacks(callbacks),
-          m_window(std::make_unique<game_window>(title, size, game_window_type::resizable)),
+          m_jobs(std::make_unique<game_jobs>()),
+          m_archive(std::make_unique<game_asset_archive>()),
+          m_window(std::make_unique<game_window>(title, size, window_type)),
           m_renderer(std::make_unique<game_renderer>(m_window->get_sdl_window())),
           m_input(std::make_unique<game_input>()),
+          m_resource_cache(std::make_unique<game_resource_cache>()),
+          m_frame_arena(std::make_unique<game_arena>()),
+          m_tick_arena(std::make_unique<game_arena>()),
           m_scenes(std::make_unique<game_scenes>(this)),
           m_tick_interval_seconds(-1.f),
           m_fraction_to_next_tick(-1.f),
-          m_frame_interval_seconds(-1.f) {
+          m_frame_interval_seconds(-1.f),
+          m_max_ticks_per_frame(8),
+          m_tick_accumulator_max_seconds(0.25f),
+          m_time_scale(1.f),
+          m_tick_stats(),
+          m_input_timestamp_ns(0),
+          m_tick_timestamp_ns(0),
+          m_vsync(game_vsync::off),
+          m_frame_interval_target_seconds(0.f),
+          m_frame_stats(),
+          m_is_simulation_threaded(false),
+          m_render_packets() {
         // Set a default icon, can be overridden later.
         m_window->set_icon("assets/helipad/icons/default");
 
         // Set the default tick rate.
         set_tick_rate(32.f);
 
+        // Without vsync or a frame cap the loop renders as fast as it can on a whole core.
+        set_vsync(game_vsync::on);
+
+        // Scenes created from here on read their assets from the archive when it exists.
+        if constexpr (should_use_asset_archive == true) {
+            if (m_archive->open(asset_archive_path_default) == false) {
+                log_warning("No asset archive at '{}', loading loose files.",
+                            asset_archive_path_default);
+            }
+        }
+
         // Let the game know it has been created.
         invoke_void(m_callbacks.on_start, this);
     }
@@ -48,14 +78,45 @@ namespace engine {
         log_info("Starting game loop...");
 
         std::uint64_t frame_performance_count = performance_counter_value_current();
+        std::uint64_t frame_deadline = frame_performance_count;
         float seconds_since_last_tick = 0.f;
 
+        // Ticks of a frame run on this thread while it draws the packet of the previous ones.
+        std::unique_ptr<game_simulation_thread> simulation;
+        if (m_is_simulation_threaded == true) {
+            simulation = std::make_unique<game_simulation_thread>(
+                [](void* context, const std::uint32_t tick_count, const float fraction) {
+                    static_cast<game_engine*>(context)->simulation_batch_run(tick_count, fraction);
+                },
+                this);
+        }
+
+        float simulation_fraction = 0.f;
+
         while (m_is_running == true) {
+            if constexpr (should_profile) {
+                game_profiler::get().frame_begin();
+            }
+
+            const game_profile_zone frame_zone("frame");
+
+            // Nothing allocated by the last frame survives it, its input and draw stages are done.
+            m_frame_arena->reset();
+
             m_frame_interval_seconds = performance_counter_seconds_since(frame_performance_count);
             frame_performance_count = performance_counter_value_current();
-            seconds_since_last_tick += m_frame_interval_seconds;
+            seconds_since_last_tick += m_frame_interval_seconds * m_time_scale;
+            frame_stats_update(m_frame_interval_seconds);
+
+            if (simulation != nullptr) {
+                // From here until the next batch starts this thread owns the simulation.
+                const game_profile_zone zone("simulation_wait");
+                simulation->wait();
+                m_fraction_to_next_tick = simulation_fraction;
+            }
 
             {
+                const game_profile_zone zone("input");
                 m_input->update();
 
                 SDL_Event event;
@@ -67,33 +128,217 @@ namespace engine {
                     m_input->process_sdl_event(event);
                 }
 
+                m_input_timestamp_ns = SDL_GetTicksNS();
                 m_scenes->on_engine_input();
             }
 
-            while (seconds_since_last_tick >= m_tick_interval_seconds) [[likely]] {
-                m_scenes->on_engine_tick(m_tick_interval_seconds);
-                invoke_void(m_callbacks.on_tick, this, m_tick_interval_seconds);
-                seconds_since_last_tick -= m_tick_interval_seconds;
+            const std::uint32_t tick_count = tick_count_schedule(seconds_since_last_tick);
+
+            if (simulation != nullptr) {
+                // Frame callbacks see the state and fraction of the packet drawn this frame.
+                frame_callbacks_run();
+
+                simulation_fraction = seconds_since_last_tick / m_tick_interval_seconds;
+                simulation->run_async(tick_count, simulation_fraction);
+            } else {
+                ticks_run(tick_count);
+                m_fraction_to_next_tick = seconds_since_last_tick / m_tick_interval_seconds;
+                frame_callbacks_run();
+            }
+
+            {
+                const game_profile_zone zone("draw");
+                m_renderer->draw_begin();
+
+                if (simulation != nullptr) {
+                    m_scenes->render_packet_draw(m_render_packets.read_latest());
+                }
+
+                m_scenes->on_engine_draw(m_fraction_to_next_tick);
+                invoke_void(m_callbacks.on_draw, this, m_fraction_to_next_tick);
+                m_renderer->sprite_batch_flush();
+            }
+
+            if constexpr (should_profile) {
+                game_profiler::get().draw_overlay(m_renderer->get_sdl_renderer());
+            }
+
+            {
+                // Mostly time spent waiting on vsync.
+                const game_profile_zone zone("present");
+                m_renderer->draw_end();
             }
 
-            m_fraction_to_next_tick = seconds_since_last_tick / m_tick_interval_seconds;
+            if (m_frame_interval_target_seconds > 0.f) {
+                const game_profile_zone zone("frame_wait");
+                frame_deadline +=
+                    performance_counter_value_from_seconds(m_frame_interval_target_seconds);
 
-            m_scenes->on_engine_frame(m_frame_interval_seconds);
-            invoke_void(m_callbacks.on_frame, this, m_frame_interval_seconds);
+                // A frame that overran its deadline restarts pacing, rushing the next frames
+                // to catch up would only make them uneven.
+                const std::uint64_t now = performance_counter_value_current();
+                if (now >= frame_deadline) {
+                    frame_deadline = now;
+                } else {
+                    performance_counter_wait_until(frame_deadline);
+                }
+            }
+        }
 
-            m_renderer->draw_begin();
-            m_scenes->on_engine_draw(m_fraction_to_next_tick);
-            invoke_void(m_callbacks.on_draw, this, m_fraction_to_next_tick);
-            m_renderer->draw_end();
+        // The last batch may still be ticking scenes that are about to be unloaded.
+        if (simulation != nullptr) {
+            simulation->wait();
         }
 
         log_info("Ending game loop...");
+
+        if constexpr (should_profile) {
+            game_profiler::get().dump_chrome_trace(profile_trace_path_default);
+        }
     }
 
     void game_engine::stop_running() noexcept {
         m_is_running = false;
     }
 
+    void game_engine::set_simulation_threaded(const bool is_threaded) {
+        if (m_is_running == true) {
+            log_warning("The simulation mode cannot change while the game loop is running.");
+            return;
+        }
+
+        m_is_simulation_threaded = is_threaded;
+    }
+
+    std::uint32_t game_engine::tick_count_schedule(float& seconds_since_last_tick) {
+        // Time owed beyond the clamp is never simulated. The clamp is never below one tick,
+        // or a slow tick rate could not tick at all.
+        const float accumulator_max =
+            std::max(m_tick_accumulator_max_seconds, m_tick_interval_seconds);
+        if (seconds_since_last_tick > accumulator_max) {
+            const float excess = seconds_since_last_tick - accumulator_max;
+            m_tick_stats.ticks_dropped +=
+                static_cast<std::uint64_t>(excess / m_tick_interval_seconds);
+            seconds_since_last_tick = accumulator_max;
+        }
+
+        std::uint32_t tick_count = 0;
+        while (seconds_since_last_tick >= m_tick_interval_seconds &&
+               tick_count < m_max_ticks_per_frame) [[likely]] {
+            seconds_since_last_tick -= m_tick_interval_seconds;
+            tick_count++;
+        }
+
+        // Drop whole ticks past the cap but keep the remainder, so interpolation stays smooth.
+        if (seconds_since_last_tick >= m_tick_interval_seconds) {
+            const auto dropped =
+                static_cast<std::uint32_t>(seconds_since_last_tick / m_tick_interval_seconds);
+            seconds_since_last_tick -= static_cast<float>(dropped) * m_tick_interval_seconds;
+            m_tick_stats.ticks_dropped += dropped;
+            m_tick_stats.frames_capped++;
+        }
+
+        m_tick_stats.ticks += tick_count;
+        m_tick_stats.ticks_late += (tick_count > 1) ? tick_count - 1 : 0;
+        m_tick_stats.ticks_last_frame = tick_count;
+
+        return tick_count;
+    }
+
+    void game_engine::ticks_run(const std::uint32_t tick_count) {
+        const auto tick_interval_ns = static_cast<std::uint64_t>(
+            static_cast<double>(m_tick_interval_seconds) * 1'000'000'000.0);
+
+        for (std::uint32_t i = 0; i < tick_count; ++i) {
+            const game_profile_zone zone("tick");
+            m_tick_arena->reset();
+
+            // Spread the frame's ticks back from the input poll, the last one lands on it.
+            const std::uint64_t ticks_after = static_cast<std::uint64_t>(tick_count - 1 - i);
+            const std::uint64_t offset_ns = ticks_after * tick_interval_ns;
+            m_tick_timestamp_ns =
+                (m_input_timestamp_ns > offset_ns) ? m_input_timestamp_ns - offset_ns : 0;
+
+            m_scenes->on_engine_tick(m_tick_interval_seconds);
+            invoke_void(m_callbacks.on_tick, this, m_tick_interval_seconds);
+        }
+    }
+
+    void game_engine::frame_callbacks_run() {
+        const game_profile_zone zone("on_frame");
+        m_scenes->on_engine_frame(m_frame_interval_seconds);
+        invoke_void(m_callbacks.on_frame, this, m_frame_interval_seconds);
+    }
+
+    void game_engine::simulation_batch_run(const std::uint32_t tick_count,
+                                           const float fraction_to_next_tick) {
+        ticks_run(tick_count);
+
+        game_render_packet& packet = m_render_packets.write_begin();
+        m_scenes->render_packet_write(packet);
+        packet.fraction_to_next_tick = fraction_to_next_tick;
+        m_render_packets.write_publish();
+    }
+
+    void game_engine::set_max_ticks_per_frame(const std::uint32_t max_ticks) {
+        if (max_ticks == 0) {
+            log_warning("At least one tick per frame is needed, using 1 instead of 0.");
+        }
+
+        m_max_ticks_per_frame = std::max<std::uint32_t>(max_ticks, 1);
+    }
+
+    void game_engine::set_tick_accumulator_max(const float max_seconds) {
+        m_tick_accumulator_max_seconds = std::max(max_seconds, 0.f);
+    }
+
+    void game_engine::set_time_scale(const float time_scale) {
+        m_time_scale = std::max(time_scale, 0.f);
+    }
+
+    bool game_engine::set_vsync(const game_vsync vsync) {
+        SDL_Renderer* sdl_renderer = m_renderer->get_sdl_renderer();
+
+        if (SDL_SetRenderVSync(sdl_renderer, static_cast<int>(vsync)) == true) {
+            m_vsync = vsync;
+            return true;
+        }
+
+        if (vsync == game_vsync::adaptive &&
+            SDL_SetRenderVSync(sdl_renderer, static_cast<int>(game_vsync::on)) == true) {
+            log_warning("Adaptive vsync is not supported, using regular vsync instead.");
+            m_vsync = game_vsync::on;
+            return true;
+        }
+
+        log_warning("Failed to set vsync to {}: {}", static_cast<int>(vsync), SDL_GetError());
+        return false;
+    }
+
+    void game_engine::set_frame_rate_max(const float frame_rate) {
+        m_frame_interval_target_seconds =
+            (frame_rate > 0.f) ? ticks_rate_to_interval(frame_rate) : 0.f;
+    }
+
+    void game_engine::frame_stats_update(const float frame_interval) noexcept {
+        // Roughly the average of the last 20 frames, smooth enough for an FPS readout.
+        constexpr float smoothing = 0.05f;
+
+        game_frame_stats& stats = m_frame_stats;
+        if (stats.frames == 0) {
+            stats.interval_smoothed = frame_interval;
+            stats.interval_min = frame_interval;
+            stats.interval_max = frame_interval;
+        }
+
+        const float deviation = std::abs(frame_interval - stats.interval_smoothed);
+        stats.interval_smoothed += (frame_interval - stats.interval_smoothed) * smoothing;
+        stats.jitter_smoothed += (deviation - stats.jitter_smoothed) * smoothing;
+        stats.interval_min = std::min(stats.interval_min, frame_interval);
+        stats.interval_max = std::max(stats.interval_max, frame_interval);
+        stats.frames++;
+    }
+
     game_engine::engine_wrapper::engine_wrapper() {
         log_info("\n");
         log_info("Project '{}' (v{} {}) starting up...", project_name, version::full, build_type);
@@ -120,6 +365,9 @@ namespace engine {
 
         SDL_Quit();
         log_info("SDL shut down.");
+
+        // Queued messages would otherwise only be written when the program exits.
+        log_flush();
     }
 }  // namespace engine
 
@@ -13,10 +13,17 @@
 #include "renderer/viewport.hxx"
 #include "utils/window.hxx"
 #include "utils/resources.hxx"
+#include "utils/resource_cache.hxx"
+#include "utils/arena.hxx"
 #include "utils/input.hxx"
 #include "utils/scenes.hxx"
 #include "ecs/entities.hxx"
 #include "utils/timing.hxx"
+#include "utils/jobs.hxx"
+#include "utils/archive.hxx"
+#include "utils/profiler.hxx"
+#include "utils/simulation.hxx"
+#include "renderer/render_packet.hxx"
 
 /**
  * @brief The main entry point of the application.
@@ -58,6 +65,37 @@ namespace engine {
         void (*on_draw)(game_engine* engine, float fraction_to_next_tick) = nullptr;
     };
 
+    /**
+     * @brief Counters of the fixed-step loop, accumulated since the last reset.
+     */
+    struct game_tick_stats {
+        std::uint64_t ticks = 0;          ///< Ticks run.
+        std::uint64_t ticks_late = 0;     ///< Catch-up ticks run after the first one of a frame.
+        std::uint64_t ticks_dropped = 0;  ///< Ticks skipped by the per-frame cap or the clamp.
+        std::uint64_t frames_capped = 0;  ///< Frames that hit the per-frame tick cap.
+        std::uint32_t ticks_last_frame = 0;
+    };
+
+    /**
+     * @brief How presenting a frame waits on the display, values match `SDL_SetRenderVSync`.
+     */
+    enum class game_vsync {
+        adaptive = -1,  ///< Sync while keeping up, tear instead of stalling a late frame.
+        off = 0,
+        on = 1
+    };
+
+    /**
+     * @brief Frame time statistics, accumulated since the last reset.
+     */
+    struct game_frame_stats {
+        std::uint64_t frames = 0;
+        float interval_smoothed = 0.f;  ///< Exponential moving average of the frame interval.
+        float jitter_smoothed = 0.f;    ///< Moving average of the distance from that average.
+        float interval_min = 0.f;
+        float interval_max = 0.f;
+    };
+
     /**
      * @brief The primary game engine class.
      */
@@ -71,9 +109,13 @@ namespace engine {
          * @param size The initial size of the game window.
          * @param callbacks Your game state and its callbacks.
          * @param game_state Pointer to your game's state data.
+         * @param window_type How the window is shown, `hidden` runs the engine headless.
+         * @note For runs without a display, also select SDL's `dummy` video driver and the
+         * `software` renderer through `SDL_SetHint` before constructing the engine.
          */
         game_engine(std::string_view title, const glm::ivec2& size, void* game_state,
-                    const game_engine_callbacks& callbacks);
+                    const game_engine_callbacks& callbacks,
+                    game_window_type window_type = game_window_type::resizable);
         ~game_engine();
 
         game_engine(const game_engine&) = delete;
@@ -107,6 +149,36 @@ namespace engine {
         [[nodiscard]] game_renderer* get_renderer() noexcept;
         [[nodiscard]] game_input* get_input() noexcept;
         [[nodiscard]] game_scenes* get_scenes() noexcept;
+        [[nodiscard]] game_jobs* get_jobs() noexcept;
+
+        /**
+         * @brief Get the textures and fonts shared by the resources of every scene.
+         * @note Its budgets decide how much of what unloaded scenes used stays resident.
+         */
+        [[nodiscard]] game_resource_cache* get_resource_cache() noexcept;
+
+        /**
+         * @brief Get the arena reset when each frame begins, for data only the frame needs.
+         * @note Only use it from input, frame and draw callbacks, which run on the game thread.
+         */
+        [[nodiscard]] game_arena* get_frame_arena() noexcept;
+
+        /**
+         * @brief Get the arena reset before each fixed tick, for data only the tick needs.
+         * @note Only use it from tick callbacks, they may run on the simulation thread.
+         */
+        [[nodiscard]] game_arena* get_tick_arena() noexcept;
+
+        /**
+         * @brief Get the frame profiler, which only records zones when `ENGINE_PROFILE` is ON.
+         */
+        [[nodiscard]] game_profiler* get_profiler() noexcept;
+
+        /**
+         * @brief Get the cooked asset archive resources read from before loose files.
+         * @return The archive, nullptr if it is disabled for this build or was not found.
+         */
+        [[nodiscard]] const game_asset_archive* get_archive() const noexcept;
 
         [[nodiscard]] float get_tick_rate() noexcept;
         void set_tick_rate(float tick_rate_seconds);
@@ -115,6 +187,90 @@ namespace engine {
         [[nodiscard]] float get_fraction_to_next_tick() const noexcept;
         [[nodiscard]] float get_frame_interval() const noexcept;
 
+        /**
+         * @brief Get the real time the running tick stands for, as an `SDL_GetTicksNS` value.
+         *
+         * Ticks of a frame run back to back after input was polled, the last one stands for
+         * the poll itself and each earlier one for a tick interval before it. Pass this to
+         * `game_input::event_pop` so every tick only handles the input that happened up to it.
+         */
+        [[nodiscard]] std::uint64_t get_tick_timestamp() const noexcept;
+
+        /**
+         * @brief Limit how many ticks a single frame may run to catch up.
+         *
+         * After a slow frame the loop would otherwise run a burst of ticks that makes the next
+         * frame slower still. Ticks over the limit are dropped, so under load the simulation
+         * runs slower than real time instead of freezing.
+         *
+         * @param max_ticks Ticks per frame, at least 1.
+         */
+        void set_max_ticks_per_frame(std::uint32_t max_ticks);
+        [[nodiscard]] std::uint32_t get_max_ticks_per_frame() const noexcept;
+
+        /**
+         * @brief Limit the simulation time a frame may owe, the excess is dropped.
+         * @param max_seconds Upper bound of the tick accumulator, never less than one tick.
+         * @note Keeps a frame after a long stall, such as a window drag, from replaying it.
+         */
+        void set_tick_accumulator_max(float max_seconds);
+        [[nodiscard]] float get_tick_accumulator_max() const noexcept;
+
+        /**
+         * @brief Scale how fast simulation time passes relative to real time.
+         * @param time_scale Zero or more, 0.5 runs ticks at half speed, 1 is real time.
+         * @note Frame intervals handed to callbacks stay in real time.
+         */
+        void set_time_scale(float time_scale);
+        [[nodiscard]] float get_time_scale() const noexcept;
+
+        [[nodiscard]] const game_tick_stats& get_tick_stats() const noexcept;
+        void reset_tick_stats() noexcept;
+
+        /**
+         * @brief Choose how presenting waits on the display.
+         * @return Whether the renderer accepted the mode.
+         * @note Adaptive vsync falls back to regular vsync where the driver lacks it. Vsync is
+         *       on by default.
+         */
+        bool set_vsync(game_vsync vsync);
+        [[nodiscard]] game_vsync get_vsync() const noexcept;
+
+        /**
+         * @brief Cap the frame rate by waiting out the rest of each frame.
+         *
+         * The wait sleeps for most of the remaining time and spins only for the last stretch,
+         * so a capped game leaves the CPU idle instead of rendering frames nobody sees. Frames
+         * are paced against deadlines, so oversleeping one frame shortens the next.
+         *
+         * @param frame_rate Frames per second, 0 for no cap.
+         * @note Combined with vsync, the lower of the two rates wins.
+         */
+        void set_frame_rate_max(float frame_rate);
+        [[nodiscard]] float get_frame_rate_max() const noexcept;
+
+        [[nodiscard]] const game_frame_stats& get_frame_stats() const noexcept;
+        void reset_frame_stats() noexcept;
+
+        /**
+         * @brief Run fixed ticks on a simulation thread that overlaps with drawing.
+         *
+         * Each frame the game thread waits for the previous batch of ticks, handles input and
+         * runs the frame callbacks, then starts this frame's ticks and draws. Ticks end by
+         * writing the active scene's sprites and text into a triple-buffered render packet,
+         * which the game thread interpolates and draws while the next batch runs, so neither
+         * presenting nor vsync hold up the simulation. Drawing lags one batch behind.
+         *
+         * Tick callbacks run on the simulation thread. Input and frame callbacks run while it
+         * is idle and may touch anything. Draw callbacks run alongside the ticks, they must not
+         * touch entities and should only draw, the engine already drew the packet. Scenes and
+         * resources should only be changed from input and frame callbacks.
+         *
+         * @note Takes effect the next time `start_running` is called.
+         */
+        void set_simulation_threaded(bool is_threaded);
+        [[nodiscard]] bool is_simulation_threaded() const noexcept;
+
     private:
         /**
          * @brief Internal wrapper to initialize and shutdown SDL and related subsystems.
@@ -124,6 +280,16 @@ namespace engine {
             ~engine_wrapper();
         };
 
+        void frame_stats_update(float frame_interval) noexcept;
+
+        /**
+         * @brief Take the ticks due this frame out of the accumulator, after the clamp and cap.
+         */
+        [[nodiscard]] std::uint32_t tick_count_schedule(float& seconds_since_last_tick);
+        void ticks_run(std::uint32_t tick_count);
+        void frame_callbacks_run();
+        void simulation_batch_run(std::uint32_t tick_count, float fraction_to_next_tick);
+
     private:
         engine_wrapper m_wrapper;
 
@@ -136,14 +302,34 @@ namespace engine {
         void* m_state;
         game_engine_callbacks m_callbacks;
 
+        std::unique_ptr<game_jobs> m_jobs;
+        std::unique_ptr<game_asset_archive> m_archive;
         std::unique_ptr<game_window> m_window;
         std::unique_ptr<game_renderer> m_renderer;
         std::unique_ptr<game_input> m_input;
+        std::unique_ptr<game_resource_cache> m_resource_cache;  ///< Outlives the scenes using it.
+        std::unique_ptr<game_arena> m_frame_arena;
+        std::unique_ptr<game_arena> m_tick_arena;
         std::unique_ptr<game_scenes> m_scenes;
 
         float m_tick_interval_seconds;  ///< The amount of time (seconds) between each fixed update.
         float m_fraction_to_next_tick;  ///< Time elapsed towards next tick (0.0 to 1.0).
         float m_frame_interval_seconds;  /// The time spent between the last two frames in seconds.
+
+        std::uint32_t m_max_ticks_per_frame;
+        float m_tick_accumulator_max_seconds;
+        float m_time_scale;
+        game_tick_stats m_tick_stats;
+
+        std::uint64_t m_input_timestamp_ns;  ///< When input was last polled.
+        std::uint64_t m_tick_timestamp_ns;
+
+        game_vsync m_vsync;
+        float m_frame_interval_target_seconds;  ///< Minimum frame interval, 0 when uncapped.
+        game_frame_stats m_frame_stats;
+
+        bool m_is_simulation_threaded;
+        game_render_packets m_render_packets;  ///< Written by ticks, read by the draw stage.
     };
 
     template <class T>
@@ -168,6 +354,30 @@ namespace engine {
         return m_scenes.get();
     }
 
+    inline game_jobs* game_engine::get_jobs() noexcept {
+        return m_jobs.get();
+    }
+
+    inline game_resource_cache* game_engine::get_resource_cache() noexcept {
+        return m_resource_cache.get();
+    }
+
+    inline game_arena* game_engine::get_frame_arena() noexcept {
+        return m_frame_arena.get();
+    }
+
+    inline game_arena* game_engine::get_tick_arena() noexcept {
+        return m_tick_arena.get();
+    }
+
+    inline game_profiler* game_engine::get_profiler() noexcept {
+        return &game_profiler::get();
+    }
+
+    inline const game_asset_archive* game_engine::get_archive() const noexcept {
+        return (m_archive->is_open() == true) ? m_archive.get() : nullptr;
+    }
+
     inline float game_engine::get_tick_rate() noexcept {
         return ticks_rate_to_interval(m_tick_interval_seconds);
     }
@@ -187,4 +397,50 @@ namespace engine {
     inline float game_engine::get_frame_interval() const noexcept {
         return m_frame_interval_seconds;
     }
+
+    inline std::uint64_t game_engine::get_tick_timestamp() const noexcept {
+        return m_tick_timestamp_ns;
+    }
+
+    inline std::uint32_t game_engine::get_max_ticks_per_frame() const noexcept {
+        return m_max_ticks_per_frame;
+    }
+
+    inline float game_engine::get_tick_accumulator_max() const noexcept {
+        return m_tick_accumulator_max_seconds;
+    }
+
+    inline float game_engine::get_time_scale() const noexcept {
+        return m_time_scale;
+    }
+
+    inline const game_tick_stats& game_engine::get_tick_stats() const noexcept {
+        return m_tick_stats;
+    }
+
+    inline void game_engine::reset_tick_stats() noexcept {
+        m_tick_stats = {};
+    }
+
+    inline game_vsync game_engine::get_vsync() const noexcept {
+        return m_vsync;
+    }
+
+    inline float game_engine::get_frame_rate_max() const noexcept {
+        return (m_frame_interval_target_seconds > 0.f)
+                   ? ticks_interval_to_rate(m_frame_interval_target_seconds)
+                   : 0.f;
+    }
+
+    inline bool game_engine::is_simulation_threaded() const noexcept {
+        return m_is_simulation_threaded;
+    }
+
+    inline const game_frame_stats& game_engine::get_frame_stats() const noexcept {
+        return m_frame_stats;
+    }
+
+    inline void game_engine::reset_frame_stats() noexcept {
+        m_frame_stats = {};
+    }
 }  // namespace engine
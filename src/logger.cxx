@@ -0,0 +1,312 @@
+/**
+ * @file logger.cxx
+ * @brief Runtime log filtering and the asynchronous log queue.
+ */
+
+#include "logger.hxx"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <thread>
+
+namespace engine {
+    namespace {
+        /**
+         * @brief Messages the queue holds before dropping, a power of two.
+         */
+        constexpr std::size_t log_queue_capacity = 1024;
+        static_assert((log_queue_capacity & (log_queue_capacity - 1)) == 0);
+
+        constexpr std::uint8_t log_levels_all = 0b111;
+
+        std::atomic<std::uint8_t> log_levels_enabled = log_levels_all;
+
+        [[nodiscard]] constexpr std::uint8_t log_level_bit(const log_level level) noexcept {
+            return static_cast<std::uint8_t>(1u << static_cast<std::uint8_t>(level));
+        }
+
+        void log_message_output(const log_level level, const char* text) noexcept {
+            SDL_LogPriority priority = SDL_LOG_PRIORITY_INFO;
+            if (level == log_level::warning) {
+                priority = SDL_LOG_PRIORITY_WARN;
+            } else if (level == log_level::error) {
+                priority = SDL_LOG_PRIORITY_ERROR;
+            }
+
+            SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, priority, "%s", text);
+        }
+
+        /**
+         * @brief Bounded multi-producer, single-consumer queue of formatted messages.
+         *
+         * Every slot carries a sequence number, so producers claim positions with one
+         * compare-and-swap and never wait on each other or on the writer thread. A slot is
+         * free for position `p` when its sequence is `p`, and holds a message for the writer
+         * when it is `p + 1`.
+         */
+        class log_queue {
+        public:
+            log_queue();
+            ~log_queue();
+
+            log_queue(const log_queue&) = delete;
+            log_queue& operator=(const log_queue&) = delete;
+            log_queue(log_queue&&) = delete;
+            log_queue& operator=(log_queue&&) = delete;
+
+            /**
+             * @brief Queue a message, or count it as dropped if the queue is full.
+             */
+            void push(log_level level, std::string_view message) noexcept;
+            void flush() noexcept;
+
+            [[nodiscard]] std::uint64_t get_dropped() const noexcept;
+
+        private:
+            struct log_slot {
+                std::atomic<std::size_t> sequence;
+                log_level level;
+                std::uint16_t length;
+                char text[log_message_size_max + 1];
+            };
+
+            void writer_run();
+
+            /**
+             * @brief Write every message that is ready, in order.
+             * @return Whether any message was written.
+             */
+            bool messages_write();
+
+            void writer_wake() noexcept;
+
+        private:
+            std::unique_ptr<std::array<log_slot, log_queue_capacity>> m_slots;
+
+            alignas(64) std::atomic<std::size_t> m_enqueue_position;
+            alignas(64) std::size_t m_dequeue_position;  ///< Only touched by the writer.
+
+            std::atomic<std::size_t> m_written;  ///< Positions written, `flush` waits on it.
+            std::atomic<std::uint64_t> m_dropped;
+            std::uint64_t m_dropped_reported;
+
+            std::atomic<bool> m_is_writer_waiting;
+            std::atomic<std::uint32_t> m_wake;  ///< Bumped to wake a waiting writer.
+            std::atomic<bool> m_is_stopping;
+
+            std::thread m_writer;
+        };
+
+        /**
+         * @brief Set once the queue is destroyed, later messages are written synchronously.
+         */
+        std::atomic<bool> log_queue_is_destroyed = false;
+
+        log_queue::log_queue()
+            : m_slots(std::make_unique<std::array<log_slot, log_queue_capacity>>()),
+              m_enqueue_position(0),
+              m_dequeue_position(0),
+              m_written(0),
+              m_dropped(0),
+              m_dropped_reported(0),
+              m_is_writer_waiting(false),
+              m_wake(0),
+              m_is_stopping(false),
+              m_writer() {
+            for (std::size_t i = 0; i < log_queue_capacity; ++i) {
+                (*m_slots)[i].sequence.store(i, std::memory_order_relaxed);
+            }
+
+            m_writer = std::thread([this]() { writer_run(); });
+        }
+
+        log_queue::~log_queue() {
+            m_is_stopping.store(true);
+            writer_wake();
+            m_writer.join();
+
+            log_queue_is_destroyed.store(true);
+        }
+
+        void log_queue::push(const log_level level, std::string_view message) noexcept {
+            std::size_t position = m_enqueue_position.load(std::memory_order_relaxed);
+            log_slot* slot = nullptr;
+
+            while (true) {
+                slot = &(*m_slots)[position & (log_queue_capacity - 1)];
+                const std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+
+                if (sequence == position) {
+                    if (m_enqueue_position.compare_exchange_weak(position, position + 1,
+                                                                 std::memory_order_relaxed) ==
+                        true) {
+                        break;
+                    }
+                } else if (sequence < position) {
+                    // The writer is a whole queue behind, drop rather than stall the caller.
+                    m_dropped.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                } else {
+                    position = m_enqueue_position.load(std::memory_order_relaxed);
+                }
+            }
+
+            const std::size_t length = std::min(message.size(), log_message_size_max);
+            std::memcpy(slot->text, message.data(), length);
+            slot->text[length] = '\0';
+            slot->level = level;
+            slot->length = static_cast<std::uint16_t>(length);
+            slot->sequence.store(position + 1, std::memory_order_release);
+
+            // Pairs with the fence in `writer_run`, either the writer sees this message or this
+            // thread sees that it waits.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            writer_wake();
+        }
+
+        void log_queue::flush() noexcept {
+            const std::size_t target = m_enqueue_position.load();
+
+            m_wake.fetch_add(1);
+            m_wake.notify_one();
+
+            std::size_t written = m_written.load();
+            while (written < target) {
+                m_written.wait(written);
+                written = m_written.load();
+            }
+        }
+
+        std::uint64_t log_queue::get_dropped() const noexcept {
+            return m_dropped.load(std::memory_order_relaxed);
+        }
+
+        void log_queue::writer_run() {
+            while (true) {
+                if (messages_write() == true) {
+                    continue;
+                }
+
+                if (m_is_stopping.load() == true) {
+                    break;
+                }
+
+                // Read the wake counter before announcing the wait, so a message pushed after
+                // the check below changes it and the wait returns right away.
+                const std::uint32_t wake = m_wake.load();
+                m_is_writer_waiting.store(true);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                const log_slot& next = (*m_slots)[m_dequeue_position & (log_queue_capacity - 1)];
+                if (next.sequence.load(std::memory_order_acquire) != m_dequeue_position + 1 &&
+                    m_is_stopping.load() == false) {
+                    m_wake.wait(wake);
+                }
+
+                m_is_writer_waiting.store(false);
+            }
+
+            messages_write();
+        }
+
+        bool log_queue::messages_write() {
+            bool has_written = false;
+
+            while (true) {
+                log_slot& slot = (*m_slots)[m_dequeue_position & (log_queue_capacity - 1)];
+                if (slot.sequence.load(std::memory_order_acquire) != m_dequeue_position + 1) {
+                    break;
+                }
+
+                log_message_output(slot.level, slot.text);
+
+                slot.sequence.store(m_dequeue_position + log_queue_capacity,
+                                    std::memory_order_release);
+                m_dequeue_position++;
+                has_written = true;
+            }
+
+            const std::uint64_t dropped = m_dropped.load(std::memory_order_relaxed);
+            if (dropped != m_dropped_reported) {
+                char message[log_message_size_max];
+                const log_message_iterator end =
+                    std::format_to(log_message_iterator{message, message + sizeof(message) - 1},
+                                   "Dropped {} log messages, the log queue was full.",
+                                   dropped - m_dropped_reported);
+                *end.position = '\0';
+
+                log_message_output(log_level::warning, message);
+                m_dropped_reported = dropped;
+            }
+
+            if (has_written == true) {
+                m_written.store(m_dequeue_position);
+                m_written.notify_all();
+            }
+
+            return has_written;
+        }
+
+        void log_queue::writer_wake() noexcept {
+            if (m_is_writer_waiting.load() == true || m_is_stopping.load() == true) {
+                m_wake.fetch_add(1);
+                m_wake.notify_one();
+            }
+        }
+
+        log_queue& log_queue_get() {
+            static log_queue queue;
+            return queue;
+        }
+    }  // namespace
+
+    void log_level_set_enabled(const log_level level, const bool is_enabled) noexcept {
+        if (is_enabled == true) {
+            log_levels_enabled.fetch_or(log_level_bit(level), std::memory_order_relaxed);
+        } else {
+            log_levels_enabled.fetch_and(static_cast<std::uint8_t>(~log_level_bit(level)),
+                                         std::memory_order_relaxed);
+        }
+    }
+
+    bool log_level_is_enabled(const log_level level) noexcept {
+        return (log_levels_enabled.load(std::memory_order_relaxed) & log_level_bit(level)) != 0;
+    }
+
+    void log_write(const log_level level, std::string_view message) noexcept {
+        if constexpr (should_log_async) {
+            if (log_queue_is_destroyed.load() == false) {
+                log_queue_get().push(level, message);
+                return;
+            }
+        }
+
+        char text[log_message_size_max + 1];
+        const std::size_t length = std::min(message.size(), log_message_size_max);
+        std::memcpy(text, message.data(), length);
+        text[length] = '\0';
+
+        log_message_output(level, text);
+    }
+
+    void log_flush() noexcept {
+        if constexpr (should_log_async) {
+            if (log_queue_is_destroyed.load() == false) {
+                log_queue_get().flush();
+            }
+        }
+    }
+
+    std::uint64_t log_get_dropped() noexcept {
+        if constexpr (should_log_async) {
+            if (log_queue_is_destroyed.load() == false) {
+                return log_queue_get().get_dropped();
+            }
+        }
+
+        return 0;
+    }
+}  // namespace engine
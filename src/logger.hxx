@@ -2,34 +2,125 @@
  * @file logger.hxx
  * @brief Logging utilities for the game engine.
  *
- * This file provides various wrappers around SDL's logging functions with two major featuress
+ * This file provides various wrappers around SDL's logging functions with three major features
  * added.
  *
  * First, these functions use C++20's `std::format` for type-safe, modern string formatting
  * instead of SDL's C-style `printf` formatting.
  *
  * Second, depending on your CMake configuration, logging at different levels can be completely
- * avoided from the binary to eliminate any runtime overhead when logging is not needed.
+ * avoided from the binary to eliminate any runtime overhead when logging is not needed. Levels
+ * that are compiled in can still be turned off at runtime with `log_level_set_enabled`.
+ *
+ * Third, with `ENGINE_LOG_ASYNC` the calling thread only formats the message into a stack
+ * buffer and pushes it into a lock-free queue, a background thread writes it with SDL. Logging
+ * never allocates or waits on the console, and is safe from any thread. When the queue is full
+ * messages are dropped and counted instead of blocking the caller.
  */
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <format>
+#include <iterator>
+#include <string_view>
 #include <SDL3/SDL.h>
 #include "config.hxx"
 
 namespace engine {
+    enum class log_level : std::uint8_t { info, warning, error };
+
+    /**
+     * @brief Longest message kept, longer ones are truncated.
+     */
+    inline constexpr std::size_t log_message_size_max = 512;
+
+    /**
+     * @brief Output iterator for `std::vformat_to` that drops what does not fit in a buffer.
+     */
+    struct log_message_iterator {
+        using iterator_category = std::output_iterator_tag;
+        using value_type = void;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = void;
+
+        char* position;
+        char* end;
+
+        log_message_iterator& operator*() noexcept;
+        log_message_iterator& operator=(char character) noexcept;
+        log_message_iterator& operator++() noexcept;
+        log_message_iterator& operator++(int) noexcept;
+    };
+
+    inline log_message_iterator& log_message_iterator::operator*() noexcept {
+        return *this;
+    }
+
+    inline log_message_iterator& log_message_iterator::operator=(const char character) noexcept {
+        if (position != end) {
+            *position++ = character;
+        }
+
+        return *this;
+    }
+
+    inline log_message_iterator& log_message_iterator::operator++() noexcept {
+        return *this;
+    }
+
     /**
-     * @brief Log a formatted message to the standard output with SDL_Log.
+     * @note Returns itself rather than a copy, so `*it++ = c` advances the same position.
+     */
+    inline log_message_iterator& log_message_iterator::operator++(int) noexcept {
+        return *this;
+    }
+
+    /**
+     * @brief Turn a compiled-in log level on or off at runtime, every level starts on.
+     * @note Levels disabled by their `ENGINE_LOG_*` option stay compiled out regardless.
+     */
+    void log_level_set_enabled(log_level level, bool is_enabled) noexcept;
+    [[nodiscard]] bool log_level_is_enabled(log_level level) noexcept;
+
+    /**
+     * @brief Write an already formatted message, queued when `ENGINE_LOG_ASYNC` is ON.
+     */
+    void log_write(log_level level, std::string_view message) noexcept;
+
+    /**
+     * @brief Block until every message queued so far has been written.
+     * @note Does nothing when `ENGINE_LOG_ASYNC` is OFF, messages are written right away.
+     */
+    void log_flush() noexcept;
+
+    /**
+     * @brief Get the number of messages dropped because the queue was full.
+     */
+    [[nodiscard]] std::uint64_t log_get_dropped() noexcept;
+
+    /**
+     * @brief Log a formatted message through SDL's log at the given level.
+     * @param level The level to log at, skipped if it is disabled at runtime.
      * @param fmt The format string.
      * @param args The arguments to format into the string.
      * @note Prefer using `log_info`, `log_warning`, or `log_error` for level-specific logging.
      */
     template <class... Args>
-    void log_formatted(std::string_view fmt, Args... args) {
+    void log_formatted(const log_level level, std::string_view fmt, Args... args) {
         if constexpr (should_log_info || should_log_warnings || should_log_errors) {
-            std::string message = std::vformat(fmt, std::make_format_args(args...));
-            SDL_Log("%s", message.c_str());
+            if (log_level_is_enabled(level) == false) {
+                return;
+            }
+
+            char message[log_message_size_max];
+            const log_message_iterator end = std::vformat_to(
+                log_message_iterator{message, message + log_message_size_max}, fmt,
+                std::make_format_args(args...));
+
+            log_write(level, {message, static_cast<std::size_t>(end.position - message)});
         }
     }
 
@@ -42,7 +133,7 @@ namespace engine {
     template <class... Args>
     void log_info(std::string_view fmt, Args... args) {
         if constexpr (should_log_info) {
-            log_formatted(fmt, args...);
+            log_formatted(log_level::info, fmt, args...);
         }
     }
 
@@ -55,7 +146,7 @@ namespace engine {
     template <class... Args>
     void log_warning(std::string_view fmt, Args... args) {
         if constexpr (should_log_warnings) {
-            log_formatted(fmt, args...);
+            log_formatted(log_level::warning, fmt, args...);
         }
     }
 
@@ -68,7 +159,7 @@ namespace engine {
     template <class... Args>
     void log_error(std::string_view fmt, Args... args) {
         if constexpr (should_log_errors) {
-            log_formatted(fmt, args...);
+            log_formatted(log_level::error, fmt, args...);
         }
     }
 }  // namespace engine
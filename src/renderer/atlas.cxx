@@ -0,0 +1,128 @@
+/**
+ * @file atlas.cxx
+ * @brief Skyline rectangle packer and atlas page implementation.
+ */
+
+#include "atlas.hxx"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <SDL3/SDL.h>
+
+namespace engine {
+    SDL_Texture* atlas_page_texture_create(SDL_Renderer* sdl_renderer, const int size) {
+        SDL_Texture* texture = SDL_CreateTexture(sdl_renderer, SDL_PIXELFORMAT_RGBA32,
+                                                 SDL_TEXTUREACCESS_STATIC, size, size);
+        if (texture == nullptr) {
+            return nullptr;
+        }
+
+        // Static texture contents start undefined, the padding has to be transparent.
+        const std::vector<std::uint32_t> transparent(static_cast<std::size_t>(size) * size, 0);
+        SDL_UpdateTexture(texture, nullptr, transparent.data(),
+                          size * static_cast<int>(sizeof(std::uint32_t)));
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+        return texture;
+    }
+
+    game_atlas_packer::game_atlas_packer(const glm::ivec2& size)
+        : m_size(size), m_skyline(), m_used_area(0) {
+        reset();
+    }
+
+    void game_atlas_packer::reset() {
+        m_skyline.clear();
+        m_skyline.push_back({0, 0, m_size.x});
+        m_used_area = 0;
+    }
+
+    std::optional<glm::ivec2> game_atlas_packer::insert(const glm::ivec2& size) {
+        if (size.x <= 0 || size.y <= 0 || size.x > m_size.x || size.y > m_size.y) {
+            return std::nullopt;
+        }
+
+        // Pick the segment where the rectangle's top is lowest, the narrower segment on ties.
+        std::size_t best_index = m_skyline.size();
+        int best_top = std::numeric_limits<int>::max();
+        int best_width = std::numeric_limits<int>::max();
+
+        for (std::size_t i = 0; i < m_skyline.size(); ++i) {
+            const std::optional<int> y = fit(i, size);
+            if (y.has_value() == false) {
+                continue;
+            }
+
+            const int top = *y + size.y;
+            if (top < best_top || (top == best_top && m_skyline[i].width < best_width)) {
+                best_index = i;
+                best_top = top;
+                best_width = m_skyline[i].width;
+            }
+        }
+
+        if (best_index == m_skyline.size()) {
+            return std::nullopt;
+        }
+
+        const glm::ivec2 position = {m_skyline[best_index].x, best_top - size.y};
+
+        // The new segment covers the rectangle's top, shrink or drop the ones it shadows.
+        m_skyline.insert(m_skyline.begin() + static_cast<std::ptrdiff_t>(best_index),
+                         {position.x, best_top, size.x});
+
+        const int right = position.x + size.x;
+        std::size_t i = best_index + 1;
+        while (i < m_skyline.size() && m_skyline[i].x < right) {
+            const int shrink = right - m_skyline[i].x;
+            if (m_skyline[i].width <= shrink) {
+                m_skyline.erase(m_skyline.begin() + static_cast<std::ptrdiff_t>(i));
+                continue;
+            }
+
+            m_skyline[i].x += shrink;
+            m_skyline[i].width -= shrink;
+            break;
+        }
+
+        // Merge neighbours at the same height so the segment count stays small.
+        for (std::size_t j = 0; j + 1 < m_skyline.size();) {
+            if (m_skyline[j].y == m_skyline[j + 1].y) {
+                m_skyline[j].width += m_skyline[j + 1].width;
+                m_skyline.erase(m_skyline.begin() + static_cast<std::ptrdiff_t>(j + 1));
+            } else {
+                ++j;
+            }
+        }
+
+        m_used_area += static_cast<long long>(size.x) * size.y;
+
+        return position;
+    }
+
+    std::optional<int> game_atlas_packer::fit(const std::size_t segment_index,
+                                              const glm::ivec2& size) const {
+        const int x = m_skyline[segment_index].x;
+        if (x + size.x > m_size.x) {
+            return std::nullopt;
+        }
+
+        // Rest on the highest segment under the rectangle's width.
+        int y = 0;
+        int width_left = size.x;
+        for (std::size_t i = segment_index; width_left > 0; ++i) {
+            y = std::max(y, m_skyline[i].y);
+            if (y + size.y > m_size.y) {
+                return std::nullopt;
+            }
+
+            width_left -= m_skyline[i].width;
+        }
+
+        return y;
+    }
+}  // namespace engine
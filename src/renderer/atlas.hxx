@@ -0,0 +1,88 @@
+/**
+ * @file atlas.hxx
+ * @brief Skyline rectangle packer and page textures used to build texture atlases.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+struct SDL_Renderer;
+struct SDL_Texture;
+
+namespace engine {
+    /**
+     * @brief Create a square, blended and fully transparent texture to pack an atlas page into.
+     * @return The page texture, or nullptr if SDL failed to create it.
+     */
+    [[nodiscard]] SDL_Texture* atlas_page_texture_create(SDL_Renderer* sdl_renderer, int size);
+
+    /**
+     * @brief Packs rectangles into a fixed size page with the skyline bottom-left heuristic.
+     *
+     * The packer tracks the top edge of the placed rectangles as a list of horizontal segments,
+     * and places each new rectangle on the segment where its top ends up lowest. This keeps
+     * pages dense for the mostly similar sized sprites games load, at a cost linear in the
+     * number of segments per insert.
+     *
+     * @note Rectangles cannot be removed, reset the packer to reuse a page.
+     */
+    class game_atlas_packer {
+    public:
+        explicit game_atlas_packer(const glm::ivec2& size);
+        ~game_atlas_packer() = default;
+
+        game_atlas_packer(const game_atlas_packer&) = default;
+        game_atlas_packer& operator=(const game_atlas_packer&) = default;
+        game_atlas_packer(game_atlas_packer&&) noexcept = default;
+        game_atlas_packer& operator=(game_atlas_packer&&) noexcept = default;
+
+        /**
+         * @brief Find room for a rectangle and reserve it.
+         * @param size Size of the rectangle in pixels, including any padding the caller wants.
+         * @return Top-left corner of the reserved area, or nothing if the page is full.
+         */
+        [[nodiscard]] std::optional<glm::ivec2> insert(const glm::ivec2& size);
+
+        void reset();
+
+        [[nodiscard]] glm::ivec2 get_size() const noexcept;
+
+        /**
+         * @brief Get the share of the page covered by inserted rectangles, in [0, 1].
+         */
+        [[nodiscard]] float get_occupancy() const noexcept;
+
+    private:
+        struct skyline_segment {
+            int x;
+            int y;
+            int width;
+        };
+
+        /**
+         * @brief Get the height a rectangle would rest at when its left edge is on a segment.
+         * @return The resting height, or nothing if the rectangle would leave the page there.
+         */
+        [[nodiscard]] std::optional<int> fit(std::size_t segment_index,
+                                             const glm::ivec2& size) const;
+
+    private:
+        glm::ivec2 m_size;
+        std::vector<skyline_segment> m_skyline;
+        long long m_used_area;
+    };
+
+    inline glm::ivec2 game_atlas_packer::get_size() const noexcept {
+        return m_size;
+    }
+
+    inline float game_atlas_packer::get_occupancy() const noexcept {
+        const auto area = static_cast<long long>(m_size.x) * m_size.y;
+        return area > 0 ? static_cast<float>(m_used_area) / static_cast<float>(area) : 0.f;
+    }
+}  // namespace engine
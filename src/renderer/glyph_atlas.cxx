@@ -0,0 +1,136 @@
+/**
+ * @file glyph_atlas.cxx
+ * @brief Glyph cache implementation.
+ */
+
+#include "glyph_atlas.hxx"
+
+#include <algorithm>
+
+#include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+
+#include "../logger.hxx"
+#include "../safety.hxx"
+
+namespace engine {
+    game_glyph_atlas::game_glyph_atlas(SDL_Renderer* sdl_renderer, TTF_Font* font)
+        : m_sdl_renderer(sdl_renderer), m_font(font), m_pages(), m_glyphs() {
+        paranoid_ensure(m_sdl_renderer != nullptr, "SDL_Renderer pointer cannot be null");
+        paranoid_ensure(m_font != nullptr, "TTF_Font pointer cannot be null");
+    }
+
+    game_glyph_atlas::~game_glyph_atlas() {
+        for (glyph_page& page : m_pages) {
+            SDL_DestroyTexture(page.texture);
+        }
+    }
+
+    const game_glyph& game_glyph_atlas::glyph_get_or_create(const std::uint32_t codepoint) {
+        if (auto it = m_glyphs.find(codepoint); it != m_glyphs.end()) {
+            return it->second;
+        }
+
+        return m_glyphs.try_emplace(codepoint, glyph_rasterize(codepoint)).first->second;
+    }
+
+    float game_glyph_atlas::get_kerning(const std::uint32_t previous,
+                                        const std::uint32_t codepoint) const {
+        int kerning = 0;
+        if (TTF_GetGlyphKerning(m_font, previous, codepoint, &kerning) == false) {
+            return 0.f;
+        }
+
+        return static_cast<float>(kerning);
+    }
+
+    float game_glyph_atlas::get_line_skip() const {
+        return static_cast<float>(TTF_GetFontLineSkip(m_font));
+    }
+
+    float game_glyph_atlas::get_height() const {
+        return static_cast<float>(TTF_GetFontHeight(m_font));
+    }
+
+    game_glyph game_glyph_atlas::glyph_rasterize(const std::uint32_t codepoint) {
+        game_glyph glyph;
+
+        int min_x = 0, max_x = 0, min_y = 0, max_y = 0, advance = 0;
+        if (TTF_GetGlyphMetrics(m_font, codepoint, &min_x, &max_x, &min_y, &max_y, &advance) ==
+            false) {
+            return glyph;
+        }
+
+        glyph.advance = static_cast<float>(advance);
+
+        // Whitespace only moves the pen.
+        if (max_x <= min_x || max_y <= min_y) {
+            return glyph;
+        }
+
+        // Rendered white, the text color is applied through vertex colors.
+        SDL_Surface* rendered = TTF_RenderGlyph_Blended(m_font, codepoint, {255, 255, 255, 255});
+        if (rendered == nullptr) {
+            return glyph;
+        }
+
+        SDL_Surface* surface = SDL_ConvertSurface(rendered, SDL_PIXELFORMAT_RGBA32);
+        SDL_DestroySurface(rendered);
+        if (surface == nullptr) {
+            return glyph;
+        }
+
+        // The cell spans the font's full height, so glyphs line up without per-glyph bearings.
+        const glm::ivec2 size = {surface->w, surface->h};
+        const glm::ivec2 reserved = size + page_padding;
+        if (reserved.x > page_size || reserved.y > page_size) {
+            log_warning("Glyph {} does not fit a glyph atlas page, skipping it", codepoint);
+            SDL_DestroySurface(surface);
+            return glyph;
+        }
+
+        std::optional<glm::ivec2> position;
+        glyph_page* page = nullptr;
+        for (glyph_page& candidate : m_pages) {
+            if (position = candidate.packer.insert(reserved); position.has_value() == true) {
+                page = &candidate;
+                break;
+            }
+        }
+
+        if (page == nullptr) {
+            page = &page_create();
+            position = page->packer.insert(reserved);
+            paranoid_ensure(position.has_value() == true, "An empty glyph page must fit a glyph");
+        }
+
+        const SDL_Rect rect = {position->x, position->y, size.x, size.y};
+        SDL_UpdateTexture(page->texture, &rect, surface->pixels, surface->pitch);
+        SDL_DestroySurface(surface);
+
+        const float page_extent = static_cast<float>(page_size);
+        glyph.texture = page->texture;
+        glyph.uv = {static_cast<float>(position->x) / page_extent,
+                    static_cast<float>(position->y) / page_extent,
+                    static_cast<float>(position->x + size.x) / page_extent,
+                    static_cast<float>(position->y + size.y) / page_extent};
+        glyph.size = glm::vec2(size);
+
+        // Single glyph renders start left of the pen when the glyph overhangs it.
+        glyph.offset_x = static_cast<float>(std::min(0, min_x));
+
+        return glyph;
+    }
+
+    game_glyph_atlas::glyph_page& game_glyph_atlas::page_create() {
+        SDL_Texture* texture = atlas_page_texture_create(m_sdl_renderer, page_size);
+        if (texture == nullptr) {
+            throw error_message("Failed to create a glyph atlas page: {}", SDL_GetError());
+        }
+
+        m_pages.push_back({texture, game_atlas_packer({page_size, page_size})});
+        log_info("Created glyph atlas page {} ({}x{})", m_pages.size() - 1, page_size, page_size);
+
+        return m_pages.back();
+    }
+}  // namespace engine
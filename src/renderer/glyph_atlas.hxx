@@ -0,0 +1,112 @@
+/**
+ * @file glyph_atlas.hxx
+ * @brief Cache of rasterized glyphs for one font and size, packed into shared texture pages.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "atlas.hxx"
+
+struct TTF_Font;
+struct SDL_Renderer;
+struct SDL_Texture;
+
+namespace engine {
+    /**
+     * @brief A rasterized glyph and where to find it.
+     */
+    struct game_glyph {
+        SDL_Texture* texture = nullptr;       ///< Atlas page, nullptr for glyphs without pixels.
+        glm::vec4 uv = {0.f, 0.f, 0.f, 0.f};  ///< Source rect on the page as (u0, v0, u1, v1).
+        glm::vec2 size = {0.f, 0.f};          ///< Size of the rasterized cell in pixels.
+        float offset_x = 0.f;                 ///< Cell's left edge relative to the pen position.
+        float advance = 0.f;                  ///< How far the pen moves after this glyph.
+    };
+
+    /**
+     * @brief Rasterizes glyphs of a single font on first use and keeps them on atlas pages.
+     *
+     * Glyphs are rendered white so one cached copy serves every text color, which the renderer
+     * applies through vertex colors instead. Changing the content of a text that uses the atlas
+     * therefore only rebuilds its quads, no texture is created or uploaded unless the new text
+     * contains a glyph that was never drawn before.
+     *
+     * @note The atlas does not own the font, which has to outlive it.
+     */
+    class game_glyph_atlas {
+    public:
+        using uptr = std::unique_ptr<game_glyph_atlas>;
+
+        /**
+         * @brief Width and height of every page in pixels, enough for the ASCII range of most
+         * fonts at common sizes.
+         */
+        static constexpr int page_size = 512;
+
+        /**
+         * @brief Transparent gap kept between glyphs so filtering does not bleed.
+         */
+        static constexpr int page_padding = 1;
+
+    public:
+        game_glyph_atlas(SDL_Renderer* sdl_renderer, TTF_Font* font);
+        ~game_glyph_atlas();
+
+        game_glyph_atlas(const game_glyph_atlas&) = delete;
+        game_glyph_atlas& operator=(const game_glyph_atlas&) = delete;
+        game_glyph_atlas(game_glyph_atlas&&) = delete;
+        game_glyph_atlas& operator=(game_glyph_atlas&&) = delete;
+
+        /**
+         * @brief Get a glyph, rasterizing and packing it the first time it is requested.
+         * @param codepoint Unicode codepoint of the glyph.
+         * @return The glyph, with a null texture if the font has no pixels for it.
+         */
+        const game_glyph& glyph_get_or_create(std::uint32_t codepoint);
+
+        /**
+         * @brief Get the kerning adjustment between two consecutive glyphs in pixels.
+         */
+        [[nodiscard]] float get_kerning(std::uint32_t previous, std::uint32_t codepoint) const;
+
+        [[nodiscard]] float get_line_skip() const;
+
+        /**
+         * @brief Get the height of a glyph cell, the font's full height in pixels.
+         */
+        [[nodiscard]] float get_height() const;
+        [[nodiscard]] std::size_t get_page_count() const;
+        [[nodiscard]] std::size_t get_glyph_count() const;
+
+    private:
+        struct glyph_page {
+            SDL_Texture* texture;
+            game_atlas_packer packer;
+        };
+
+        [[nodiscard]] game_glyph glyph_rasterize(std::uint32_t codepoint);
+        glyph_page& page_create();
+
+    private:
+        SDL_Renderer* m_sdl_renderer;
+        TTF_Font* m_font;
+
+        std::vector<glyph_page> m_pages;
+        std::unordered_map<std::uint32_t, game_glyph> m_glyphs;
+    };
+
+    inline std::size_t game_glyph_atlas::get_page_count() const {
+        return m_pages.size();
+    }
+
+    inline std::size_t game_glyph_atlas::get_glyph_count() const {
+        return m_glyphs.size();
+    }
+}  // namespace engine
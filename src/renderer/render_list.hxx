@@ -0,0 +1,93 @@
+/**
+ * @file render_list.hxx
+ * @brief Resolved world space draws of a frame, replayed by every render pass.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "sprite.hxx"
+#include "text.hxx"
+
+namespace engine {
+    /**
+     * @brief A sprite to draw this frame, already interpolated.
+     * @note Rotation, scale and source rect are stored per draw, the sprite itself is shared by
+     * entities.
+     */
+    struct game_render_list_sprite {
+        const game_sprite* sprite = nullptr;
+        glm::vec2 position = {0.f, 0.f};
+        float rotation = 0.f;
+        glm::vec2 scale = {1.f, 1.f};
+        glm::vec4 uv = {0.f, 0.f, 1.f, 1.f};  ///< Part of the sprite's texture, such as a frame.
+        int layer = 0;
+    };
+
+    struct game_render_list_text {
+        const game_text_dynamic* text = nullptr;
+        glm::vec2 position = {0.f, 0.f};
+        float rotation = 0.f;
+        glm::vec2 scale = {1.f, 1.f};
+        int layer = 0;
+    };
+
+    /**
+     * @brief How particles look over their life, blended from start to end by the fraction of
+     *        their lifetime that has passed.
+     */
+    struct game_particle_appearance {
+        float scale_start = 1.f;  ///< Multiplies the sprite's size.
+        float scale_end = 1.f;
+        glm::vec4 color_start = {1.f, 1.f, 1.f, 1.f};
+        glm::vec4 color_end = {1.f, 1.f, 1.f, 0.f};
+    };
+
+    /**
+     * @brief Every live particle of one emitter, as structure of arrays the renderer reads.
+     *
+     * The arrays belong to the emitter's pool or a render packet and must stay unchanged until
+     * the list is drawn. Positions are blended from the previous tick's by `fraction`.
+     */
+    struct game_render_list_particles {
+        const game_sprite* sprite = nullptr;
+        const float* position_x = nullptr;
+        const float* position_y = nullptr;
+        const float* previous_x = nullptr;
+        const float* previous_y = nullptr;
+        const float* remaining = nullptr;  ///< Seconds each particle has left.
+        const float* lifetime = nullptr;   ///< Seconds each particle lived for in total.
+        std::size_t count = 0;
+        float fraction = 0.f;
+        game_particle_appearance appearance;
+        int layer = 0;
+    };
+
+    /**
+     * @brief Everything the renderer systems collected from the registry for one frame.
+     *
+     * Collecting once and drawing the list per render pass keeps split-screen from walking the
+     * registry and resolving resources once per viewport. Each pass culls and transforms the
+     * entries against its own camera.
+     */
+    struct game_render_list {
+        std::vector<game_render_list_sprite> sprites;
+        std::vector<game_render_list_text> texts;
+        std::vector<game_render_list_particles> particles;
+
+        /**
+         * @brief Empty the list, keeping its memory for the next frame.
+         */
+        void clear() noexcept;
+    };
+
+    inline void game_render_list::clear() noexcept {
+        sprites.clear();
+        texts.clear();
+        particles.clear();
+    }
+}  // namespace engine
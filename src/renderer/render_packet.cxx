@@ -0,0 +1,37 @@
+/**
+ * @file render_packet.cxx
+ * @brief Render packet triple buffer implementation.
+ */
+
+#include "render_packet.hxx"
+
+namespace engine {
+    game_render_packets::game_render_packets()
+        : m_packets(), m_write_index(0), m_read_index(1), m_middle(2), m_sequence(0) {
+    }
+
+    game_render_packet& game_render_packets::write_begin() noexcept {
+        game_render_packet& packet = m_packets[m_write_index];
+        packet.clear();
+        return packet;
+    }
+
+    void game_render_packets::write_publish() noexcept {
+        m_packets[m_write_index].sequence = ++m_sequence;
+
+        // Release makes the filled packet visible to the reader that takes it next.
+        const std::uint8_t previous = m_middle.exchange(m_write_index | fresh_bit,
+                                                        std::memory_order_acq_rel);
+        m_write_index = previous & index_mask;
+    }
+
+    const game_render_packet& game_render_packets::read_latest() noexcept {
+        if ((m_middle.load(std::memory_order_relaxed) & fresh_bit) != 0) {
+            const std::uint8_t previous =
+                m_middle.exchange(m_read_index, std::memory_order_acq_rel);
+            m_read_index = previous & index_mask;
+        }
+
+        return m_packets[m_read_index];
+    }
+}  // namespace engine
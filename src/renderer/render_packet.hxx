@@ -0,0 +1,141 @@
+/**
+ * @file render_packet.hxx
+ * @brief Snapshot of a scene's renderable state, handed from the simulation to the renderer.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "render_list.hxx"
+#include "sprite.hxx"
+#include "text.hxx"
+
+namespace engine {
+    /**
+     * @brief A sprite as it was at the last two ticks, interpolated when drawn.
+     */
+    struct game_render_packet_sprite {
+        game_sprite::handle sprite;
+        glm::vec2 position_previous = {0.f, 0.f};
+        glm::vec2 position = {0.f, 0.f};
+        float rotation_previous = 0.f;
+        float rotation = 0.f;
+        glm::vec2 scale = {1.f, 1.f};
+        glm::vec4 uv = {0.f, 0.f, 1.f, 1.f};  ///< Animation frame or the sprite's own rect.
+        int layer = 0;
+    };
+
+    /**
+     * @brief A dynamic text as it was at the last two ticks, interpolated when drawn.
+     */
+    struct game_render_packet_text {
+        game_text_dynamic::handle text;
+        glm::vec2 position_previous = {0.f, 0.f};
+        glm::vec2 position = {0.f, 0.f};
+        float rotation = 0.f;
+        glm::vec2 scale = {1.f, 1.f};
+        int layer = 0;
+    };
+
+    /**
+     * @brief The live particles of one emitter, copied into the packet's particle data.
+     *
+     * The data holds `count` floats per field from `first`, in the order position x and y,
+     * previous x and y, remaining and lifetime.
+     */
+    struct game_render_packet_particles {
+        static constexpr std::size_t field_count = 6;
+
+        game_sprite::handle sprite;
+        std::size_t first = 0;
+        std::size_t count = 0;
+        game_particle_appearance appearance;
+        int layer = 0;
+    };
+
+    /**
+     * @brief Everything the renderer needs to draw a scene's entities without its registry.
+     *
+     * Entities without interpolation store the same previous and current values. Handles are
+     * resolved against the resources of the scene `scene_id` names when drawing.
+     */
+    struct game_render_packet {
+        std::uint64_t scene_id = 0;         ///< `game_scene::get_id` of its scene, zero for none.
+        std::uint64_t sequence = 0;         ///< Increases with every published packet.
+        float fraction_to_next_tick = 0.f;  ///< Interpolation factor for this packet's ticks.
+
+        std::vector<game_render_packet_sprite> sprites;
+        std::vector<game_render_packet_text> texts;
+        std::vector<game_render_packet_particles> particles;
+        std::vector<float> particle_data;  ///< Arrays of every entry in `particles`.
+
+        /**
+         * @brief Empty the packet, keeping its memory for the next write.
+         */
+        void clear() noexcept;
+    };
+
+    /**
+     * @brief Lock-free triple buffer of render packets between one writer and one reader.
+     *
+     * The writer fills its own packet and publishes it by swapping it with the shared middle
+     * one, the reader swaps the middle one for its own whenever a newer packet was published.
+     * Neither side ever waits for the other, and the reader always gets the latest complete
+     * packet while older unread ones are recycled.
+     */
+    class game_render_packets {
+    public:
+        game_render_packets();
+
+        game_render_packets(const game_render_packets&) = delete;
+        game_render_packets& operator=(const game_render_packets&) = delete;
+        game_render_packets(game_render_packets&&) = delete;
+        game_render_packets& operator=(game_render_packets&&) = delete;
+
+        /**
+         * @brief Get the writer's packet, cleared and ready to fill.
+         */
+        [[nodiscard]] game_render_packet& write_begin() noexcept;
+
+        /**
+         * @brief Hand the packet from `write_begin` to the reader.
+         */
+        void write_publish() noexcept;
+
+        /**
+         * @brief Get the newest published packet.
+         * @note Stays valid and unchanged until the next call from the reading thread.
+         */
+        [[nodiscard]] const game_render_packet& read_latest() noexcept;
+
+    private:
+        /**
+         * @brief Set on the middle index when it holds a packet the reader has not taken yet.
+         */
+        static constexpr std::uint8_t fresh_bit = 0x4;
+        static constexpr std::uint8_t index_mask = 0x3;
+
+    private:
+        std::array<game_render_packet, 3> m_packets;
+        std::uint8_t m_write_index;
+        std::uint8_t m_read_index;
+        std::atomic<std::uint8_t> m_middle;
+        std::uint64_t m_sequence;
+    };
+
+    inline void game_render_packet::clear() noexcept {
+        scene_id = 0;
+        fraction_to_next_tick = 0.f;
+        sprites.clear();
+        texts.clear();
+        particles.clear();
+        particle_data.clear();
+    }
+}  // namespace engine
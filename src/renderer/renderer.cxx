@@ -4,17 +4,86 @@
 #include "viewport.hxx"
 
 #include "../logger.hxx"
+#include "../utils/timing.hxx"
 
 #include <SDL3_ttf/SDL_ttf.h>
 #include <SDL3/SDL.h>
+#include <algorithm>
+#include <cmath>
 #include <stdexcept>
+#include <utility>
 
 namespace engine {
+    namespace {
+        /**
+         * @brief Convert a sprite's normalized source rect to texture pixels for SDL.
+         */
+        SDL_FRect sprite_source_rect(const game_sprite& sprite) {
+            float w = 0.f;
+            float h = 0.f;
+            SDL_GetTextureSize(sprite.get_sdl_texture(), &w, &h);
+
+            const glm::vec4 uv = sprite.get_uv();
+            return {uv.x * w, uv.y * h, (uv.z - uv.x) * w, (uv.w - uv.y) * h};
+        }
+
+        /**
+         * @brief Get the counters accumulated between two snapshots of the frame's stats.
+         */
+        game_render_stats render_stats_difference(const game_render_stats& after,
+                                                  const game_render_stats& before) {
+            return {after.draw_calls - before.draw_calls, after.batches - before.batches,
+                    after.sprites_submitted - before.sprites_submitted,
+                    after.sprites_culled - before.sprites_culled,
+                    after.sprites_retained - before.sprites_retained,
+                    after.layers_redrawn - before.layers_redrawn,
+                    after.particles_submitted - before.particles_submitted};
+        }
+
+        /**
+         * @brief Queue one quad per glyph, all pivoting around the text's origin.
+         * @return The number of quads queued.
+         */
+        std::uint32_t text_glyphs_push(game_sprite_batch& batch, const game_text_dynamic& text,
+                                       const glm::vec2& screen_position,
+                                       const glm::vec2& final_scale, const float rotation,
+                                       const int layer) {
+            const game_color color = text.get_color();
+            const SDL_FColor tint = {color.r / 255.f, color.g / 255.f, color.b / 255.f,
+                                     color.a / 255.f};
+            const glm::vec2 origin = text.get_origin();
+
+            const std::vector<game_text_glyph>& glyphs = text.get_glyphs();
+            for (const game_text_glyph& glyph : glyphs) {
+                // Offsetting the pivot per glyph keeps the whole string rotating as one.
+                batch.push({.texture = glyph.texture,
+                            .position = screen_position,
+                            .size = glyph.size * final_scale,
+                            .origin = (origin - glyph.position) * final_scale,
+                            .rotation = rotation,
+                            .uv = glyph.uv,
+                            .color = tint,
+                            .layer = layer});
+            }
+
+            return static_cast<std::uint32_t>(glyphs.size());
+        }
+    }  // namespace
+
     game_renderer::game_renderer(SDL_Window* window)
         : m_sdl_renderer(nullptr),
           m_sdl_text_engine(nullptr),
           m_camera(nullptr),
-          m_viewport(nullptr) {
+          m_viewport(nullptr),
+          m_sprite_batch(),
+          m_text_batch(),
+          m_stats(),
+          m_view(),
+          m_is_view_dirty(true),
+          m_retained_layers(),
+          m_render_list(),
+          m_passes(),
+          m_pass_stats() {
         if (m_sdl_renderer = SDL_CreateRenderer(window, nullptr); m_sdl_renderer == nullptr) {
             TTF_Quit();
             SDL_Quit();
@@ -37,6 +106,10 @@ namespace engine {
     }
 
     game_renderer::~game_renderer() {
+        for (retained_layer& retained : m_retained_layers) {
+            retained_layer_textures_destroy(retained);
+        }
+
         if (m_sdl_text_engine != nullptr) {
             TTF_DestroyRendererTextEngine(m_sdl_text_engine);
             log_info("TTF text engine destroyed.");
@@ -52,7 +125,16 @@ namespace engine {
         : m_sdl_renderer(other.m_sdl_renderer),
           m_sdl_text_engine(other.m_sdl_text_engine),
           m_camera(other.m_camera),
-          m_viewport(other.m_viewport) {
+          m_viewport(other.m_viewport),
+          m_sprite_batch(std::move(other.m_sprite_batch)),
+          m_text_batch(std::move(other.m_text_batch)),
+          m_stats(other.m_stats),
+          m_view(other.m_view),
+          m_is_view_dirty(true),
+          m_retained_layers(std::move(other.m_retained_layers)),
+          m_render_list(std::move(other.m_render_list)),
+          m_passes(std::move(other.m_passes)),
+          m_pass_stats(std::move(other.m_pass_stats)) {
         other.m_sdl_renderer = nullptr;
         other.m_sdl_text_engine = nullptr;
         other.m_camera = nullptr;
@@ -62,6 +144,10 @@ namespace engine {
     game_renderer& game_renderer::operator=(game_renderer&& other) noexcept {
         if (this != &other) {
             // Clean up current resources
+            for (retained_layer& retained : m_retained_layers) {
+                retained_layer_textures_destroy(retained);
+            }
+
             if (m_sdl_text_engine) {
                 TTF_DestroyRendererTextEngine(m_sdl_text_engine);
             }
@@ -74,29 +160,53 @@ namespace engine {
             m_sdl_text_engine = other.m_sdl_text_engine;
             m_camera = other.m_camera;
             m_viewport = other.m_viewport;
+            m_sprite_batch = std::move(other.m_sprite_batch);
+            m_text_batch = std::move(other.m_text_batch);
+            m_stats = other.m_stats;
+            m_view = other.m_view;
+            m_is_view_dirty = true;
+            m_retained_layers = std::move(other.m_retained_layers);
+            m_render_list = std::move(other.m_render_list);
+            m_passes = std::move(other.m_passes);
+            m_pass_stats = std::move(other.m_pass_stats);
 
             // Reset other
             other.m_sdl_renderer = nullptr;
             other.m_sdl_text_engine = nullptr;
             other.m_camera = nullptr;
             other.m_viewport = nullptr;
+            other.m_retained_layers.clear();
         }
 
         return *this;
     }
 
     void game_renderer::draw_begin() {
+        m_stats = {};
+        m_sprite_batch.clear();
+
+        // Refresh the pixel rects of pass viewports, culling queries run before they draw.
+        for (const render_pass& pass : m_passes) {
+            if (pass.viewport != nullptr) {
+                pass.viewport->apply_to_sdl(*this);
+            }
+        }
+
         if (m_viewport != nullptr) {
             m_viewport->apply_to_sdl(*this);
         } else {
             SDL_SetRenderViewport(m_sdl_renderer, nullptr);
         }
 
+        // The viewport's pixel rect and the camera may have changed since the last frame.
+        m_is_view_dirty = true;
+
         SDL_SetRenderDrawColor(m_sdl_renderer, 0, 0, 0, 255);
         SDL_RenderClear(m_sdl_renderer);
     }
 
     void game_renderer::draw_end() {
+        sprite_batch_flush();
         SDL_RenderPresent(m_sdl_renderer);
     }
 
@@ -108,14 +218,14 @@ namespace engine {
 
         glm::vec2 screen_position = world_position;
 
-        if (m_camera != nullptr && m_viewport != nullptr) {
-            // Transform via viewport + camera
-            screen_position = m_viewport->world_to_screen(*m_camera, world_position);
-
+        if (const game_view_transform* view = get_view(); view != nullptr) {
             // Frustum culling
-            if (m_viewport->is_in_view(*m_camera, world_position, sprite->get_size()) == false) {
+            if (view->is_in_view(world_position, sprite->get_size()) == false) {
                 return;
             }
+
+            // Transform via viewport + camera
+            screen_position = view->world_to_screen(world_position);
         }
 
         // Apply camera zoom to sprite size and origin
@@ -135,9 +245,12 @@ namespace engine {
                                     screen_position.y - final_origin.y, final_size.x, final_size.y};
         const SDL_FPoint center = {final_origin.x, final_origin.y};
 
-        SDL_RenderTextureRotated(m_sdl_renderer, sprite->get_sdl_texture(), nullptr, &dst_rect,
+        const SDL_FRect src_rect = sprite_source_rect(*sprite);
+        SDL_RenderTextureRotated(m_sdl_renderer, sprite->get_sdl_texture(), &src_rect, &dst_rect,
                                  sprite->get_rotation(), &center, SDL_FLIP_NONE);
+        m_stats.draw_calls++;
     }
+
     void game_renderer::sprite_draw_screen(const game_sprite* sprite,
                                            const glm::vec2& screen_position) {
         if (sprite == nullptr || sprite->is_valid() == false) {
@@ -151,8 +264,97 @@ namespace engine {
                                     size.x, size.y};
         const SDL_FPoint center = {origin.x, origin.y};
 
-        SDL_RenderTextureRotated(m_sdl_renderer, sprite->get_sdl_texture(), nullptr, &dst_rect,
+        const SDL_FRect src_rect = sprite_source_rect(*sprite);
+        SDL_RenderTextureRotated(m_sdl_renderer, sprite->get_sdl_texture(), &src_rect, &dst_rect,
                                  sprite->get_rotation(), &center, SDL_FLIP_NONE);
+        m_stats.draw_calls++;
+    }
+
+    void game_renderer::sprite_queue_world(const game_sprite* sprite,
+                                           const glm::vec2& world_position, const int layer) {
+        if (sprite == nullptr || sprite->is_valid() == false) {
+            return;
+        }
+
+        sprite_queue(*sprite, world_position, sprite->get_rotation(), sprite->get_scale(),
+                     sprite->get_uv(), layer);
+    }
+
+    void game_renderer::sprite_queue(const game_sprite& sprite, const glm::vec2& world_position,
+                                     const float rotation, const glm::vec2& scale,
+                                     const glm::vec4& uv, const int layer) {
+        // A frame of a sheet covers part of the sprite's rect, and is drawn that much smaller.
+        const glm::vec4 sprite_uv = sprite.get_uv();
+        const glm::vec2 share = {(uv.z - uv.x) / (sprite_uv.z - sprite_uv.x),
+                                 (uv.w - uv.y) / (sprite_uv.w - sprite_uv.y)};
+        const glm::vec2 size = sprite.get_size() * share;
+
+        glm::vec2 screen_position = world_position;
+        retained_layer* retained = retained_layer_find(layer);
+
+        if (const game_view_transform* view = get_view(); view != nullptr) {
+            // Retained layers cull against the larger area of their texture instead.
+            if (retained == nullptr && view->is_in_view(world_position, size) == false) {
+                m_stats.sprites_culled++;
+                return;
+            }
+
+            screen_position = view->world_to_screen(world_position);
+        }
+
+        game_sprite_batch* batch = &m_sprite_batch;
+        if (retained != nullptr) {
+            // Routed by the scaled size, a partial redraw must not skip a scaled up sprite.
+            batch = retained_layer_route(*retained, world_position, size * scale,
+                                         screen_position);
+            if (batch == nullptr) {
+                return;
+            }
+        }
+
+        // Same zoom, origin and scale handling as `sprite_draw_world`.
+        glm::vec2 final_size = size;
+        glm::vec2 final_origin = sprite.get_origin() * share;
+
+        if (m_camera != nullptr) {
+            const float zoom = m_camera->get_zoom();
+            final_size *= zoom;
+            final_origin *= zoom;
+        }
+
+        final_size *= scale;
+
+        batch->push({.texture = sprite.get_sdl_texture(),
+                     .position = screen_position,
+                     .size = final_size,
+                     .origin = final_origin,
+                     .rotation = rotation,
+                     .uv = uv,
+                     .layer = layer});
+        m_stats.sprites_submitted++;
+    }
+
+    const game_view_transform* game_renderer::get_view() {
+        if (m_camera == nullptr || m_viewport == nullptr) {
+            return nullptr;
+        }
+
+        if (m_is_view_dirty == true) {
+            m_view = m_viewport->get_view_transform(*m_camera);
+            m_is_view_dirty = false;
+        }
+
+        return &m_view;
+    }
+
+    void game_renderer::sprite_batch_flush() {
+        for (retained_layer& retained : m_retained_layers) {
+            for (retained_target& target : retained.targets) {
+                retained_target_flush(retained, target);
+            }
+        }
+
+        m_sprite_batch.flush(m_sdl_renderer, m_stats);
     }
 
     void game_renderer::text_draw_world(const game_text_dynamic* text,
@@ -163,19 +365,18 @@ namespace engine {
 
         glm::vec2 screen_position;
 
-        if (m_camera != nullptr) {
+        if (const game_view_transform* view = get_view(); view != nullptr) {
             // Transform world position to screen coordinates using camera
-            screen_position = m_viewport->world_to_screen(*m_camera, world_position);
+            screen_position = view->world_to_screen(world_position);
 
             // Frustum culling: skip drawing if text is outside view
             // Account for text scale and origin when calculating bounds
             const glm::vec2 text_size = text->get_size();
             const glm::vec2 text_scale = text->get_scale();
-            const float camera_zoom = m_camera->get_zoom();
-            const glm::vec2 total_scale = text_scale * camera_zoom;
+            const glm::vec2 total_scale = text_scale * view->zoom;
             const glm::vec2 scaled_size = text_size * total_scale;
 
-            if (m_viewport->is_in_view(*m_camera, world_position, scaled_size) == false) {
+            if (view->is_in_view(world_position, scaled_size) == false) {
                 return;
             }
         } else {
@@ -186,50 +387,66 @@ namespace engine {
         text_draw_screen(text, screen_position);
     }
 
-    void game_renderer::text_draw_screen(const game_text_dynamic* text,
-                                         const glm::vec2& screen_position) {
+    void game_renderer::text_queue_world(const game_text_dynamic* text,
+                                         const glm::vec2& world_position, const int layer) {
         if (text == nullptr || text->is_valid() == false) {
             return;
         }
 
-        SDL_Texture* texture = text->get_sdl_texture();
-        if (!texture) {
-            return;
-        }
+        text_queue(*text, world_position, text->get_rotation(), text->get_scale(), layer);
+    }
 
-        // Get text properties
-        const glm::vec2 text_size = text->get_size();
-        const glm::vec2 text_origin = text->get_origin();
-        const glm::vec2 text_scale = text->get_scale();
-        const float text_rotation = text->get_rotation();
+    void game_renderer::text_queue(const game_text_dynamic& text, const glm::vec2& world_position,
+                                   const float rotation, const glm::vec2& scale,
+                                   const int layer) {
+        float zoom = 1.f;
+        glm::vec2 screen_position = world_position;
+        retained_layer* retained = retained_layer_find(layer);
 
-        // Apply camera zoom to scale if camera is present
-        glm::vec2 final_scale = text_scale;
-        if (m_camera != nullptr) {
-            final_scale *= m_camera->get_zoom();
+        if (const game_view_transform* view = get_view(); view != nullptr) {
+            zoom = view->zoom;
+
+            // Same culling bounds as `text_draw_world`.
+            const glm::vec2 scaled_size = text.get_size() * scale * zoom;
+            if (retained == nullptr && view->is_in_view(world_position, scaled_size) == false) {
+                m_stats.sprites_culled++;
+                return;
+            }
+
+            screen_position = view->world_to_screen(world_position);
         }
 
-        // Calculate final size and position
-        const glm::vec2 final_size = text_size * final_scale;
-        const glm::vec2 scaled_origin = text_origin * final_scale;
-        const glm::vec2 final_position = screen_position - scaled_origin;
+        game_sprite_batch* batch = &m_sprite_batch;
+        if (retained != nullptr) {
+            // World units like every other bound the route tests, so without the zoom.
+            batch = retained_layer_route(*retained, world_position, text.get_size() * scale,
+                                         screen_position);
+            if (batch == nullptr) {
+                return;
+            }
+        }
 
-        // Set up destination rectangle
-        const SDL_FRect dest_rect = {final_position.x, final_position.y, final_size.x,
-                                     final_size.y};
+        const glm::vec2 final_scale = scale * zoom;
+        m_stats.sprites_submitted +=
+            text_glyphs_push(*batch, text, screen_position, final_scale, rotation, layer);
+    }
 
-        // Set up rotation center point (relative to destination rectangle)
-        const SDL_FPoint center = {scaled_origin.x, scaled_origin.y};
+    void game_renderer::text_draw_screen(const game_text_dynamic* text,
+                                         const glm::vec2& screen_position) {
+        if (text == nullptr || text->is_valid() == false) {
+            return;
+        }
 
-        // Render with transformations
-        if (text_rotation != 0.0f) {
-            // Render with rotation
-            SDL_RenderTextureRotated(m_sdl_renderer, texture, nullptr, &dest_rect, text_rotation,
-                                     &center, SDL_FLIP_NONE);
-        } else {
-            // Simple render without rotation (slightly more efficient)
-            SDL_RenderTexture(m_sdl_renderer, texture, nullptr, &dest_rect);
+        // Apply camera zoom to scale if camera is present
+        glm::vec2 final_scale = text->get_scale();
+        if (m_camera != nullptr) {
+            final_scale *= m_camera->get_zoom();
         }
+
+        // Drawn right away through a batch of its own, queued sprites keep their place.
+        text_glyphs_push(m_text_batch, *text, screen_position, final_scale, text->get_rotation(),
+                         0);
+        m_text_batch.flush(m_sdl_renderer, m_stats);
     }
 
     void game_renderer::text_draw_screen(const game_text_static* text,
@@ -245,6 +462,497 @@ namespace engine {
         adjusted_position = glm::floor(adjusted_position);
 
         TTF_DrawRendererText(text->get_sdl_text(), adjusted_position.x, adjusted_position.y);
+        m_stats.draw_calls++;
+    }
+
+    void game_renderer::pass_add(const game_viewport* viewport, const game_camera* camera) {
+        m_passes.push_back({viewport, camera});
+    }
+
+    void game_renderer::passes_clear() {
+        m_passes.clear();
+        m_pass_stats.clear();
+
+        // Retained targets of the cleared passes would never be drawn through again.
+        for (retained_layer& retained : m_retained_layers) {
+            std::erase_if(retained.targets, [&](retained_target& target) {
+                if (target.viewport == m_viewport && target.camera == m_camera) {
+                    return false;
+                }
+
+                SDL_DestroyTexture(target.texture);
+                return true;
+            });
+        }
+    }
+
+    bool game_renderer::passes_visible_area(glm::vec2& min, glm::vec2& max) {
+        if (m_passes.empty() == true) {
+            return false;
+        }
+
+        glm::vec2 area_min = {0.f, 0.f};
+        glm::vec2 area_max = {0.f, 0.f};
+
+        for (std::size_t i = 0; i < m_passes.size(); ++i) {
+            const render_pass& pass = m_passes[i];
+
+            // A pass without a view draws everything, there is nothing to cull by.
+            if (pass.viewport == nullptr || pass.camera == nullptr) {
+                return false;
+            }
+
+            const auto [visible_min, visible_max] =
+                pass.viewport->get_visible_area_world(*pass.camera);
+            area_min = (i == 0) ? visible_min : glm::min(area_min, visible_min);
+            area_max = (i == 0) ? visible_max : glm::max(area_max, visible_max);
+        }
+
+        min = area_min;
+        max = area_max;
+
+        return true;
+    }
+
+    void game_renderer::render_list_draw() {
+        m_pass_stats.clear();
+
+        if (m_passes.empty() == true) {
+            const std::uint64_t start = performance_counter_value_current();
+            const game_render_stats before = m_stats;
+
+            render_list_submit();
+
+            m_pass_stats.push_back(
+                {(m_viewport != nullptr) ? m_viewport->get_name() : std::string_view{},
+                 performance_counter_seconds_since(start),
+                 render_stats_difference(m_stats, before)});
+            return;
+        }
+
+        const game_camera* camera = m_camera;
+        const game_viewport* viewport = m_viewport;
+
+        for (const render_pass& pass : m_passes) {
+            const std::uint64_t start = performance_counter_value_current();
+            const game_render_stats before = m_stats;
+
+            m_camera = pass.camera;
+            m_viewport = pass.viewport;
+            if (m_viewport != nullptr) {
+                m_viewport->apply_to_sdl(*this);
+            } else {
+                SDL_SetRenderViewport(m_sdl_renderer, nullptr);
+            }
+
+            // Recomputed once here, every draw of the pass reuses it.
+            m_is_view_dirty = true;
+
+            render_list_submit();
+
+            m_pass_stats.push_back(
+                {(pass.viewport != nullptr) ? pass.viewport->get_name() : std::string_view{},
+                 performance_counter_seconds_since(start),
+                 render_stats_difference(m_stats, before)});
+        }
+
+        m_camera = camera;
+        m_viewport = viewport;
+        if (m_viewport != nullptr) {
+            m_viewport->apply_to_sdl(*this);
+        } else {
+            SDL_SetRenderViewport(m_sdl_renderer, nullptr);
+        }
+
+        m_is_view_dirty = true;
+    }
+
+    void game_renderer::render_list_submit() {
+        for (const game_render_list_sprite& entry : m_render_list.sprites) {
+            if (entry.sprite != nullptr && entry.sprite->is_valid() == true) {
+                sprite_queue(*entry.sprite, entry.position, entry.rotation, entry.scale,
+                             entry.uv, entry.layer);
+            }
+        }
+
+        for (const game_render_list_text& entry : m_render_list.texts) {
+            if (entry.text != nullptr && entry.text->is_valid() == true) {
+                text_queue(*entry.text, entry.position, entry.rotation, entry.scale, entry.layer);
+            }
+        }
+
+        for (const game_render_list_particles& entry : m_render_list.particles) {
+            if (entry.sprite != nullptr && entry.sprite->is_valid() == true && entry.count > 0) {
+                particles_queue(entry);
+            }
+        }
+
+        sprite_batch_flush();
+    }
+
+    void game_renderer::particles_queue(const game_render_list_particles& particles) {
+        const game_sprite& sprite = *particles.sprite;
+        const game_view_transform* view = get_view();
+        const float zoom = (m_camera != nullptr) ? m_camera->get_zoom() : 1.f;
+
+        const glm::vec2 size = sprite.get_size();
+        const glm::vec2 size_screen = size * zoom;
+        const glm::vec2 origin_screen = sprite.get_origin() * zoom;
+
+        const glm::vec4 uv = sprite.get_uv();
+        const SDL_FPoint tex_coords[4] = {{uv.x, uv.y}, {uv.z, uv.y}, {uv.z, uv.w}, {uv.x, uv.w}};
+
+        const game_particle_appearance& look = particles.appearance;
+        const float fraction = particles.fraction;
+
+        // Reserve every particle and trim to the ones that passed culling afterwards.
+        SDL_Vertex* vertices =
+            m_sprite_batch.quads_push(sprite.get_sdl_texture(), particles.layer, particles.count);
+        std::size_t quad_count = 0;
+
+        for (std::size_t i = 0; i < particles.count; ++i) {
+            const glm::vec2 world_position = {
+                particles.previous_x[i] + (particles.position_x[i] - particles.previous_x[i]) *
+                                              fraction,
+                particles.previous_y[i] + (particles.position_y[i] - particles.previous_y[i]) *
+                                              fraction};
+
+            const float lifetime = particles.lifetime[i];
+            const float age =
+                (lifetime > 0.f) ? std::clamp(1.f - particles.remaining[i] / lifetime, 0.f, 1.f)
+                                 : 1.f;
+            const float scale = look.scale_start + (look.scale_end - look.scale_start) * age;
+
+            glm::vec2 screen_position = world_position;
+            if (view != nullptr) {
+                if (view->is_in_view(world_position, size * scale) == false) {
+                    continue;
+                }
+
+                screen_position = view->world_to_screen(world_position);
+            }
+
+            const glm::vec4 color = glm::mix(look.color_start, look.color_end, age);
+            const SDL_FColor tint = {color.r, color.g, color.b, color.a};
+
+            // Particles never rotate, so the quad is the scaled sprite rect around its origin.
+            const glm::vec2 top_left = screen_position - origin_screen * scale;
+            const glm::vec2 bottom_right = top_left + size_screen * scale;
+
+            SDL_Vertex* quad = vertices + quad_count * 4;
+            quad[0] = {{top_left.x, top_left.y}, tint, tex_coords[0]};
+            quad[1] = {{bottom_right.x, top_left.y}, tint, tex_coords[1]};
+            quad[2] = {{bottom_right.x, bottom_right.y}, tint, tex_coords[2]};
+            quad[3] = {{top_left.x, bottom_right.y}, tint, tex_coords[3]};
+            quad_count++;
+        }
+
+        m_sprite_batch.quads_trim(quad_count);
+        m_stats.particles_submitted += static_cast<std::uint32_t>(quad_count);
+    }
+
+    void game_renderer::layer_retain(const int layer, const float margin_pixels) {
+        if (retained_layer* retained = retained_layer_find(layer); retained != nullptr) {
+            retained->margin = std::max(margin_pixels, 0.f);
+            for (retained_target& target : retained->targets) {
+                target.is_valid = false;
+            }
+            return;
+        }
+
+        retained_layer& retained = m_retained_layers.emplace_back();
+        retained.layer = layer;
+        retained.margin = std::max(margin_pixels, 0.f);
+
+        log_info("Retained render layer {}", layer);
+    }
+
+    void game_renderer::layer_release(const int layer) {
+        auto it = std::find_if(m_retained_layers.begin(), m_retained_layers.end(),
+                               [&](const retained_layer& retained) {
+                                   return retained.layer == layer;
+                               });
+        if (it == m_retained_layers.end()) {
+            log_warning("Render layer {} is not retained.", layer);
+            return;
+        }
+
+        // Draws already routed to its batches this frame are dropped with it.
+        retained_layer_textures_destroy(*it);
+        m_retained_layers.erase(it);
+
+        log_info("Released render layer {}", layer);
+    }
+
+    bool game_renderer::is_layer_retained(const int layer) const {
+        return std::any_of(m_retained_layers.begin(), m_retained_layers.end(),
+                           [&](const retained_layer& retained) {
+                               return retained.layer == layer;
+                           });
+    }
+
+    void game_renderer::layer_invalidate(const int layer) {
+        if (retained_layer* retained = retained_layer_find(layer); retained != nullptr) {
+            for (retained_target& target : retained->targets) {
+                target.is_valid = false;
+            }
+        }
+    }
+
+    void game_renderer::layer_invalidate(const int layer, const glm::vec2& world_min,
+                                         const glm::vec2& world_max) {
+        retained_layer* retained = retained_layer_find(layer);
+        if (retained == nullptr) {
+            return;
+        }
+
+        // Every view's texture shows the region, each merges it into its own dirty box.
+        const glm::vec2 min = glm::min(world_min, world_max);
+        const glm::vec2 max = glm::max(world_min, world_max);
+
+        for (retained_target& target : retained->targets) {
+            if (target.has_dirty == false) {
+                target.dirty_min = min;
+                target.dirty_max = max;
+                target.has_dirty = true;
+                continue;
+            }
+
+            target.dirty_min = glm::min(target.dirty_min, min);
+            target.dirty_max = glm::max(target.dirty_max, max);
+        }
+    }
+
+    float game_renderer::get_layer_retain_margin_world() {
+        float margin = 0.f;
+        for (const retained_layer& retained : m_retained_layers) {
+            margin = std::max(margin, retained.margin);
+        }
+
+        // Each pass fills its own target, the one zoomed out the most reaches the furthest.
+        if (m_passes.empty() == false) {
+            float zoom = 0.f;
+            for (const render_pass& pass : m_passes) {
+                if (pass.camera != nullptr) {
+                    const float pass_zoom = pass.camera->get_zoom();
+                    zoom = (zoom == 0.f) ? pass_zoom : std::min(zoom, pass_zoom);
+                }
+            }
+
+            return (zoom > 0.f) ? margin / zoom : margin;
+        }
+
+        const game_view_transform* view = get_view();
+        return (view != nullptr) ? margin / view->zoom : margin;
+    }
+
+    game_renderer::retained_layer* game_renderer::retained_layer_find(const int layer) {
+        for (retained_layer& retained : m_retained_layers) {
+            if (retained.layer == layer) {
+                return &retained;
+            }
+        }
+
+        return nullptr;
+    }
+
+    game_renderer::retained_target& game_renderer::retained_target_get(
+        retained_layer& retained) {
+        for (retained_target& target : retained.targets) {
+            if (target.viewport == m_viewport && target.camera == m_camera) {
+                return target;
+            }
+        }
+
+        retained_target& target = retained.targets.emplace_back();
+        target.viewport = m_viewport;
+        target.camera = m_camera;
+        target.state = retained_state::idle;
+        target.texture = nullptr;
+        target.size = {0, 0};
+        target.is_valid = false;
+        target.has_failed = false;
+        target.zoom = 1.f;
+        target.offset = {0.f, 0.f};
+        target.origin = {0.f, 0.f};
+        target.shift = {0.f, 0.f};
+        target.has_dirty = false;
+        target.dirty_min = {0.f, 0.f};
+        target.dirty_max = {0.f, 0.f};
+
+        return target;
+    }
+
+    void game_renderer::retained_target_prepare(const retained_layer& retained,
+                                                retained_target& target) {
+        if (target.state != retained_state::idle) {
+            return;
+        }
+
+        const game_view_transform* view = get_view();
+        const float zoom = (view != nullptr) ? view->zoom : 1.f;
+        const glm::vec2 offset = (view != nullptr) ? view->offset : glm::vec2{0.f, 0.f};
+
+        const glm::vec2 viewport_position =
+            (m_viewport != nullptr) ? m_viewport->get_position_pixels() : glm::vec2{0.f, 0.f};
+        const glm::vec2 viewport_size =
+            (m_viewport != nullptr) ? m_viewport->get_size_pixels() : get_output_size();
+
+        const glm::ivec2 size = glm::ivec2(glm::ceil(viewport_size + retained.margin * 2.f));
+        if (target.texture == nullptr || target.size != size) {
+            // A target that failed once at this size is not retried every frame.
+            if (target.has_failed == true && target.size == size) {
+                target.state = retained_state::bypass;
+                return;
+            }
+
+            SDL_DestroyTexture(target.texture);
+            target.texture = SDL_CreateTexture(m_sdl_renderer, SDL_PIXELFORMAT_RGBA32,
+                                               SDL_TEXTUREACCESS_TARGET, size.x, size.y);
+            target.size = size;
+            target.is_valid = false;
+            target.has_failed = (target.texture == nullptr);
+
+            if (target.texture == nullptr) {
+                log_error("Failed to create the target of render layer {}: {}", retained.layer,
+                          SDL_GetError());
+                target.state = retained_state::bypass;
+                return;
+            }
+
+            // Blending onto transparent pixels leaves colors multiplied by their alpha.
+            SDL_SetTextureBlendMode(target.texture, SDL_BLENDMODE_BLEND_PREMULTIPLIED);
+        }
+
+        // A viewport moved on screen keeps its size, so its position is compared as well.
+        const glm::vec2 shift = offset - target.offset;
+        const bool is_current = target.is_valid == true && target.zoom == zoom &&
+                                target.origin == viewport_position - retained.margin &&
+                                std::abs(shift.x) <= retained.margin &&
+                                std::abs(shift.y) <= retained.margin;
+
+        if (is_current == true) {
+            target.shift = shift;
+            target.state =
+                (target.has_dirty == true) ? retained_state::partial : retained_state::reuse;
+            return;
+        }
+
+        target.state = retained_state::full;
+        target.zoom = zoom;
+        target.offset = offset;
+        target.origin = viewport_position - retained.margin;
+        target.shift = {0.f, 0.f};
+        target.has_dirty = false;
+    }
+
+    game_sprite_batch* game_renderer::retained_layer_route(retained_layer& retained,
+                                                           const glm::vec2& world_position,
+                                                           const glm::vec2& world_size,
+                                                           glm::vec2& screen_position) {
+        retained_target& target = retained_target_get(retained);
+        retained_target_prepare(retained, target);
+
+        const game_view_transform* view = get_view();
+        const float zoom = (view != nullptr) ? view->zoom : 1.f;
+
+        switch (target.state) {
+        case retained_state::reuse:
+            m_stats.sprites_retained++;
+            return nullptr;
+
+        case retained_state::bypass:
+            if (view != nullptr && view->is_in_view(world_position, world_size) == false) {
+                m_stats.sprites_culled++;
+                return nullptr;
+            }
+
+            return &m_sprite_batch;
+
+        default:
+            break;
+        }
+
+        if (view != nullptr &&
+            view->is_in_view(world_position, world_size + retained.margin * 2.f / zoom) == false) {
+            m_stats.sprites_culled++;
+            return nullptr;
+        }
+
+        if (target.state == retained_state::partial) {
+            // The diagonal bounds the quad for any origin and rotation.
+            const float reach = glm::length(world_size);
+            if (world_position.x + reach < target.dirty_min.x ||
+                world_position.x - reach > target.dirty_max.x ||
+                world_position.y + reach < target.dirty_min.y ||
+                world_position.y - reach > target.dirty_max.y) {
+                m_stats.sprites_retained++;
+                return nullptr;
+            }
+        }
+
+        screen_position -= target.origin + target.shift;
+        return &target.batch;
+    }
+
+    void game_renderer::retained_target_flush(const retained_layer& retained,
+                                              retained_target& target) {
+        const retained_state state = std::exchange(target.state, retained_state::idle);
+        if (state == retained_state::idle || state == retained_state::bypass) {
+            return;
+        }
+
+        if (state == retained_state::full || state == retained_state::partial) {
+            SDL_Texture* previous_target = SDL_GetRenderTarget(m_sdl_renderer);
+            SDL_SetRenderTarget(m_sdl_renderer, target.texture);
+
+            SDL_BlendMode blend_mode = SDL_BLENDMODE_BLEND;
+            SDL_GetRenderDrawBlendMode(m_sdl_renderer, &blend_mode);
+            SDL_SetRenderDrawBlendMode(m_sdl_renderer, SDL_BLENDMODE_NONE);
+            SDL_SetRenderDrawColor(m_sdl_renderer, 0, 0, 0, 0);
+
+            if (state == retained_state::full) {
+                SDL_RenderClear(m_sdl_renderer);
+            } else {
+                // Clear the dirty box, draws overlapping it repaint it through the clip.
+                const glm::vec2 offset = target.offset - target.origin;
+                const glm::vec2 min = glm::floor(target.dirty_min * target.zoom + offset);
+                const glm::vec2 max = glm::ceil(target.dirty_max * target.zoom + offset);
+
+                const SDL_Rect clip = {static_cast<int>(min.x), static_cast<int>(min.y),
+                                       static_cast<int>(max.x - min.x),
+                                       static_cast<int>(max.y - min.y)};
+                const SDL_FRect area = {min.x, min.y, max.x - min.x, max.y - min.y};
+
+                SDL_SetRenderClipRect(m_sdl_renderer, &clip);
+                SDL_RenderFillRect(m_sdl_renderer, &area);
+            }
+
+            SDL_SetRenderDrawBlendMode(m_sdl_renderer, blend_mode);
+
+            target.batch.flush(m_sdl_renderer, m_stats);
+
+            SDL_SetRenderClipRect(m_sdl_renderer, nullptr);
+            SDL_SetRenderTarget(m_sdl_renderer, previous_target);
+
+            target.is_valid = true;
+            target.has_dirty = false;
+            m_stats.layers_redrawn++;
+        }
+
+        // Sorted by layer with the other queued draws, so it lands at its layer's depth.
+        m_sprite_batch.push({.texture = target.texture,
+                             .position = target.origin + target.shift,
+                             .size = glm::vec2(target.size),
+                             .layer = retained.layer});
+    }
+
+    void game_renderer::retained_layer_textures_destroy(retained_layer& retained) {
+        for (retained_target& target : retained.targets) {
+            SDL_DestroyTexture(target.texture);
+        }
+
+        retained.targets.clear();
     }
 
     glm::vec2 game_renderer::get_output_size() const {
@@ -257,7 +965,7 @@ namespace engine {
     game_viewport& game_renderer::viewport_get_or_create(std::string_view name,
                                                          const glm::vec2& pos_norm,
                                                          const glm::vec2& size_norm) {
-        auto it = m_viewports.find(std::string(name));
+        auto it = m_viewports.find(name);
         if (it != m_viewports.end()) {
             return it->second;
         }
@@ -273,19 +981,32 @@ namespace engine {
     }
 
     game_viewport* game_renderer::viewport_get(std::string_view name) {
-        auto it = m_viewports.find(std::string(name));
+        auto it = m_viewports.find(name);
         if (it == m_viewports.end())
             return nullptr;
         return &it->second;
     }
 
     bool game_renderer::viewport_remove(std::string_view name) {
-        auto it = m_viewports.find(std::string(name));
+        auto it = m_viewports.find(name);
         if (it == m_viewports.end())
             return false;
         if (&it->second == m_viewport) {
             m_viewport = nullptr;  // legacy pointer invalidated
         }
+
+        // Targets kept for the removed viewport would never be drawn through again.
+        for (retained_layer& retained : m_retained_layers) {
+            std::erase_if(retained.targets, [&](retained_target& target) {
+                if (target.viewport != &it->second) {
+                    return false;
+                }
+
+                SDL_DestroyTexture(target.texture);
+                return true;
+            });
+        }
+
         m_viewports.erase(it);
         return true;
     }
@@ -1,22 +1,42 @@
 #pragma once
 
 #include "sprite.hxx"
+#include "sprite_batch.hxx"
+#include "render_list.hxx"
 #include "text.hxx"
+#include "viewport.hxx"
+#include "../utils/string_map.hxx"
 
-#include <unordered_map>
+#include <span>
 #include <string_view>
 #include <string>
+#include <vector>
 
 struct TTF_TextEngine;
 
 namespace engine {
     class game_camera;
-    class game_viewport;
+
+    /**
+     * @brief Time and counters of one render pass in the last `render_list_draw`.
+     * @note The time is spent on the CPU culling, sorting and submitting, not on the GPU.
+     */
+    struct game_render_pass_stats {
+        std::string_view name;  ///< Name of the pass's viewport, empty without one.
+        float seconds = 0.f;
+        game_render_stats render;
+    };
 
     /**
      * @brief Handles rendering of sprites and text with support for camera and viewport.
      */
     class game_renderer {
+    public:
+        /**
+         * @brief Default pixels a retained layer renders beyond each edge of the viewport.
+         */
+        static constexpr float layer_retain_margin_default = 256.f;
+
     public:
         explicit game_renderer(SDL_Window* window);
         ~game_renderer();
@@ -40,6 +60,15 @@ namespace engine {
         void set_viewport(const game_viewport* viewport);
         [[nodiscard]] const game_viewport* get_viewport() const;
 
+        /**
+         * @brief Get the world to screen transform of the current camera and viewport.
+         * @return The transform computed once per frame, nullptr without a camera or viewport.
+         * @note World draws use this cached transform, call `view_invalidate` after moving the
+         *       camera or resizing the viewport in the middle of a frame.
+         */
+        [[nodiscard]] const game_view_transform* get_view();
+        void view_invalidate();
+
         // --- Multi-viewport API ---
         // Create or fetch viewport by name; if creating, specify normalized rect.
         game_viewport& viewport_get_or_create(std::string_view name,
@@ -47,7 +76,7 @@ namespace engine {
                                               const glm::vec2& size_norm = {1.f, 1.f});
         game_viewport* viewport_get(std::string_view name);
         bool viewport_remove(std::string_view name);
-        [[nodiscard]] const std::unordered_map<std::string, game_viewport>& viewports() const {
+        [[nodiscard]] const string_map<game_viewport>& viewports() const {
             return m_viewports;
         }
         [[nodiscard]] game_viewport* viewport_main();  // convenience "main"
@@ -55,25 +84,249 @@ namespace engine {
         void sprite_draw_world(const game_sprite* sprite, const glm::vec2& world_position);
         void sprite_draw_screen(const game_sprite* sprite, const glm::vec2& screen_position);
 
+        /**
+         * @brief Queue a sprite for batched drawing in world space.
+         * @param sprite The sprite to draw, its current rotation and scale are captured.
+         * @param world_position Position of the sprite's origin in world space.
+         * @param layer Sort layer, lower layers are drawn first.
+         * @note Queued sprites are drawn on the next `sprite_batch_flush` or `draw_end`.
+         */
+        void sprite_queue_world(const game_sprite* sprite, const glm::vec2& world_position,
+                                int layer = 0);
+
+        /**
+         * @brief Submit all queued sprites and text, in layer order with one draw call per
+         *        texture run.
+         */
+        void sprite_batch_flush();
+
         void text_draw_world(const game_text_dynamic* text, const glm::vec2& world_position);
+
+        /**
+         * @brief Queue dynamic text for batched drawing in world space.
+         * @param text The text to draw, its current rotation and scale are captured.
+         * @param world_position Position of the text's origin in world space.
+         * @param layer Sort layer shared with sprites, lower layers are drawn first.
+         * @note Rebuilds the glyph layout if the string changed, rasterizing glyphs that are not
+         * cached yet into the shared glyph atlas.
+         */
+        void text_queue_world(const game_text_dynamic* text, const glm::vec2& world_position,
+                              int layer = 0);
         void text_draw_screen(const game_text_dynamic* text, const glm::vec2& screen_position);
 
         void text_draw_screen(const game_text_static* text, const glm::vec2& screen_position);
 
+        /**
+         * @brief Draw the frame's render list through a viewport and camera, next to the others.
+         *
+         * Without passes the list is drawn once through the current camera and viewport. With
+         * them, `render_list_draw` draws it once per pass in the order they were added, each
+         * with its own view transform, culling and batch flush. Retained layers keep a target
+         * per pass, so every pass reuses its own texture.
+         *
+         * @param viewport Pass viewport, must outlive the pass.
+         * @param camera Pass camera, must outlive the pass.
+         */
+        void pass_add(const game_viewport* viewport, const game_camera* camera);
+
+        /**
+         * @brief Remove every pass and the retained layer targets kept for them.
+         * @note Targets of the current camera and viewport are kept for drawing without passes.
+         */
+        void passes_clear();
+        [[nodiscard]] std::size_t get_pass_count() const noexcept;
+
+        /**
+         * @brief Get the world space box covering what any pass can see.
+         * @return False without passes or a view, `min` and `max` are left untouched then.
+         */
+        bool passes_visible_area(glm::vec2& min, glm::vec2& max);
+
+        /**
+         * @brief Get the render list to collect this frame's draws into, emptied.
+         */
+        [[nodiscard]] game_render_list& render_list_begin();
+
+        /**
+         * @brief Cull, transform and submit the render list once per pass.
+         * @note Restores the camera and viewport that were set before.
+         */
+        void render_list_draw();
+
+        /**
+         * @brief Get the time and counters of each pass in the last `render_list_draw`.
+         */
+        [[nodiscard]] std::span<const game_render_pass_stats> get_pass_stats() const noexcept;
+
+        /**
+         * @brief Keep a sort layer in a texture of its own and composite it with a single draw.
+         *
+         * The first flush renders everything queued on the layer into a render target covering
+         * the viewport plus `margin_pixels` on each side. Later flushes skip the layer's queued
+         * sprites and text and draw the texture instead, shifted when the camera pans less than
+         * the margin. Zooming, panning further, resizing the viewport or `layer_invalidate`
+         * redraws it.
+         *
+         * Every viewport and camera the layer is drawn through keeps a target of its own, so
+         * each pass of `render_list_draw` reuses its texture instead of redrawing the one before.
+         *
+         * @note Only retain layers whose contents rarely change, like backgrounds and tiles. The
+         * renderer cannot tell whether they did, call `layer_invalidate` when they do.
+         */
+        void layer_retain(int layer, float margin_pixels = layer_retain_margin_default);
+        void layer_release(int layer);
+        [[nodiscard]] bool is_layer_retained(int layer) const;
+
+        /**
+         * @brief Redraw a retained layer completely on the next flush.
+         */
+        void layer_invalidate(int layer);
+
+        /**
+         * @brief Redraw only the part of a retained layer inside a world space rectangle.
+         * @note Rectangles invalidated before the next flush merge into their bounding box.
+         */
+        void layer_invalidate(int layer, const glm::vec2& world_min, const glm::vec2& world_max);
+
+        /**
+         * @brief Get the widest retained margin in world units at the current zoom.
+         * @return The margin, zero without retained layers. Culling queries feeding the batch
+         *         must reach this far past the visible area. With passes it is measured at the
+         *         smallest zoom of their cameras.
+         */
+        [[nodiscard]] float get_layer_retain_margin_world();
+
         /**
          * @brief Get the output size of the renderer.
          * @return glm::vec2 representing the output size in pixels.
          */
         [[nodiscard]] glm::vec2 get_output_size() const;
 
+        /**
+         * @brief Get the rendering counters for the current frame.
+         * @return Draw call and batch counts accumulated since the last `draw_begin`.
+         */
+        [[nodiscard]] const game_render_stats& get_stats() const;
+
         // Future: expose iteration rendering hook if needed
 
+    private:
+        struct render_pass {
+            const game_viewport* viewport;
+            const game_camera* camera;
+        };
+        /**
+         * @brief What a retained layer does in the current flush, decided on its first draw.
+         */
+        enum class retained_state {
+            idle,     ///< Not drawn to since the last flush.
+            reuse,    ///< The texture is current, queued draws are skipped.
+            partial,  ///< Only draws touching the dirty rectangle are redrawn.
+            full,     ///< The texture is cleared and redrawn.
+            bypass    ///< No render target could be created, draws go to the main batch.
+        };
+
+        /**
+         * @brief The texture of a retained layer as seen through one viewport and camera.
+         */
+        struct retained_target {
+            const game_viewport* viewport;  ///< View the target is kept for.
+            const game_camera* camera;
+            retained_state state;
+
+            SDL_Texture* texture;
+            glm::ivec2 size;
+            bool is_valid;  ///< The texture holds a complete render of the layer.
+            bool has_failed;
+
+            float zoom;
+            glm::vec2 offset;
+            glm::vec2 origin;  ///< Screen position of the texture's top-left pixel when rendered.
+            glm::vec2 shift;   ///< Camera movement on screen since then.
+
+            bool has_dirty;
+            glm::vec2 dirty_min;  ///< World space bounding box of invalidated regions.
+            glm::vec2 dirty_max;
+
+            game_sprite_batch batch;  ///< Draws redrawn into the texture, in texture pixels.
+        };
+
+        struct retained_layer {
+            int layer;
+            float margin;
+            std::vector<retained_target> targets;
+        };
+
+        /**
+         * @brief Queue a sprite with the rotation, scale and source rect of one draw instead of
+         *        its own.
+         * @param uv Part of the sprite's texture to draw, sized by its share of the sprite's rect.
+         */
+        void sprite_queue(const game_sprite& sprite, const glm::vec2& world_position,
+                          float rotation, const glm::vec2& scale, const glm::vec4& uv, int layer);
+        void text_queue(const game_text_dynamic& text, const glm::vec2& world_position,
+                        float rotation, const glm::vec2& scale, int layer);
+
+        /**
+         * @brief Write an emitter's particles in view into one block of the main batch.
+         * @note Particles change every frame, so on retained layers they bypass the texture.
+         */
+        void particles_queue(const game_render_list_particles& particles);
+
+        /**
+         * @brief Queue and flush the render list through the current camera and viewport.
+         */
+        void render_list_submit();
+
+        [[nodiscard]] retained_layer* retained_layer_find(int layer);
+
+        /**
+         * @brief Get the target of a retained layer for the current viewport and camera.
+         */
+        [[nodiscard]] retained_target& retained_target_get(retained_layer& retained);
+
+        /**
+         * @brief Decide once per flush whether a retained target is reused or redrawn.
+         */
+        void retained_target_prepare(const retained_layer& retained, retained_target& target);
+
+        /**
+         * @brief Pick the batch a world draw on a retained layer goes to.
+         * @param world_size Size of the draw in world units, with its scale applied.
+         * @param screen_position Moved into the target's pixels when the draw is redrawn.
+         * @return The batch to queue into, nullptr if the layer's texture already shows it.
+         */
+        [[nodiscard]] game_sprite_batch* retained_layer_route(retained_layer& retained,
+                                                              const glm::vec2& world_position,
+                                                              const glm::vec2& world_size,
+                                                              glm::vec2& screen_position);
+
+        /**
+         * @brief Render a target's pending draws into its texture and queue the composite.
+         */
+        void retained_target_flush(const retained_layer& retained, retained_target& target);
+
+        void retained_layer_textures_destroy(retained_layer& retained);
+
     private:
         SDL_Renderer* m_sdl_renderer;
         TTF_TextEngine* m_sdl_text_engine;
         const game_camera* m_camera;
         const game_viewport* m_viewport;
-        std::unordered_map<std::string, game_viewport> m_viewports;  // name -> viewport
+        string_map<game_viewport> m_viewports;  // name -> viewport
+
+        game_sprite_batch m_sprite_batch;
+        game_sprite_batch m_text_batch;  ///< Immediate dynamic text draws, flushed per call.
+        game_render_stats m_stats;
+
+        game_view_transform m_view;
+        bool m_is_view_dirty;
+
+        std::vector<retained_layer> m_retained_layers;
+
+        game_render_list m_render_list;
+        std::vector<render_pass> m_passes;
+        std::vector<game_render_pass_stats> m_pass_stats;
     };
 
     inline SDL_Renderer* game_renderer::get_sdl_renderer() const {
@@ -85,6 +338,7 @@ namespace engine {
 
     inline void game_renderer::set_camera(const game_camera* cam) {
         m_camera = cam;
+        m_is_view_dirty = true;
     }
     inline const game_camera* game_renderer::get_camera() const {
         return m_camera;
@@ -92,9 +346,32 @@ namespace engine {
 
     inline void game_renderer::set_viewport(const game_viewport* vp) {
         m_viewport = vp;
+        m_is_view_dirty = true;
     }
     inline const game_viewport* game_renderer::get_viewport() const {
         return m_viewport;
     }
 
+    inline void game_renderer::view_invalidate() {
+        m_is_view_dirty = true;
+    }
+
+    inline const game_render_stats& game_renderer::get_stats() const {
+        return m_stats;
+    }
+
+    inline std::size_t game_renderer::get_pass_count() const noexcept {
+        return m_passes.size();
+    }
+
+    inline game_render_list& game_renderer::render_list_begin() {
+        m_render_list.clear();
+        return m_render_list;
+    }
+
+    inline std::span<const game_render_pass_stats> game_renderer::get_pass_stats()
+        const noexcept {
+        return m_pass_stats;
+    }
+
 }  // namespace engine
@@ -12,6 +12,7 @@ namespace engine {
           m_size{0, 0},
           m_origin{0, 0},
           m_scale{1.0f, 1.0f},
+          m_uv{0.f, 0.f, 1.f, 1.f},
           m_rotation(0.f) {
         auto_size_and_origin();
     }
@@ -23,9 +24,26 @@ namespace engine {
           m_size(size),
           m_origin(size * 0.5f),
           m_scale{1.0f, 1.0f},
+          m_uv{0.f, 0.f, 1.f, 1.f},
           m_rotation(0.f) {
     }
 
+    void game_sprite::set_texture(SDL_Texture* texture) {
+        m_sdl_texture = texture;
+
+        if (is_valid() == false || m_size != glm::vec2{0.f, 0.f}) {
+            return;
+        }
+
+        float w, h;
+        SDL_GetTextureSize(m_sdl_texture, &w, &h);
+
+        m_size = {w, h};
+        if (m_origin == glm::vec2{0.f, 0.f}) {
+            m_origin = m_size * 0.5f;
+        }
+    }
+
     void game_sprite::auto_size_and_origin() {
         if (is_valid() == false) {
             return;
@@ -4,6 +4,8 @@
 #include <string>
 #include <memory>
 
+#include "../utils/handles.hxx"
+
 struct SDL_Texture;
 
 namespace engine {
@@ -24,6 +26,11 @@ namespace engine {
          */
         using uptr = std::unique_ptr<game_sprite>;
 
+        /**
+         * @brief Generational handle to a sprite owned by `game_resources`.
+         */
+        using handle = game_handle<game_sprite>;
+
     public:
         game_sprite() = delete;
         game_sprite(std::string_view file_path, SDL_Texture* texture);
@@ -44,10 +51,24 @@ namespace engine {
         [[nodiscard]] float get_rotation() const;
         [[nodiscard]] glm::vec2 get_scale() const;
 
+        /**
+         * @brief Get the part of the texture the sprite draws, as normalized (u0, v0, u1, v1).
+         * @note Sprites packed into an atlas page share its texture and differ only by this rect.
+         */
+        [[nodiscard]] glm::vec4 get_uv() const;
+
+        /**
+         * @brief Attach a texture that finished loading after the sprite was created.
+         * @note Only a zero size or origin is replaced by the texture's, values set while the
+         * texture was loading are kept.
+         */
+        void set_texture(SDL_Texture* texture);
+
         void set_size(const glm::vec2& size);
         void set_origin(const glm::vec2& origin);
         void set_rotation(float rotation);
         void set_scale(const glm::vec2& scale);
+        void set_uv(const glm::vec4& uv);
 
         [[nodiscard]] bool is_valid() const;
 
@@ -60,6 +81,7 @@ namespace engine {
         glm::vec2 m_size;            // Size of the image that makes the sprite.
         glm::vec2 m_origin;          // Origin point of the sprite (automatically centered).
         glm::vec2 m_scale;
+        glm::vec4 m_uv;    // Normalized source rect within the texture.
         float m_rotation;  // Rotation angle of the sprite.
     };
 
@@ -87,6 +109,14 @@ namespace engine {
         return m_scale;
     }
 
+    inline glm::vec4 game_sprite::get_uv() const {
+        return m_uv;
+    }
+
+    inline void game_sprite::set_uv(const glm::vec4& uv) {
+        m_uv = uv;
+    }
+
     inline void game_sprite::set_size(const glm::vec2& size) {
         m_size = size;
     }
@@ -0,0 +1,233 @@
+#include "sprite_batch.hxx"
+
+#include <algorithm>
+#include <functional>
+
+#include "../logger.hxx"
+
+namespace engine {
+    void game_sprite_batch::push(const sprite_batch_command& command) {
+        const auto command_index = static_cast<std::uint32_t>(m_commands.size());
+        const auto depth = static_cast<std::uint32_t>(m_sort_entries.size());
+        const std::uint16_t texture_id = texture_id_get_or_assign(command.texture);
+
+        m_commands.push_back(command);
+        m_sort_entries.push_back(
+            {sprite_batch_sort_key(command.layer, texture_id, depth), command_index});
+    }
+
+    SDL_Vertex* game_sprite_batch::quads_push(SDL_Texture* texture, const int layer,
+                                              const std::size_t quad_count) {
+        const auto block_index = static_cast<std::uint32_t>(m_blocks.size());
+        const auto depth = static_cast<std::uint32_t>(m_sort_entries.size());
+        const std::uint16_t texture_id = texture_id_get_or_assign(texture);
+
+        const std::size_t vertex_first = m_block_vertices.size();
+        m_block_vertices.resize(vertex_first + quad_count * 4);
+
+        m_blocks.push_back({texture, vertex_first, quad_count * 4});
+        m_sort_entries.push_back(
+            {sprite_batch_sort_key(layer, texture_id, depth), block_index | block_index_bit});
+
+        return m_block_vertices.data() + vertex_first;
+    }
+
+    void game_sprite_batch::quads_trim(const std::size_t quad_count) {
+        if (m_blocks.empty() == true) {
+            return;
+        }
+
+        quad_block& block = m_blocks.back();
+        block.vertex_count = std::min(block.vertex_count, quad_count * 4);
+        m_block_vertices.resize(block.vertex_first + block.vertex_count);
+    }
+
+    void game_sprite_batch::flush(SDL_Renderer* sdl_renderer, game_render_stats& stats) {
+        if (m_sort_entries.empty() == true) {
+            return;
+        }
+
+        sort_commands();
+
+        SDL_Texture* run_texture = sort_entry_texture(m_sort_entries.front());
+        m_vertices.clear();
+
+        for (const sort_entry& entry : m_sort_entries) {
+            SDL_Texture* texture = sort_entry_texture(entry);
+
+            if (texture != run_texture) {
+                submit_run(sdl_renderer, run_texture, stats);
+                run_texture = texture;
+            }
+
+            if ((entry.command_index & block_index_bit) != 0) {
+                // Submit the quads gathered so far first to keep the draw order, then the block
+                // straight from its own vertices rather than copying it into the run.
+                const quad_block& block = m_blocks[entry.command_index & ~block_index_bit];
+                submit_run(sdl_renderer, run_texture, stats);
+                submit_geometry(sdl_renderer, block.texture,
+                                m_block_vertices.data() + block.vertex_first,
+                                block.vertex_count / 4, stats);
+                continue;
+            }
+
+            append_quad(m_commands[entry.command_index]);
+        }
+
+        submit_run(sdl_renderer, run_texture, stats);
+        clear();
+    }
+
+    std::uint16_t game_sprite_batch::texture_id_get_or_assign(const SDL_Texture* texture) {
+        // Keep the table at most half full so probe chains stay short.
+        if ((m_texture_count + 1) * 2 > m_texture_slots.size()) {
+            std::vector<texture_slot> old_slots = std::move(m_texture_slots);
+            m_texture_slots.assign(std::max<std::size_t>(64, old_slots.size() * 2),
+                                   texture_slot{nullptr, 0});
+
+            const std::size_t mask = m_texture_slots.size() - 1;
+            for (const texture_slot& slot : old_slots) {
+                if (slot.texture != nullptr) {
+                    std::size_t index = std::hash<const SDL_Texture*>{}(slot.texture) & mask;
+                    while (m_texture_slots[index].texture != nullptr) {
+                        index = (index + 1) & mask;
+                    }
+
+                    m_texture_slots[index] = slot;
+                }
+            }
+        }
+
+        const std::size_t mask = m_texture_slots.size() - 1;
+        std::size_t index = std::hash<const SDL_Texture*>{}(texture) & mask;
+
+        while (m_texture_slots[index].texture != nullptr) {
+            if (m_texture_slots[index].texture == texture) {
+                return m_texture_slots[index].id;
+            }
+
+            index = (index + 1) & mask;
+        }
+
+        // Ids past the 16-bit range share the last id; order stays correct, batching degrades.
+        const auto id =
+            static_cast<std::uint16_t>(std::min<std::uint32_t>(m_texture_count, 0xFFFF));
+        m_texture_slots[index] = {texture, id};
+        m_texture_count++;
+
+        return id;
+    }
+
+    void game_sprite_batch::texture_ids_reset() {
+        if (m_texture_count == 0) {
+            return;
+        }
+
+        std::fill(m_texture_slots.begin(), m_texture_slots.end(), texture_slot{nullptr, 0});
+        m_texture_count = 0;
+    }
+
+    void game_sprite_batch::sort_commands() {
+        // Entries are pushed in depth order and LSD radix sorting is stable, so only the
+        // layer and texture bytes (the upper 32 bits) need sorting passes.
+        constexpr int first_byte = 4;
+        constexpr int byte_count = 8;
+
+        const std::size_t count = m_sort_entries.size();
+        std::uint32_t histograms[byte_count][256] = {};
+
+        for (const sort_entry& entry : m_sort_entries) {
+            for (int byte = first_byte; byte < byte_count; ++byte) {
+                histograms[byte][(entry.key >> (byte * 8)) & 0xFF]++;
+            }
+        }
+
+        m_sort_scratch.resize(count);
+
+        for (int byte = first_byte; byte < byte_count; ++byte) {
+            std::uint32_t* histogram = histograms[byte];
+
+            // Every key shares this byte, the pass would not change anything.
+            if (histogram[(m_sort_entries.front().key >> (byte * 8)) & 0xFF] == count) {
+                continue;
+            }
+
+            std::uint32_t offset = 0;
+            for (int bucket = 0; bucket < 256; ++bucket) {
+                const std::uint32_t bucket_count = histogram[bucket];
+                histogram[bucket] = offset;
+                offset += bucket_count;
+            }
+
+            for (const sort_entry& entry : m_sort_entries) {
+                m_sort_scratch[histogram[(entry.key >> (byte * 8)) & 0xFF]++] = entry;
+            }
+
+            m_sort_entries.swap(m_sort_scratch);
+        }
+    }
+
+    SDL_Texture* game_sprite_batch::sort_entry_texture(const sort_entry& entry) const {
+        if ((entry.command_index & block_index_bit) != 0) {
+            return m_blocks[entry.command_index & ~block_index_bit].texture;
+        }
+
+        return m_commands[entry.command_index].texture;
+    }
+
+    void game_sprite_batch::append_quad(const sprite_batch_command& command) {
+        // Mirrors SDL_RenderTextureRotated: rotate the destination rect around the pivot.
+        const float radians = glm::radians(command.rotation);
+        const float cos_r = glm::cos(radians);
+        const float sin_r = glm::sin(radians);
+
+        const glm::vec2 corners[4] = {
+            {-command.origin.x, -command.origin.y},
+            {command.size.x - command.origin.x, -command.origin.y},
+            {command.size.x - command.origin.x, command.size.y - command.origin.y},
+            {-command.origin.x, command.size.y - command.origin.y},
+        };
+
+        const glm::vec4& uv = command.uv;
+        const SDL_FPoint tex_coords[4] = {{uv.x, uv.y}, {uv.z, uv.y}, {uv.z, uv.w}, {uv.x, uv.w}};
+
+        for (int i = 0; i < 4; ++i) {
+            const glm::vec2& corner = corners[i];
+            const SDL_FPoint position = {
+                command.position.x + corner.x * cos_r - corner.y * sin_r,
+                command.position.y + corner.x * sin_r + corner.y * cos_r};
+
+            m_vertices.push_back(SDL_Vertex{position, command.color, tex_coords[i]});
+        }
+    }
+
+    void game_sprite_batch::submit_run(SDL_Renderer* sdl_renderer, SDL_Texture* texture,
+                                       game_render_stats& stats) {
+        submit_geometry(sdl_renderer, texture, m_vertices.data(), m_vertices.size() / 4, stats);
+        m_vertices.clear();
+    }
+
+    void game_sprite_batch::submit_geometry(SDL_Renderer* sdl_renderer, SDL_Texture* texture,
+                                            const SDL_Vertex* vertices,
+                                            const std::size_t quad_count,
+                                            game_render_stats& stats) {
+        if (quad_count == 0) {
+            return;
+        }
+
+        // The index pattern is identical for every quad, so only grow it when needed.
+        for (std::size_t quad = m_indices.size() / 6; quad < quad_count; ++quad) {
+            const int base = static_cast<int>(quad * 4);
+            m_indices.insert(m_indices.end(),
+                             {base + 0, base + 1, base + 2, base + 2, base + 3, base + 0});
+        }
+
+        if (SDL_RenderGeometry(sdl_renderer, texture, vertices, static_cast<int>(quad_count * 4),
+                               m_indices.data(), static_cast<int>(quad_count * 6)) == false) {
+            log_error("Failed to submit sprite batch: {}", SDL_GetError());
+        }
+
+        stats.batches++;
+        stats.draw_calls++;
+    }
+}  // namespace engine
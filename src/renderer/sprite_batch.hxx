@@ -0,0 +1,174 @@
+/**
+ * @file sprite_batch.hxx
+ * @brief Batched sprite submission for the game renderer.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <SDL3/SDL.h>
+#include <glm/glm.hpp>
+
+namespace engine {
+    /**
+     * @brief A single sprite queued for batched drawing, already in screen space.
+     */
+    struct sprite_batch_command {
+        SDL_Texture* texture = nullptr;
+        glm::vec2 position = {0.f, 0.f};  ///< Screen position of the pivot point.
+        glm::vec2 size = {0.f, 0.f};      ///< Final on-screen size of the quad.
+        glm::vec2 origin = {0.f, 0.f};    ///< Pivot offset from the quad's top-left corner.
+        float rotation = 0.f;             ///< Clockwise rotation in degrees around the pivot.
+        glm::vec4 uv = {0.f, 0.f, 1.f, 1.f};  ///< Source rect in the texture as (u0, v0, u1, v1).
+        SDL_FColor color = {1.f, 1.f, 1.f, 1.f};  ///< Multiplied with the texture's pixels.
+        int layer = 0;
+    };
+
+    /**
+     * @brief Pack a render sort key as (layer, texture id, depth) from the most significant bits.
+     * @param layer Sort layer, clamped to the signed 16-bit range.
+     * @param texture_id Small per-frame texture identifier.
+     * @param depth Order within the same layer and texture, lower draws first.
+     * @return The packed key, ascending order is draw order.
+     */
+    [[nodiscard]] constexpr std::uint64_t sprite_batch_sort_key(int layer, std::uint16_t texture_id,
+                                                                std::uint32_t depth) noexcept {
+        const int clamped_layer = layer < -32768 ? -32768 : (layer > 32767 ? 32767 : layer);
+        const auto biased_layer = static_cast<std::uint64_t>(clamped_layer + 32768);
+        return (biased_layer << 48) | (static_cast<std::uint64_t>(texture_id) << 32) | depth;
+    }
+
+    /**
+     * @brief Per-frame rendering counters, reset by `game_renderer::draw_begin`.
+     */
+    struct game_render_stats {
+        std::uint32_t draw_calls = 0;         ///< Total SDL draw calls issued this frame.
+        std::uint32_t batches = 0;            ///< Geometry submissions made by the sprite batch.
+        std::uint32_t sprites_submitted = 0;  ///< Sprites queued into the batch.
+        std::uint32_t sprites_culled = 0;     ///< Sprites rejected before reaching the batch.
+        std::uint32_t sprites_retained = 0;   ///< Sprites a retained layer's texture already shows.
+        std::uint32_t layers_redrawn = 0;     ///< Retained layers drawn into their texture.
+        std::uint32_t particles_submitted = 0;  ///< Particle quads queued into the batch.
+    };
+
+    /**
+     * @brief Collects textured quad draw commands and submits them grouped by texture.
+     *
+     * Every command gets a 64-bit key packed from its layer, a per-frame texture id and its
+     * submission order. Keys are radix sorted on flush, which gives a stable and deterministic
+     * draw order, and each run of commands sharing a texture is expanded into a single quad list
+     * drawn with one `SDL_RenderGeometry` call. All buffers are reused between frames so flushing
+     * does not allocate once they have grown to the scene's size.
+     *
+     * Callers that already have many quads on one texture, such as particle emitters, write their
+     * vertices into a block from `quads_push`. A block sorts like a single command and is
+     * submitted straight from its own vertices with one call per texture run.
+     */
+    class game_sprite_batch {
+    public:
+        game_sprite_batch() = default;
+        ~game_sprite_batch() = default;
+
+        game_sprite_batch(const game_sprite_batch&) = delete;
+        game_sprite_batch& operator=(const game_sprite_batch&) = delete;
+        game_sprite_batch(game_sprite_batch&&) noexcept = default;
+        game_sprite_batch& operator=(game_sprite_batch&&) noexcept = default;
+
+        void push(const sprite_batch_command& command);
+
+        /**
+         * @brief Queue a block of quads whose screen space vertices the caller writes itself.
+         * @param texture Texture every quad of the block samples.
+         * @param layer Sort layer of the whole block.
+         * @param quad_count Number of quads to reserve.
+         * @return Four vertices per quad, in top-left, top-right, bottom-right, bottom-left order.
+         * @note The pointer is only valid until the next `quads_push`.
+         */
+        [[nodiscard]] SDL_Vertex* quads_push(SDL_Texture* texture, int layer,
+                                             std::size_t quad_count);
+
+        /**
+         * @brief Shrink the last block from `quads_push` to its first `quad_count` quads.
+         * @note Lets callers reserve for the worst case and cull while writing vertices.
+         */
+        void quads_trim(std::size_t quad_count);
+
+        /**
+         * @brief Sort, expand and submit all queued commands, then clear the queue.
+         * @param sdl_renderer The renderer to submit geometry to.
+         * @param stats Counters to accumulate batch and draw call numbers into.
+         */
+        void flush(SDL_Renderer* sdl_renderer, game_render_stats& stats);
+        void clear();
+
+        [[nodiscard]] bool is_empty() const;
+        [[nodiscard]] std::size_t get_size() const;
+
+    private:
+        /**
+         * @brief Set on `sort_entry::command_index` when it indexes `m_blocks` instead.
+         */
+        static constexpr std::uint32_t block_index_bit = 0x80000000u;
+
+        struct sort_entry {
+            std::uint64_t key;
+            std::uint32_t command_index;
+        };
+
+        struct quad_block {
+            SDL_Texture* texture;
+            std::size_t vertex_first;
+            std::size_t vertex_count;
+        };
+
+        struct texture_slot {
+            const SDL_Texture* texture;
+            std::uint16_t id;
+        };
+
+        [[nodiscard]] std::uint16_t texture_id_get_or_assign(const SDL_Texture* texture);
+        void texture_ids_reset();
+
+        void sort_commands();
+        [[nodiscard]] SDL_Texture* sort_entry_texture(const sort_entry& entry) const;
+        void append_quad(const sprite_batch_command& command);
+        void submit_run(SDL_Renderer* sdl_renderer, SDL_Texture* texture, game_render_stats& stats);
+        void submit_geometry(SDL_Renderer* sdl_renderer, SDL_Texture* texture,
+                             const SDL_Vertex* vertices, std::size_t quad_count,
+                             game_render_stats& stats);
+
+    private:
+        std::vector<sprite_batch_command> m_commands;
+        std::vector<quad_block> m_blocks;
+        std::vector<SDL_Vertex> m_block_vertices;
+        std::vector<sort_entry> m_sort_entries;
+        std::vector<sort_entry> m_sort_scratch;
+
+        std::vector<texture_slot> m_texture_slots;  ///< Open addressing table, power of two size.
+        std::uint32_t m_texture_count = 0;
+
+        std::vector<SDL_Vertex> m_vertices;
+        std::vector<int> m_indices;
+    };
+
+    inline void game_sprite_batch::clear() {
+        m_commands.clear();
+        m_blocks.clear();
+        m_block_vertices.clear();
+        m_sort_entries.clear();
+        texture_ids_reset();
+    }
+
+    inline bool game_sprite_batch::is_empty() const {
+        return m_sort_entries.empty();
+    }
+
+    /**
+     * @note Counts each block from `quads_push` once, like a single command.
+     */
+    inline std::size_t game_sprite_batch::get_size() const {
+        return m_sort_entries.size();
+    }
+}  // namespace engine
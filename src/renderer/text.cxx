@@ -2,6 +2,8 @@
 
 #include <SDL3_ttf/SDL_ttf.h>
 
+#include <algorithm>
+
 namespace engine {
     game_text_static::game_text_static(TTF_Text* sdl_text)
         : m_sdl_text(sdl_text), m_origin(0.0f, 0.0f) {
@@ -55,84 +57,81 @@ namespace engine {
         TTF_SetTextColor(m_sdl_text, new_color.r, new_color.g, new_color.b, new_color.a);
     }
 
-    game_text_dynamic::game_text_dynamic(std::string_view content, TTF_Text* text,
-                                         SDL_Renderer* sdl_renderer, TTF_Font* font)
-        : m_static_text(text),
-          m_sdl_renderer(sdl_renderer),
-          m_sdl_font(font),
-          m_cached_texture(nullptr),
-          m_is_texture_dirty(true),
+    game_text_dynamic::game_text_dynamic(std::string_view content, game_glyph_atlas* glyph_atlas)
+        : m_glyph_atlas(glyph_atlas),
+          m_glyphs(),
+          m_size(0.0f, 0.0f),
+          m_is_glyphs_dirty(true),
           m_text_content(content),
+          m_color(255, 255, 255, 255),
+          m_origin(0.0f, 0.0f),
           m_scale(1.0f, 1.0f),
           m_rotation_degrees(0.0f) {
         if (m_text_content.empty() == true) {
             throw std::invalid_argument("Invalid text content.");
         }
 
-        if (m_sdl_renderer == nullptr) {
-            throw std::invalid_argument("Invalid renderer.");
-        }
-
-        if (m_sdl_font == nullptr) {
-            throw std::invalid_argument("Invalid font.");
+        if (m_glyph_atlas == nullptr) {
+            throw std::invalid_argument("Invalid glyph atlas.");
         }
     }
 
-    game_text_dynamic::~game_text_dynamic() {
-        if (m_cached_texture != nullptr) {
-            SDL_DestroyTexture(m_cached_texture);
-        }
+    const std::vector<game_text_glyph>& game_text_dynamic::get_glyphs() const {
+        // Ugly but we need to cast away const to call rebuild_glyphs_if_needed.
+        const_cast<game_text_dynamic*>(this)->rebuild_glyphs_if_needed();
+        return m_glyphs;
     }
 
-    SDL_Texture* game_text_dynamic::get_sdl_texture() const {
-        // Ugly but we need to cast away const to call regenerate_texture_if_needed.
-        const_cast<game_text_dynamic*>(this)->regenerate_texture_if_needed();
-        return m_cached_texture;
+    glm::vec2 game_text_dynamic::get_size() const {
+        const_cast<game_text_dynamic*>(this)->rebuild_glyphs_if_needed();
+        return m_size;
     }
 
     void game_text_dynamic::set_text_raw(std::string_view new_text) {
         m_text_content = new_text;
-        m_static_text.set_text_raw(new_text);
-        mark_texture_dirty();
+        mark_glyphs_dirty();
     }
 
-    void game_text_dynamic::set_color(const game_color& new_color) {
-        m_static_text.set_color(new_color);
-        mark_texture_dirty();
-    }
-
-    void game_text_dynamic::regenerate_texture_if_needed() {
-        // Text hasn't changed. No need to regenerate texture.
-        if (m_is_texture_dirty == false) {
+    void game_text_dynamic::rebuild_glyphs_if_needed() {
+        // Text hasn't changed. No need to lay it out again.
+        if (m_is_glyphs_dirty == false) {
             return;
         }
 
-        // Clean up the old texture.
-        if (m_cached_texture != nullptr) {
-            SDL_DestroyTexture(m_cached_texture);
-            m_cached_texture = nullptr;
-        }
+        m_glyphs.clear();
 
-        m_cached_texture = create_texture_from_surface();
-        m_is_texture_dirty = false;
-    }
+        glm::vec2 pen = {0.f, 0.f};
+        float width = 0.f;
+        std::uint32_t previous = 0;
 
-    SDL_Texture* game_text_dynamic::create_texture_from_surface() {
-        SDL_Surface* surface =
-            TTF_RenderText_Blended(m_sdl_font, m_text_content.c_str(), m_text_content.size(),
-                                   m_static_text.get_color().to_sdl_color());
-        if (surface == nullptr) {
-            return nullptr;
-        }
+        const char* cursor = m_text_content.c_str();
+        std::size_t length = m_text_content.size();
 
-        SDL_Texture* texture = SDL_CreateTextureFromSurface(m_sdl_renderer, surface);
+        while (length > 0) {
+            const std::uint32_t codepoint = SDL_StepUTF8(&cursor, &length);
+            if (codepoint == '\n') {
+                width = std::max(width, pen.x);
+                pen = {0.f, pen.y + m_glyph_atlas->get_line_skip()};
+                previous = 0;
+                continue;
+            }
 
-        if (texture != nullptr) {
-            SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
-        }
+            if (previous != 0) {
+                pen.x += m_glyph_atlas->get_kerning(previous, codepoint);
+            }
 
-        SDL_DestroySurface(surface);
+            const game_glyph& glyph = m_glyph_atlas->glyph_get_or_create(codepoint);
+            if (glyph.texture != nullptr) {
+                m_glyphs.push_back(
+                    {glyph.texture, {pen.x + glyph.offset_x, pen.y}, glyph.size, glyph.uv});
+            }
+
+            pen.x += glyph.advance;
+            previous = codepoint;
+        }
 
-        return texture;
+        // Every line is a glyph cell high, the cells span the font's full height.
+        m_size = {std::max(width, pen.x), pen.y + m_glyph_atlas->get_height()};
+        m_is_glyphs_dirty = false;
     }
 }  // namespace engine
@@ -3,7 +3,10 @@
 #include <glm/glm.hpp>
 #include <string>
 #include <format>
+#include <vector>
 #include "color.hxx"
+#include "glyph_atlas.hxx"
+#include "../utils/handles.hxx"
 
 struct TTF_Text;
 struct TTF_Font;
@@ -98,25 +101,40 @@ namespace engine {
         return m_sdl_text != nullptr;
     }
 
+    /**
+     * @brief A glyph quad of laid out dynamic text, in the text's unscaled local space.
+     */
+    struct game_text_glyph {
+        SDL_Texture* texture;
+        glm::vec2 position;  ///< Top-left corner relative to the text's top-left corner.
+        glm::vec2 size;
+        glm::vec4 uv;
+    };
+
     /**
      * @brief Represents dynamic text objects in the game.
      *
-     * This class wraps the `render_text_static` class and adds support for dynamic text
-     * resizing and scaling that can change during gameplay by using surfaces and textures - making
-     * it ideal for game world text.
+     * Supports resizing, scaling and rotation that can change during gameplay - making it ideal
+     * for game world text.
      *
-     * @note Keep in mind that every time you change the text content or the color of this object,
-     * the internal texture will need to be regenerated to reflect those changes, coming with a
-     * slight performance cost.
+     * The text is drawn as one quad per glyph from a glyph atlas shared by every text using the
+     * same font and size. Changing the content only lays the quads out again and changing the
+     * color only changes vertex colors, so texts updated every frame like scores and timers do
+     * not create or upload textures. The size is measured from the same layout, so it always
+     * matches the quads.
      */
     class game_text_dynamic {
     public:
         using uptr = std::unique_ptr<game_text_dynamic>;
 
+        /**
+         * @brief Generational handle to dynamic text owned by `game_resources`.
+         */
+        using handle = game_handle<game_text_dynamic>;
+
     public:
-        game_text_dynamic(std::string_view content, TTF_Text* text, SDL_Renderer* sdl_renderer,
-                          TTF_Font* font);
-        ~game_text_dynamic();
+        game_text_dynamic(std::string_view content, game_glyph_atlas* glyph_atlas);
+        ~game_text_dynamic() = default;
 
         game_text_dynamic(const game_text_dynamic&) = delete;
         game_text_dynamic& operator=(const game_text_dynamic&) = delete;
@@ -124,18 +142,21 @@ namespace engine {
         game_text_dynamic& operator=(game_text_dynamic&&) = delete;
 
         /**
-         * @brief Access the internal SDL texture for rendering the text.
+         * @brief Access the glyph quads for rendering the text.
          *
-         * Changes to the internal text content or text color will set a flag indicating
-         * that the texture needs to be regenerated next time this method is called.
+         * Changes to the internal text content set a flag indicating that the quads need to be
+         * laid out again next time this method is called.
          *
-         * @return Pointer to the SDL texture.
+         * @return The quads, valid until the text content changes.
          * @note This utility should only be used internally by the game renderer.
          */
-        [[nodiscard]] SDL_Texture* get_sdl_texture() const;
-        [[nodiscard]] const game_text_static* get_static_text() const;
+        [[nodiscard]] const std::vector<game_text_glyph>& get_glyphs() const;
 
         [[nodiscard]] game_color get_color() const;
+
+        /**
+         * @brief Get the size of the laid out text, the widest line by the height of every line.
+         */
         [[nodiscard]] glm::vec2 get_size() const;
         [[nodiscard]] glm::vec2 get_transformed_size() const;
         [[nodiscard]] glm::vec2 get_origin() const;
@@ -145,8 +166,8 @@ namespace engine {
         /**
          * @brief Set the raw text content.
          * @param new_text The new text content.
-         * @note Changing the text content will mark the internal texture as dirty, requiring
-         * regeneration.
+         * @note Changing the text content will mark the glyph layout as dirty, requiring it to
+         * be built again.
          */
         void set_text_raw(std::string_view new_text);
 
@@ -155,8 +176,8 @@ namespace engine {
          * @tparam Args Variadic template arguments.
          * @param fmt The format string.
          * @param args The values to format.
-         * @note Changing the text content will mark the internal texture as dirty, requiring
-         * regeneration.
+         * @note Changing the text content will mark the glyph layout as dirty, requiring it to
+         * be built again.
          */
         template <typename... Args>
         void set_text(std::format_string<Args...> fmt, Args&&... args);
@@ -164,7 +185,6 @@ namespace engine {
         /**
          * @brief Set the color of the text.
          * @param new_color The new color to set.
-         * @note Changing the color will mark the internal texture as dirty, requiring regeneration.
          */
         void set_color(const game_color& new_color);
         void set_scale(const glm::vec2& new_scale);
@@ -177,21 +197,20 @@ namespace engine {
         [[nodiscard]] bool is_valid() const;
 
     private:
-        void mark_texture_dirty();
-        void regenerate_texture_if_needed();
-        SDL_Texture* create_texture_from_surface();
+        void mark_glyphs_dirty();
+        void rebuild_glyphs_if_needed();
 
     private:
-        game_text_static m_static_text;
+        game_glyph_atlas* m_glyph_atlas;
 
-        SDL_Renderer* m_sdl_renderer;
-        TTF_Font* m_sdl_font;
-
-        SDL_Texture* m_cached_texture;
-        bool m_is_texture_dirty;
+        std::vector<game_text_glyph> m_glyphs;
+        glm::vec2 m_size;  ///< Measured with the glyphs, valid while they are.
+        bool m_is_glyphs_dirty;
 
         std::string m_text_content;
 
+        game_color m_color;
+        glm::vec2 m_origin;
         glm::vec2 m_scale;
         float m_rotation_degrees;
     };
@@ -203,11 +222,7 @@ namespace engine {
     }
 
     inline game_color game_text_dynamic::get_color() const {
-        return m_static_text.get_color();
-    }
-
-    inline glm::vec2 game_text_dynamic::get_size() const {
-        return m_static_text.get_size();
+        return m_color;
     }
 
     inline glm::vec2 game_text_dynamic::get_transformed_size() const {
@@ -215,7 +230,7 @@ namespace engine {
     }
 
     inline glm::vec2 game_text_dynamic::get_origin() const {
-        return m_static_text.get_origin();
+        return m_origin;
     }
 
     inline glm::vec2 game_text_dynamic::get_scale() const {
@@ -239,19 +254,24 @@ namespace engine {
     }
 
     inline bool game_text_dynamic::is_valid() const {
-        return m_static_text.is_valid() == true && m_sdl_renderer != nullptr &&
-               m_sdl_font != nullptr;
+        return m_glyph_atlas != nullptr;
+    }
+
+    inline void game_text_dynamic::set_color(const game_color& new_color) {
+        // Glyphs are cached white and tinted at draw time, so the layout stays valid.
+        m_color = new_color;
     }
 
     inline void game_text_dynamic::set_origin(const glm::vec2& new_origin) {
-        m_static_text.set_origin(new_origin);
+        m_origin = new_origin;
     }
 
     inline void game_text_dynamic::set_origin_centered() {
-        m_static_text.set_origin_centered();
+        const glm::vec2 text_size = get_size();
+        set_origin({text_size.x * 0.5f, text_size.y * 0.5f});
     }
 
-    inline void game_text_dynamic::mark_texture_dirty() {
-        m_is_texture_dirty = true;
+    inline void game_text_dynamic::mark_glyphs_dirty() {
+        m_is_glyphs_dirty = true;
     }
 }  // namespace engine
@@ -94,6 +94,14 @@ namespace engine {
         return {glm::vec2(min_x, min_y), glm::vec2(max_x, max_y)};
     }
 
+    game_view_transform game_viewport::get_view_transform(const game_camera& camera) const {
+        const float zoom = camera.get_zoom();
+        const glm::vec2 screen_center = m_cached_position_pixels + m_cached_size_pixels * 0.5f;
+        const auto [visible_min, visible_max] = get_visible_area_world(camera);
+
+        return {zoom, screen_center - camera.get_position() * zoom, visible_min, visible_max};
+    }
+
     bool game_viewport::is_in_view(const game_camera& camera, const glm::vec2& position,
                                    const glm::vec2& size) const {
         const auto [min_bounds, max_bounds] = get_visible_area_world(camera);
@@ -15,6 +15,26 @@ namespace engine {
     class game_camera;
     class game_renderer;
 
+    /**
+     * @brief A camera and viewport pair flattened into a scale, an offset and a world space box.
+     *
+     * Computing this once per frame replaces rebuilding the view matrix and the visible area for
+     * every sprite. Results match `game_viewport::world_to_screen` and `is_in_view`.
+     */
+    struct game_view_transform {
+        float zoom = 1.f;
+        glm::vec2 offset = {0.f, 0.f};       ///< Screen position of the world origin.
+        glm::vec2 visible_min = {0.f, 0.f};  ///< Top-left of the visible area in world space.
+        glm::vec2 visible_max = {0.f, 0.f};  ///< Bottom-right of the visible area in world space.
+
+        [[nodiscard]] glm::vec2 world_to_screen(const glm::vec2& world_position) const;
+
+        /**
+         * @brief Check whether a box centered on a world position overlaps the visible area.
+         */
+        [[nodiscard]] bool is_in_view(const glm::vec2& position, const glm::vec2& size) const;
+    };
+
     /**
      * @brief A rectangular render target in window space using normalized coordinates.
      */
@@ -51,6 +71,7 @@ namespace engine {
         glm::vec2 screen_to_world(const game_camera& camera, const glm::vec2& screen_pos) const;
 
         std::tuple<glm::vec2, glm::vec2> get_visible_area_world(const game_camera& camera) const;
+        [[nodiscard]] game_view_transform get_view_transform(const game_camera& camera) const;
         bool is_in_view(const game_camera& camera, const glm::vec2& position,
                         const glm::vec2& size) const;
 
@@ -72,6 +93,19 @@ namespace engine {
         mutable glm::vec2 m_cached_size_pixels;
     };
 
+    inline glm::vec2 game_view_transform::world_to_screen(const glm::vec2& world_position) const {
+        return world_position * zoom + offset;
+    }
+
+    inline bool game_view_transform::is_in_view(const glm::vec2& position,
+                                                const glm::vec2& size) const {
+        const glm::vec2 half_size = size * 0.5f;
+        return !(position.x + half_size.x < visible_min.x ||
+                 position.x - half_size.x > visible_max.x ||
+                 position.y + half_size.y < visible_min.y ||
+                 position.y - half_size.y > visible_max.y);
+    }
+
     inline std::string_view game_viewport::get_name() const {
         return m_name;
     }
@@ -0,0 +1,225 @@
+/**
+ * @file archive.cxx
+ * @brief Memory-mapped asset archive implementation.
+ */
+
+#include "archive.hxx"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "../logger.hxx"
+
+namespace engine {
+    game_asset_archive::~game_asset_archive() {
+        close();
+    }
+
+    game_asset_archive::game_asset_archive(game_asset_archive&& other) noexcept
+        : m_data(std::exchange(other.m_data, nullptr)),
+          m_size(std::exchange(other.m_size, 0)),
+          m_entries(std::exchange(other.m_entries, nullptr)),
+          m_entry_count(std::exchange(other.m_entry_count, 0)),
+          m_strings(std::exchange(other.m_strings, nullptr))
+#if defined(_WIN32)
+          ,
+          m_file(std::exchange(other.m_file, nullptr)),
+          m_mapping(std::exchange(other.m_mapping, nullptr))
+#endif
+    {
+    }
+
+    game_asset_archive& game_asset_archive::operator=(game_asset_archive&& other) noexcept {
+        if (this != &other) {
+            close();
+
+            m_data = std::exchange(other.m_data, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+            m_entries = std::exchange(other.m_entries, nullptr);
+            m_entry_count = std::exchange(other.m_entry_count, 0);
+            m_strings = std::exchange(other.m_strings, nullptr);
+#if defined(_WIN32)
+            m_file = std::exchange(other.m_file, nullptr);
+            m_mapping = std::exchange(other.m_mapping, nullptr);
+#endif
+        }
+
+        return *this;
+    }
+
+    bool game_asset_archive::open(std::string_view file_path) {
+        close();
+
+        // The OS wants a null-terminated path, which a view does not guarantee.
+        const std::string path(file_path);
+
+#if defined(_WIN32)
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+
+        LARGE_INTEGER file_size = {};
+        if (GetFileSizeEx(file, &file_size) == FALSE || file_size.QuadPart == 0) {
+            CloseHandle(file);
+            return false;
+        }
+
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr) {
+            CloseHandle(file);
+            return false;
+        }
+
+        const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (view == nullptr) {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+
+        m_file = file;
+        m_mapping = mapping;
+        m_data = static_cast<const std::byte*>(view);
+        m_size = static_cast<std::size_t>(file_size.QuadPart);
+#else
+        const int file = ::open(path.c_str(), O_RDONLY);
+        if (file < 0) {
+            return false;
+        }
+
+        struct stat file_stat = {};
+        if (fstat(file, &file_stat) != 0 || file_stat.st_size <= 0) {
+            ::close(file);
+            return false;
+        }
+
+        const auto size = static_cast<std::size_t>(file_stat.st_size);
+        void* view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+
+        // The mapping keeps its own reference to the file.
+        ::close(file);
+
+        if (view == MAP_FAILED) {
+            return false;
+        }
+
+        m_data = static_cast<const std::byte*>(view);
+        m_size = size;
+#endif
+
+        if (validate() == false) {
+            log_error("Asset archive is corrupt or has an unsupported version: {}", file_path);
+            close();
+            return false;
+        }
+
+        const auto* header = reinterpret_cast<const asset_archive_header*>(m_data);
+        m_entries = reinterpret_cast<const asset_archive_entry*>(m_data + header->entries_offset);
+        m_entry_count = header->entry_count;
+        m_strings = reinterpret_cast<const char*>(m_data + header->strings_offset);
+
+        log_info("Mapped asset archive with {} entries: {}", m_entry_count, file_path);
+
+        return true;
+    }
+
+    void game_asset_archive::close() {
+        if (m_data == nullptr) {
+            return;
+        }
+
+#if defined(_WIN32)
+        UnmapViewOfFile(m_data);
+        CloseHandle(static_cast<HANDLE>(m_mapping));
+        CloseHandle(static_cast<HANDLE>(m_file));
+        m_file = nullptr;
+        m_mapping = nullptr;
+#else
+        munmap(const_cast<std::byte*>(m_data), m_size);
+#endif
+
+        m_data = nullptr;
+        m_size = 0;
+        m_entries = nullptr;
+        m_entry_count = 0;
+        m_strings = nullptr;
+    }
+
+    const asset_archive_entry* game_asset_archive::find(std::string_view path) const noexcept {
+        if (m_entries == nullptr) {
+            return nullptr;
+        }
+
+        const asset_archive_entry* end = m_entries + m_entry_count;
+        const asset_archive_entry* it = std::lower_bound(
+            m_entries, end, path, [&](const asset_archive_entry& entry, std::string_view key) {
+                return get_path(entry) < key;
+            });
+
+        return (it != end && get_path(*it) == path) ? it : nullptr;
+    }
+
+    std::span<const std::byte> game_asset_archive::get_data(
+        const asset_archive_entry& entry) const noexcept {
+        return {m_data + entry.data_offset, static_cast<std::size_t>(entry.data_size)};
+    }
+
+    std::string_view game_asset_archive::get_path(
+        const asset_archive_entry& entry) const noexcept {
+        return {m_strings + entry.path_offset, entry.path_size};
+    }
+
+    bool game_asset_archive::validate() const noexcept {
+        if (m_size < sizeof(asset_archive_header)) {
+            return false;
+        }
+
+        const auto* header = reinterpret_cast<const asset_archive_header*>(m_data);
+        if (header->magic != asset_archive_magic || header->version != asset_archive_version) {
+            return false;
+        }
+
+        const std::uint64_t entries_size =
+            static_cast<std::uint64_t>(header->entry_count) * sizeof(asset_archive_entry);
+        if (header->entries_offset % alignof(asset_archive_entry) != 0 ||
+            header->entries_offset > m_size || entries_size > m_size - header->entries_offset ||
+            header->strings_offset > m_size) {
+            return false;
+        }
+
+        // Check every range once here so lookups never have to.
+        const auto* entries =
+            reinterpret_cast<const asset_archive_entry*>(m_data + header->entries_offset);
+        const std::uint64_t strings_size = m_size - header->strings_offset;
+
+        for (std::uint32_t i = 0; i < header->entry_count; ++i) {
+            const asset_archive_entry& entry = entries[i];
+            if (entry.path_offset > strings_size ||
+                entry.path_size > strings_size - entry.path_offset ||
+                entry.data_offset > m_size || entry.data_size > m_size - entry.data_offset) {
+                return false;
+            }
+
+            if (entry.type == asset_archive_entry_type::image_rgba32 &&
+                static_cast<std::uint64_t>(entry.width) * entry.height * 4 != entry.data_size) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+}  // namespace engine
@@ -0,0 +1,132 @@
+/**
+ * @file archive.hxx
+ * @brief Read-only, memory-mapped archive of cooked assets.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace engine {
+    /**
+     * @brief Identifies cooked archives, the bytes "HPAK" read as a little endian integer.
+     */
+    constexpr std::uint32_t asset_archive_magic = 0x4B415048;
+    constexpr std::uint32_t asset_archive_version = 1;
+
+    /**
+     * @brief Alignment of every entry's data within the archive.
+     */
+    constexpr std::uint64_t asset_archive_alignment = 16;
+
+    /**
+     * @brief Where the engine looks for the cooked archive, relative to the working directory
+     * like the loose asset paths.
+     */
+    constexpr std::string_view asset_archive_path_default = "assets.hpak";
+
+    enum class asset_archive_entry_type : std::uint32_t {
+        raw = 0,          ///< File bytes copied as is, such as fonts.
+        image_rgba32 = 1  ///< Pre-decoded RGBA32 pixels, tightly packed rows of `width * 4`.
+    };
+
+    /**
+     * @brief Fixed size header at the start of an archive.
+     */
+    struct asset_archive_header {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint32_t entry_count;
+        std::uint32_t reserved;
+        std::uint64_t entries_offset;  ///< Start of `entry_count` entries sorted by path.
+        std::uint64_t strings_offset;  ///< Start of the path string table.
+    };
+
+    /**
+     * @brief Index entry of a single asset.
+     */
+    struct asset_archive_entry {
+        std::uint64_t path_offset;  ///< Offset of the path, relative to the string table.
+        std::uint64_t data_offset;  ///< Offset of the data, relative to the archive start.
+        std::uint64_t data_size;
+        std::uint32_t path_size;
+        asset_archive_entry_type type;
+        std::uint32_t width;  ///< Image width in pixels, zero for raw entries.
+        std::uint32_t height;
+    };
+
+    static_assert(sizeof(asset_archive_header) == 32, "The header layout is part of the format");
+    static_assert(sizeof(asset_archive_entry) == 40, "The entry layout is part of the format");
+
+    /**
+     * @brief Maps a cooked asset archive into memory and looks up entries by path.
+     *
+     * The archive is produced by the cook tool at build time. Entry data is used straight from
+     * the mapping, so textures upload from the page cache without any decode or copy on the
+     * engine's side.
+     *
+     * @note Paths are stored the way game code requests them, relative to the executable, for
+     * example `assets/space_war/player/default.png`.
+     */
+    class game_asset_archive {
+    public:
+        game_asset_archive() = default;
+        ~game_asset_archive();
+
+        game_asset_archive(const game_asset_archive&) = delete;
+        game_asset_archive& operator=(const game_asset_archive&) = delete;
+        game_asset_archive(game_asset_archive&& other) noexcept;
+        game_asset_archive& operator=(game_asset_archive&& other) noexcept;
+
+        /**
+         * @brief Map an archive file, replacing any archive mapped before.
+         * @return Whether the file exists and holds a valid archive of this version.
+         */
+        [[nodiscard]] bool open(std::string_view file_path);
+        void close();
+
+        /**
+         * @brief Find an entry by its path with a binary search over the sorted index.
+         * @return The entry, or nullptr if the archive is closed or lacks the path.
+         */
+        [[nodiscard]] const asset_archive_entry* find(std::string_view path) const noexcept;
+
+        /**
+         * @brief Get the bytes of an entry, valid for as long as the archive stays open.
+         */
+        [[nodiscard]] std::span<const std::byte> get_data(
+            const asset_archive_entry& entry) const noexcept;
+
+        [[nodiscard]] std::string_view get_path(const asset_archive_entry& entry) const noexcept;
+
+        [[nodiscard]] bool is_open() const noexcept;
+        [[nodiscard]] std::size_t get_entry_count() const noexcept;
+
+    private:
+        [[nodiscard]] bool validate() const noexcept;
+
+    private:
+        const std::byte* m_data = nullptr;
+        std::size_t m_size = 0;
+
+        const asset_archive_entry* m_entries = nullptr;
+        std::size_t m_entry_count = 0;
+        const char* m_strings = nullptr;
+
+#if defined(_WIN32)
+        void* m_file = nullptr;
+        void* m_mapping = nullptr;
+#endif
+    };
+
+    inline bool game_asset_archive::is_open() const noexcept {
+        return m_data != nullptr;
+    }
+
+    inline std::size_t game_asset_archive::get_entry_count() const noexcept {
+        return m_entry_count;
+    }
+}  // namespace engine
@@ -0,0 +1,79 @@
+/**
+ * @file arena.cxx
+ * @brief Linear arena implementation.
+ */
+
+#include "arena.hxx"
+
+#include <algorithm>
+
+#include "../safety.hxx"
+
+namespace engine {
+    game_arena::game_arena(const std::size_t block_size)
+        : m_block_size(std::max<std::size_t>(block_size, 1)),
+          m_blocks(),
+          m_block_index(0),
+          m_block_offset(0),
+          m_stats(),
+          m_stats_last() {
+    }
+
+    void game_arena::reset() noexcept {
+        m_block_index = 0;
+        m_block_offset = 0;
+
+        m_stats_last = m_stats;
+        m_stats = {};
+    }
+
+    std::size_t game_arena::get_capacity() const noexcept {
+        std::size_t capacity = 0;
+        for (const arena_block& block : m_blocks) {
+            capacity += block.size;
+        }
+
+        return capacity;
+    }
+
+    void* game_arena::do_allocate(const std::size_t bytes, const std::size_t alignment) {
+        paranoid_ensure((alignment & (alignment - 1)) == 0, "Alignment must be a power of two");
+
+        m_stats.allocations++;
+        m_stats.bytes += bytes;
+
+        while (true) {
+            if (m_block_index < m_blocks.size()) {
+                arena_block& block = m_blocks[m_block_index];
+
+                // Blocks are only aligned for new, so align the address rather than the offset.
+                const auto base = reinterpret_cast<std::uintptr_t>(block.data.get());
+                const std::uintptr_t address =
+                    (base + m_block_offset + alignment - 1) & ~(std::uintptr_t{alignment} - 1);
+                const std::size_t offset = address - base;
+
+                if (offset + bytes <= block.size) {
+                    m_block_offset = offset + bytes;
+                    return block.data.get() + offset;
+                }
+
+                // Blocks are kept between resets, try the next one before growing.
+                m_block_index++;
+                m_block_offset = 0;
+                continue;
+            }
+
+            const std::size_t block_size = std::max(m_block_size, bytes + alignment);
+            m_blocks.push_back({std::make_unique<std::byte[]>(block_size), block_size});
+            m_stats.blocks_allocated++;
+        }
+    }
+
+    void game_arena::do_deallocate(void*, std::size_t, std::size_t) {
+        // Memory is only given back all at once by `reset`.
+    }
+
+    bool game_arena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+        return this == &other;
+    }
+}  // namespace engine
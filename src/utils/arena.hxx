@@ -0,0 +1,103 @@
+/**
+ * @file arena.hxx
+ * @brief Linear arenas for data that only lives until the end of a frame or a tick.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace engine {
+    /**
+     * @brief Counters of a `game_arena` between two resets.
+     */
+    struct game_arena_stats {
+        std::uint64_t allocations = 0;
+        std::size_t bytes = 0;                ///< Requested bytes, without alignment padding.
+        std::uint64_t blocks_allocated = 0;  ///< Heap allocations made to grow the arena.
+    };
+
+    /**
+     * @brief A bump allocator rewound as a whole, usable as a `std::pmr::memory_resource`.
+     *
+     * Allocating moves an offset forward in the current block, deallocating does nothing and
+     * `reset` makes every block available again. Blocks are kept across resets, so once the
+     * arena has grown to what a frame or a tick needs it never touches the heap again.
+     *
+     * @code
+     * std::pmr::vector<entt::entity> hits(engine->get_frame_arena());
+     * hits.reserve(64);
+     * @endcode
+     *
+     * @note Not thread safe, each arena belongs to the thread of the stage that resets it.
+     * Memory must not be used after the next reset.
+     */
+    class game_arena final : public std::pmr::memory_resource {
+    public:
+        /**
+         * @brief Size of the blocks the arena grows by, larger requests get a block of their own.
+         */
+        static constexpr std::size_t block_size_default = 256 * 1024;
+
+    public:
+        explicit game_arena(std::size_t block_size = block_size_default);
+        ~game_arena() override = default;
+
+        game_arena(const game_arena&) = delete;
+        game_arena& operator=(const game_arena&) = delete;
+        game_arena(game_arena&&) = delete;
+        game_arena& operator=(game_arena&&) = delete;
+
+        /**
+         * @brief Release everything allocated since the last reset, keeping the blocks.
+         */
+        void reset() noexcept;
+
+        /**
+         * @brief Get the counters since the last reset.
+         */
+        [[nodiscard]] const game_arena_stats& get_stats() const noexcept;
+
+        /**
+         * @brief Get the counters of the period the last reset ended, such as the last frame.
+         */
+        [[nodiscard]] const game_arena_stats& get_stats_last() const noexcept;
+
+        /**
+         * @brief Get the total size of the blocks the arena owns.
+         */
+        [[nodiscard]] std::size_t get_capacity() const noexcept;
+
+    private:
+        struct arena_block {
+            std::unique_ptr<std::byte[]> data;
+            std::size_t size;
+        };
+
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+        void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override;
+        [[nodiscard]] bool do_is_equal(
+            const std::pmr::memory_resource& other) const noexcept override;
+
+    private:
+        std::size_t m_block_size;
+        std::vector<arena_block> m_blocks;
+        std::size_t m_block_index;
+        std::size_t m_block_offset;
+
+        game_arena_stats m_stats;
+        game_arena_stats m_stats_last;
+    };
+
+    inline const game_arena_stats& game_arena::get_stats() const noexcept {
+        return m_stats;
+    }
+
+    inline const game_arena_stats& game_arena::get_stats_last() const noexcept {
+        return m_stats_last;
+    }
+}  // namespace engine
@@ -0,0 +1,184 @@
+/**
+ * @file handles.hxx
+ * @brief Generational handles and the slot pool they index into.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace engine {
+    /**
+     * @brief Refers to an object in a `game_handle_pool` by slot index and generation.
+     *
+     * A slot's generation is bumped whenever its object is destroyed, so handles to destroyed
+     * objects stop resolving instead of pointing at whatever reused the slot.
+     */
+    template <class T>
+    struct game_handle {
+        static constexpr std::uint32_t index_invalid = std::numeric_limits<std::uint32_t>::max();
+
+        std::uint32_t index = index_invalid;
+        std::uint32_t generation = 0;
+
+        [[nodiscard]] constexpr bool is_valid() const noexcept;
+
+        constexpr bool operator==(const game_handle&) const noexcept = default;
+    };
+
+    template <class T>
+    constexpr bool game_handle<T>::is_valid() const noexcept {
+        return index != index_invalid;
+    }
+
+    /**
+     * @brief Owns objects in a dense slot array addressed by generational handles.
+     * @note Resolving a handle is an index and a generation compare, it never hashes or
+     * allocates. Freed slots are reused, most recently freed first.
+     */
+    template <class T>
+    class game_handle_pool {
+    public:
+        using handle = game_handle<T>;
+
+        game_handle_pool() = default;
+        ~game_handle_pool() = default;
+
+        game_handle_pool(const game_handle_pool&) = delete;
+        game_handle_pool& operator=(const game_handle_pool&) = delete;
+        game_handle_pool(game_handle_pool&&) noexcept = default;
+        game_handle_pool& operator=(game_handle_pool&&) noexcept = default;
+
+        /**
+         * @brief Take ownership of an object and return the handle that resolves to it.
+         */
+        [[nodiscard]] handle insert(std::unique_ptr<T> value);
+
+        /**
+         * @brief Destroy the object behind a handle, stale or invalid handles are ignored.
+         */
+        void erase(handle h);
+
+        /**
+         * @brief Destroy every object, all previously returned handles become stale.
+         */
+        void clear();
+
+        /**
+         * @brief Resolve a handle.
+         * @return The object, or nullptr if the handle is invalid or its object was destroyed.
+         */
+        [[nodiscard]] T* get(handle h) const noexcept;
+
+        /**
+         * @brief Invoke `callback(T&)` for every live object in slot order.
+         */
+        template <class F>
+        void for_each(F&& callback);
+
+        template <class F>
+        void for_each(F&& callback) const;
+
+        [[nodiscard]] std::size_t get_size() const noexcept;
+
+    private:
+        struct slot {
+            std::unique_ptr<T> value;
+            std::uint32_t generation = 0;
+        };
+
+        std::vector<slot> m_slots;
+        std::vector<std::uint32_t> m_free;
+        std::size_t m_size = 0;
+    };
+
+    template <class T>
+    typename game_handle_pool<T>::handle game_handle_pool<T>::insert(std::unique_ptr<T> value) {
+        std::uint32_t index = 0;
+
+        if (m_free.empty() == false) {
+            index = m_free.back();
+            m_free.pop_back();
+        } else {
+            index = static_cast<std::uint32_t>(m_slots.size());
+            m_slots.emplace_back();
+        }
+
+        m_slots[index].value = std::move(value);
+        ++m_size;
+
+        return handle{index, m_slots[index].generation};
+    }
+
+    template <class T>
+    void game_handle_pool<T>::erase(const handle h) {
+        if (get(h) == nullptr) {
+            return;
+        }
+
+        slot& entry = m_slots[h.index];
+        entry.value.reset();
+        ++entry.generation;
+
+        m_free.push_back(h.index);
+        --m_size;
+    }
+
+    template <class T>
+    void game_handle_pool<T>::clear() {
+        // Slots are kept so their bumped generations keep outstanding handles stale.
+        m_free.clear();
+
+        for (std::size_t i = m_slots.size(); i > 0; --i) {
+            slot& entry = m_slots[i - 1];
+            if (entry.value != nullptr) {
+                entry.value.reset();
+                ++entry.generation;
+            }
+
+            m_free.push_back(static_cast<std::uint32_t>(i - 1));
+        }
+
+        m_size = 0;
+    }
+
+    template <class T>
+    T* game_handle_pool<T>::get(const handle h) const noexcept {
+        if (h.index >= m_slots.size()) {
+            return nullptr;
+        }
+
+        const slot& entry = m_slots[h.index];
+        return (entry.generation == h.generation) ? entry.value.get() : nullptr;
+    }
+
+    template <class T>
+    template <class F>
+    void game_handle_pool<T>::for_each(F&& callback) {
+        for (slot& entry : m_slots) {
+            if (entry.value != nullptr) {
+                callback(*entry.value);
+            }
+        }
+    }
+
+    template <class T>
+    template <class F>
+    void game_handle_pool<T>::for_each(F&& callback) const {
+        for (const slot& entry : m_slots) {
+            if (entry.value != nullptr) {
+                callback(static_cast<const T&>(*entry.value));
+            }
+        }
+    }
+
+    template <class T>
+    std::size_t game_handle_pool<T>::get_size() const noexcept {
+        return m_size;
+    }
+}  // namespace engine
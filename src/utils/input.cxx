@@ -1,15 +1,29 @@
 #include "input.hxx"
 
-#include <unordered_map>
-
 namespace engine {
-    game_input::game_input() : m_mouse_pos(0, 0), m_mouse_delta(0, 0), m_previous_mouse_pos(0, 0) {
+    game_input::game_input()
+        : m_current_keys(),
+          m_previous_keys(),
+          m_pressed_this_frame(),
+          m_released_this_frame(),
+          m_frame_events(),
+          m_event_queue(),
+          m_event_queue_head(0),
+          m_mouse_pos(0, 0),
+          m_mouse_delta(0, 0),
+          m_previous_mouse_pos(0, 0) {
     }
 
     void game_input::update() {
         // Clear frame-specific states
-        m_pressed_this_frame.clear();
-        m_released_this_frame.clear();
+        m_pressed_this_frame.reset();
+        m_released_this_frame.reset();
+        m_frame_events.clear();
+
+        // Drop what was popped last frame so the queue does not creep forward
+        const auto popped = static_cast<std::ptrdiff_t>(m_event_queue_head);
+        m_event_queue.erase(m_event_queue.begin(), m_event_queue.begin() + popped);
+        m_event_queue_head = 0;
 
         // Update mouse delta
         m_mouse_delta = m_mouse_pos - m_previous_mouse_pos;
@@ -22,39 +36,19 @@ namespace engine {
     void game_input::process_sdl_event(const SDL_Event& event) {
         switch (event.type) {
             case SDL_EVENT_KEY_DOWN: {
-                game_input_key k = sdl_key_to_input_key(event.key.scancode);
-                if (k != game_input_key::unknown) {
-                    if (m_current_keys.find(k) == m_current_keys.end()) {
-                        m_pressed_this_frame.insert(k);
-                    }
-                    m_current_keys.insert(k);
-                }
+                key_down(sdl_key_to_input_key(event.key.scancode), event.key.timestamp);
                 break;
             }
             case SDL_EVENT_KEY_UP: {
-                game_input_key k = sdl_key_to_input_key(event.key.scancode);
-                if (k != game_input_key::unknown) {
-                    m_released_this_frame.insert(k);
-                    m_current_keys.erase(k);
-                }
+                key_up(sdl_key_to_input_key(event.key.scancode), event.key.timestamp);
                 break;
             }
             case SDL_EVENT_MOUSE_BUTTON_DOWN: {
-                game_input_key k = sdl_mouse_to_input_key(event.button.button);
-                if (k != game_input_key::unknown) {
-                    if (m_current_keys.find(k) == m_current_keys.end()) {
-                        m_pressed_this_frame.insert(k);
-                    }
-                    m_current_keys.insert(k);
-                }
+                key_down(sdl_mouse_to_input_key(event.button.button), event.button.timestamp);
                 break;
             }
             case SDL_EVENT_MOUSE_BUTTON_UP: {
-                game_input_key k = sdl_mouse_to_input_key(event.button.button);
-                if (k != game_input_key::unknown) {
-                    m_released_this_frame.insert(k);
-                    m_current_keys.erase(k);
-                }
+                key_up(sdl_mouse_to_input_key(event.button.button), event.button.timestamp);
                 break;
             }
             case SDL_EVENT_MOUSE_MOTION: {
@@ -64,6 +58,63 @@ namespace engine {
         }
     }
 
+    std::uint32_t game_input::get_press_count(const game_input_key key) const {
+        std::uint32_t count = 0;
+        for (const game_input_event& event : m_frame_events) {
+            count += (event.key == key && event.state == game_input_state::pressed) ? 1 : 0;
+        }
+
+        return count;
+    }
+
+    bool game_input::event_pop(game_input_event& out, const std::uint64_t timestamp_max) {
+        if (m_event_queue_head >= m_event_queue.size() ||
+            m_event_queue[m_event_queue_head].timestamp_ns > timestamp_max) {
+            return false;
+        }
+
+        out = m_event_queue[m_event_queue_head++];
+        return true;
+    }
+
+    void game_input::key_down(const game_input_key key, const std::uint64_t timestamp_ns) {
+        if (key == game_input_key::unknown) {
+            return;
+        }
+
+        // Key repeats arrive as more down events while the key is already held.
+        const auto bit = static_cast<std::size_t>(key);
+        if (m_current_keys.test(bit) == true) {
+            return;
+        }
+
+        m_current_keys.set(bit);
+        m_pressed_this_frame.set(bit);
+        event_push({key, game_input_state::pressed, timestamp_ns});
+    }
+
+    void game_input::key_up(const game_input_key key, const std::uint64_t timestamp_ns) {
+        if (key == game_input_key::unknown) {
+            return;
+        }
+
+        const auto bit = static_cast<std::size_t>(key);
+        m_current_keys.reset(bit);
+        m_released_this_frame.set(bit);
+        event_push({key, game_input_state::released, timestamp_ns});
+    }
+
+    void game_input::event_push(const game_input_event& event) {
+        m_frame_events.push_back(event);
+
+        // Nobody pops when the game does not use the queue, keep only the newest events then.
+        if (m_event_queue.size() - m_event_queue_head >= event_queue_capacity) {
+            m_event_queue_head++;
+        }
+
+        m_event_queue.push_back(event);
+    }
+
     glm::vec2 game_input::get_movement_wasd() const {
         glm::vec2 movement(0.0f);
 
@@ -7,8 +7,11 @@
 
 #include <SDL3/SDL.h>
 #include <glm/glm.hpp>
-#include <unordered_set>
 #include <array>
+#include <bitset>
+#include <cstdint>
+#include <span>
+#include <vector>
 
 namespace engine {
     /**
@@ -25,6 +28,7 @@ namespace engine {
         o,
         p,
         g,
+        f3,
 
         arrow_up,
         arrow_down,
@@ -51,6 +55,15 @@ namespace engine {
      */
     enum class game_input_state { pressed, held, released };
 
+    /**
+     * @brief A single key or mouse button transition, in the order it reached the game.
+     */
+    struct game_input_event {
+        game_input_key key = game_input_key::unknown;
+        game_input_state state = game_input_state::pressed;  ///< Either pressed or released.
+        std::uint64_t timestamp_ns = 0;  ///< From `SDL_GetTicksNS`, when SDL received the event.
+    };
+
     /**
      * @brief Input system for the game manager.
      */
@@ -68,6 +81,11 @@ namespace engine {
         game_input(game_input&&) = default;
         game_input& operator=(game_input&&) = default;
 
+        /**
+         * @brief Most events kept for `event_pop`, the oldest are dropped beyond this.
+         */
+        static constexpr std::size_t event_queue_capacity = 256;
+
         void update();
         void process_sdl_event(const SDL_Event& event);
 
@@ -75,6 +93,35 @@ namespace engine {
         [[nodiscard]] bool is_key_held(game_input_key key) const;
         [[nodiscard]] bool is_key_released(game_input_key key) const;
 
+        /**
+         * @brief Get how often a key went down this frame, a fast tap may press it repeatedly.
+         */
+        [[nodiscard]] std::uint32_t get_press_count(game_input_key key) const;
+
+        /**
+         * @brief Get this frame's key and button transitions, oldest first.
+         */
+        [[nodiscard]] std::span<const game_input_event> get_events() const;
+
+        /**
+         * @brief Take the oldest queued transition that happened no later than a timestamp.
+         *
+         * Events stay queued across frames until popped, so ticks see every press and release
+         * in order even when a frame runs no tick or a tap starts and ends within one frame.
+         *
+         * @code
+         * engine::game_input_event event;
+         * while (input->event_pop(event, engine->get_tick_timestamp()) == true) {
+         *     // ...
+         * }
+         * @endcode
+         *
+         * @param out Receives the event.
+         * @param timestamp_max Events after this `SDL_GetTicksNS` time stay queued.
+         * @return Whether an event was taken.
+         */
+        bool event_pop(game_input_event& out, std::uint64_t timestamp_max = UINT64_MAX);
+
         // TODO: Need to make an input mapping system for this...
         // but for now it will suffice.
 
@@ -101,11 +148,27 @@ namespace engine {
         constexpr [[nodiscard]] game_input_key sdl_key_to_input_key(SDL_Scancode sdl_key) const;
         constexpr [[nodiscard]] game_input_key sdl_mouse_to_input_key(Uint8 sdl_button) const;
 
+        void key_down(game_input_key key, std::uint64_t timestamp_ns);
+        void key_up(game_input_key key, std::uint64_t timestamp_ns);
+        void event_push(const game_input_event& event);
+
     private:
-        std::unordered_set<game_input_key> m_current_keys;
-        std::unordered_set<game_input_key> m_previous_keys;
-        std::unordered_set<game_input_key> m_pressed_this_frame;
-        std::unordered_set<game_input_key> m_released_this_frame;
+        /**
+         * @brief One bit per key and mouse button, the mouse buttons come last in the enum.
+         */
+        static constexpr std::size_t key_bit_count =
+            static_cast<std::size_t>(game_input_key::mouse_middle) + 1;
+
+        using key_bits = std::bitset<key_bit_count>;
+
+        key_bits m_current_keys;
+        key_bits m_previous_keys;
+        key_bits m_pressed_this_frame;
+        key_bits m_released_this_frame;
+
+        std::vector<game_input_event> m_frame_events;
+        std::vector<game_input_event> m_event_queue;
+        std::size_t m_event_queue_head;  ///< Index of the oldest event not popped yet.
 
         glm::vec2 m_mouse_pos;
         glm::vec2 m_mouse_delta;
@@ -120,6 +183,7 @@ namespace engine {
             std::make_pair(SDL_SCANCODE_O, game_input_key::o),
             std::make_pair(SDL_SCANCODE_P, game_input_key::p),
             std::make_pair(SDL_SCANCODE_G, game_input_key::g),
+            std::make_pair(SDL_SCANCODE_F3, game_input_key::f3),
             std::make_pair(SDL_SCANCODE_UP, game_input_key::arrow_up),
             std::make_pair(SDL_SCANCODE_DOWN, game_input_key::arrow_down),
             std::make_pair(SDL_SCANCODE_LEFT, game_input_key::arrow_left),
@@ -129,15 +193,19 @@ namespace engine {
     };
 
     inline bool game_input::is_key_pressed(game_input_key k) const {
-        return m_pressed_this_frame.find(k) != m_pressed_this_frame.end();
+        return m_pressed_this_frame.test(static_cast<std::size_t>(k));
     }
 
     inline bool game_input::is_key_held(game_input_key k) const {
-        return m_current_keys.find(k) != m_current_keys.end();
+        return m_current_keys.test(static_cast<std::size_t>(k));
     }
 
     inline bool game_input::is_key_released(game_input_key k) const {
-        return m_released_this_frame.find(k) != m_released_this_frame.end();
+        return m_released_this_frame.test(static_cast<std::size_t>(k));
+    }
+
+    inline std::span<const game_input_event> game_input::get_events() const {
+        return m_frame_events;
     }
 
     inline glm::vec2 game_input::get_mouse_position() const {
@@ -0,0 +1,238 @@
+/**
+ * @file jobs.cxx
+ * @brief Work-stealing job pool implementation.
+ */
+
+#include "jobs.hxx"
+
+#include <iterator>
+
+#include <SDL3/SDL.h>
+
+#include "../logger.hxx"
+
+namespace engine {
+    namespace {
+        /**
+         * @brief The pool and queue the current thread works for, unset outside of any pool.
+         */
+        thread_local const game_jobs* t_owner = nullptr;
+        thread_local std::size_t t_queue_index = 0;
+    }  // namespace
+
+    game_jobs::game_jobs(const std::size_t worker_count)
+        : m_queues(),
+          m_workers(),
+          m_sleep_mutex(),
+          m_sleep_condition(),
+          m_queued_count(0),
+          m_completed_count(0),
+          m_is_running(true) {
+        m_queues.reserve(worker_count + 1);
+        for (std::size_t i = 0; i < worker_count + 1; ++i) {
+            m_queues.push_back(std::make_unique<job_queue>());
+        }
+
+        m_workers.reserve(worker_count);
+        for (std::size_t i = 0; i < worker_count; ++i) {
+            m_workers.emplace_back(&game_jobs::worker_main, this, i + 1);
+        }
+
+        log_info("Job pool started with {} worker threads.", worker_count);
+    }
+
+    game_jobs::~game_jobs() {
+        {
+            std::lock_guard lock(m_sleep_mutex);
+            m_is_running.store(false, std::memory_order_release);
+        }
+
+        m_sleep_condition.notify_all();
+
+        for (std::thread& worker : m_workers) {
+            worker.join();
+        }
+    }
+
+    void game_jobs::submit(const job_function function, void* context, const std::size_t begin,
+                           const std::size_t end, game_job_counter& counter) {
+        counter.pending.fetch_add(1, std::memory_order_relaxed);
+
+        job_queue& queue = *m_queues[queue_index_current()];
+        {
+            std::lock_guard lock(queue.mutex);
+            queue.jobs.push_back({function, context, begin, end, &counter});
+        }
+
+        workers_notify(1);
+    }
+
+    void game_jobs::submit_range(const job_function function, void* context,
+                                 const std::size_t count, std::size_t chunk_size,
+                                 game_job_counter& counter) {
+        if (count == 0) {
+            return;
+        }
+
+        chunk_size = std::max<std::size_t>(chunk_size, 1);
+        const std::size_t chunk_count = (count + chunk_size - 1) / chunk_size;
+        counter.pending.fetch_add(static_cast<std::uint32_t>(chunk_count),
+                                  std::memory_order_relaxed);
+
+        job_queue& queue = *m_queues[queue_index_current()];
+        {
+            std::lock_guard lock(queue.mutex);
+
+            // Pushed back to front so the owner pops chunks in ascending index order.
+            for (std::size_t chunk = chunk_count; chunk-- > 0;) {
+                const std::size_t begin = chunk * chunk_size;
+                queue.jobs.push_back(
+                    {function, context, begin, std::min(begin + chunk_size, count), &counter});
+            }
+        }
+
+        workers_notify(chunk_count);
+    }
+
+    void game_jobs::wait(const game_job_counter& counter) {
+        const std::size_t queue_index = queue_index_current();
+
+        while (true) {
+            // Read before the counter, so a job finishing in between changes it and wakes us.
+            const std::uint32_t completed = m_completed_count.load(std::memory_order_acquire);
+            if (counter.is_done() == true) {
+                return;
+            }
+
+            // Only this counter's jobs, anything else queued may block for far longer.
+            job next;
+            if (try_take(queue_index, counter, next) == true) {
+                job_run(next);
+                continue;
+            }
+
+            // The remaining jobs are running on other threads.
+            m_completed_count.wait(completed, std::memory_order_acquire);
+        }
+    }
+
+    std::size_t game_jobs::worker_count_default() noexcept {
+        const int core_count = SDL_GetNumLogicalCPUCores();
+        return core_count > 1 ? static_cast<std::size_t>(core_count - 1) : 0;
+    }
+
+    void game_jobs::worker_main(const std::size_t queue_index) {
+        t_owner = this;
+        t_queue_index = queue_index;
+
+        while (m_is_running.load(std::memory_order_acquire) == true) {
+            if (try_run_one(queue_index) == true) {
+                continue;
+            }
+
+            std::unique_lock lock(m_sleep_mutex);
+            m_sleep_condition.wait(lock, [this] {
+                return m_queued_count.load(std::memory_order_acquire) > 0 ||
+                       m_is_running.load(std::memory_order_acquire) == false;
+            });
+        }
+    }
+
+    void game_jobs::workers_notify(const std::size_t job_count) {
+        m_queued_count.fetch_add(job_count, std::memory_order_release);
+
+        // Taking the lock orders this push against a worker that is about to sleep.
+        { std::lock_guard lock(m_sleep_mutex); }
+
+        if (job_count == 1) {
+            m_sleep_condition.notify_one();
+        } else {
+            m_sleep_condition.notify_all();
+        }
+    }
+
+    std::size_t game_jobs::queue_index_current() const noexcept {
+        return t_owner == this ? t_queue_index : 0;
+    }
+
+    bool game_jobs::try_pop(const std::size_t queue_index, job& out) {
+        job_queue& queue = *m_queues[queue_index];
+        std::lock_guard lock(queue.mutex);
+
+        if (queue.jobs.empty() == true) {
+            return false;
+        }
+
+        out = queue.jobs.back();
+        queue.jobs.pop_back();
+        return true;
+    }
+
+    bool game_jobs::try_steal(const std::size_t queue_index, job& out) {
+        const std::size_t queue_count = m_queues.size();
+
+        for (std::size_t offset = 1; offset < queue_count; ++offset) {
+            job_queue& queue = *m_queues[(queue_index + offset) % queue_count];
+            std::lock_guard lock(queue.mutex);
+
+            if (queue.jobs.empty() == false) {
+                out = queue.jobs.front();
+                queue.jobs.pop_front();
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool game_jobs::try_take(const std::size_t queue_index, const game_job_counter& counter,
+                             job& out) {
+        const std::size_t queue_count = m_queues.size();
+        const auto is_match = [&counter](const job& queued) { return queued.counter == &counter; };
+
+        for (std::size_t offset = 0; offset < queue_count; ++offset) {
+            job_queue& queue = *m_queues[(queue_index + offset) % queue_count];
+            std::lock_guard lock(queue.mutex);
+
+            // Newest first from our own queue like `try_pop`, oldest first like `try_steal`.
+            if (offset == 0) {
+                auto it = std::find_if(queue.jobs.rbegin(), queue.jobs.rend(), is_match);
+                if (it != queue.jobs.rend()) {
+                    out = *it;
+                    queue.jobs.erase(std::next(it).base());
+                    return true;
+                }
+            } else {
+                auto it = std::find_if(queue.jobs.begin(), queue.jobs.end(), is_match);
+                if (it != queue.jobs.end()) {
+                    out = *it;
+                    queue.jobs.erase(it);
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    bool game_jobs::try_run_one(const std::size_t queue_index) {
+        job next;
+        if (try_pop(queue_index, next) == false && try_steal(queue_index, next) == false) {
+            return false;
+        }
+
+        job_run(next);
+
+        return true;
+    }
+
+    void game_jobs::job_run(const job& next) {
+        m_queued_count.fetch_sub(1, std::memory_order_relaxed);
+        next.function(next.context, next.begin, next.end);
+        next.counter->pending.fetch_sub(1, std::memory_order_release);
+
+        // The counter may be gone once it reads zero, so waiters sleep on the pool instead.
+        m_completed_count.fetch_add(1, std::memory_order_release);
+        m_completed_count.notify_all();
+    }
+}  // namespace engine
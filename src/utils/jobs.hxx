@@ -0,0 +1,187 @@
+/**
+ * @file jobs.hxx
+ * @brief Work-stealing job pool owned by the game engine.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace engine {
+    /**
+     * @brief A job entry point, called with its context and the index range it should process.
+     * @note Jobs must not throw, there is nobody on the worker thread to catch the exception.
+     */
+    using job_function = void (*)(void* context, std::size_t begin, std::size_t end);
+
+    /**
+     * @brief Tracks how many submitted jobs are still pending.
+     * @note Must outlive every job submitted with it, usually by waiting on it before it leaves
+     * scope.
+     */
+    struct game_job_counter {
+        std::atomic<std::uint32_t> pending = 0;
+
+        [[nodiscard]] bool is_done() const noexcept;
+    };
+
+    inline bool game_job_counter::is_done() const noexcept {
+        return pending.load(std::memory_order_acquire) == 0;
+    }
+
+    /**
+     * @brief A fixed size pool of worker threads with one job deque each.
+     *
+     * Workers pop from the back of their own deque and steal from the front of the others when
+     * it runs dry, so a thread that splits work keeps the hot, recently pushed chunks while idle
+     * threads take the oldest ones. Threads outside the pool submit into a shared deque, and
+     * waiting on a counter runs that counter's queued jobs instead of blocking, which also makes
+     * nested `parallel_for` calls from inside a job safe. Jobs of other counters are left alone,
+     * so a frame waiting on a short physics pass never picks up a slow file load.
+     */
+    class game_jobs {
+    public:
+        /**
+         * @brief Start the worker threads.
+         * @param worker_count Threads to spawn besides the calling one, zero runs everything
+         * inline on whoever waits.
+         */
+        explicit game_jobs(std::size_t worker_count = worker_count_default());
+        ~game_jobs();
+
+        game_jobs(const game_jobs&) = delete;
+        game_jobs& operator=(const game_jobs&) = delete;
+        game_jobs(game_jobs&&) = delete;
+        game_jobs& operator=(game_jobs&&) = delete;
+
+        /**
+         * @brief Queue a single job.
+         * @param function Entry point of the job.
+         * @param context Opaque pointer handed back to the job, must stay valid until it ran.
+         * @param begin Start of the index range handed to the job.
+         * @param end End of the index range handed to the job.
+         * @param counter Counter incremented now and decremented once the job has run.
+         */
+        void submit(job_function function, void* context, std::size_t begin, std::size_t end,
+                    game_job_counter& counter);
+
+        /**
+         * @brief Split `[0, count)` into chunks of `chunk_size` and queue one job for each.
+         * @param function Entry point called once per chunk.
+         * @param context Opaque pointer handed back to every chunk.
+         * @param count Number of indices to process.
+         * @param chunk_size Indices per job, the last chunk may be shorter.
+         * @param counter Counter tracking every queued chunk.
+         */
+        void submit_range(job_function function, void* context, std::size_t count,
+                          std::size_t chunk_size, game_job_counter& counter);
+
+        /**
+         * @brief Run the counter's queued jobs on the calling thread until every one finished.
+         * @note Sleeps while the remaining jobs run on other threads.
+         */
+        void wait(const game_job_counter& counter);
+
+        /**
+         * @brief Run `function(begin, end)` over `[0, count)` split into chunks across the pool.
+         * @param count Number of indices to process.
+         * @param chunk_size Indices per chunk, a single chunk runs inline without queueing.
+         * @param function Callable invoked with each chunk's index range.
+         * @note Blocks (while helping) until every chunk finished.
+         */
+        template <class F>
+            requires std::is_invocable_v<F&, std::size_t, std::size_t>
+        void parallel_for(std::size_t count, std::size_t chunk_size, F&& function);
+
+        /**
+         * @brief Get the number of worker threads, not counting threads outside the pool.
+         */
+        [[nodiscard]] std::size_t get_worker_count() const noexcept;
+
+        /**
+         * @brief Get one worker per logical core, leaving one for the main thread.
+         */
+        [[nodiscard]] static std::size_t worker_count_default() noexcept;
+
+    private:
+        struct job {
+            job_function function;
+            void* context;
+            std::size_t begin;
+            std::size_t end;
+            game_job_counter* counter;
+        };
+
+        struct job_queue {
+            std::mutex mutex;
+            std::deque<job> jobs;
+        };
+
+        void worker_main(std::size_t queue_index);
+        void workers_notify(std::size_t job_count);
+
+        [[nodiscard]] std::size_t queue_index_current() const noexcept;
+        [[nodiscard]] bool try_pop(std::size_t queue_index, job& out);
+        [[nodiscard]] bool try_steal(std::size_t queue_index, job& out);
+        [[nodiscard]] bool try_run_one(std::size_t queue_index);
+
+        /**
+         * @brief Take a queued job of one counter, searching every queue starting at our own.
+         */
+        [[nodiscard]] bool try_take(std::size_t queue_index, const game_job_counter& counter,
+                                    job& out);
+        void job_run(const job& next);
+
+    private:
+        /**
+         * @brief Queue 0 is shared by threads outside the pool, worker `i` owns queue `i + 1`.
+         */
+        std::vector<std::unique_ptr<job_queue>> m_queues;
+        std::vector<std::thread> m_workers;
+
+        std::mutex m_sleep_mutex;
+        std::condition_variable m_sleep_condition;
+        std::atomic<std::size_t> m_queued_count;
+        std::atomic<std::uint32_t> m_completed_count;  ///< Bumped after every job, for `wait`.
+        std::atomic<bool> m_is_running;
+    };
+
+    template <class F>
+        requires std::is_invocable_v<F&, std::size_t, std::size_t>
+    void game_jobs::parallel_for(const std::size_t count, std::size_t chunk_size, F&& function) {
+        if (count == 0) {
+            return;
+        }
+
+        chunk_size = std::max<std::size_t>(chunk_size, 1);
+        if (m_workers.empty() == true || count <= chunk_size) {
+            function(std::size_t{0}, count);
+            return;
+        }
+
+        using function_type = std::remove_reference_t<F>;
+        const job_function trampoline = [](void* context, std::size_t begin, std::size_t end) {
+            (*static_cast<function_type*>(context))(begin, end);
+        };
+
+        game_job_counter counter;
+        submit_range(trampoline,
+                     const_cast<std::remove_const_t<function_type>*>(std::addressof(function)),
+                     count, chunk_size, counter);
+        wait(counter);
+    }
+
+    inline std::size_t game_jobs::get_worker_count() const noexcept {
+        return m_workers.size();
+    }
+}  // namespace engine
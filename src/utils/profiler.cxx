@@ -0,0 +1,314 @@
+/**
+ * @file profiler.cxx
+ * @brief Frame profiler implementation.
+ */
+
+#include "profiler.hxx"
+
+#include <algorithm>
+#include <format>
+#include <fstream>
+
+#include <SDL3/SDL.h>
+
+#include "../logger.hxx"
+
+namespace engine {
+    namespace {
+        /**
+         * @brief Frame duration the overlay's zone bars span across their full width.
+         */
+        constexpr double overlay_frame_budget_seconds = 1.0 / 30.0;
+
+        /**
+         * @brief Frames slower than this are highlighted in the frame time graph.
+         */
+        constexpr double overlay_frame_target_seconds = 1.0 / 60.0;
+
+        constexpr float overlay_margin = 8.f;
+        constexpr float overlay_width = 640.f;
+        constexpr float overlay_row_height = 14.f;
+        constexpr float overlay_graph_height = 60.f;
+
+        /**
+         * @brief Width of a character of SDL's debug font.
+         */
+        constexpr float overlay_glyph_width = 8.f;
+
+        /**
+         * @brief Pick a stable color per zone name so zones are recognizable between frames.
+         */
+        SDL_Color zone_color(const char* name) {
+            const auto hash = std::hash<std::string_view>{}(name);
+            return {static_cast<Uint8>(80 + (hash & 0x7F)),
+                    static_cast<Uint8>(80 + ((hash >> 8) & 0x7F)),
+                    static_cast<Uint8>(80 + ((hash >> 16) & 0x7F)), 220};
+        }
+
+        void json_append_escaped(std::string& out, std::string_view text) {
+            for (const char c : text) {
+                if (c == '"' || c == '\\') {
+                    out += '\\';
+                }
+
+                out += c;
+            }
+        }
+    }  // namespace
+
+    game_profiler::game_profiler()
+        : m_slots(),
+          m_write_index(0),
+          m_frame(0),
+          m_frame_start(0),
+          m_frame_history(),
+          m_frame_history_next(0),
+          m_names_mutex(),
+          m_names(),
+          m_is_overlay_visible(false) {
+        // Nothing is recorded when profiling is compiled out, so skip the allocation too.
+        if constexpr (should_profile) {
+            m_slots = std::make_unique<record_slot[]>(record_capacity);
+            m_frame_history.assign(frame_history_size, frame_time{0, 0});
+        }
+    }
+
+    game_profiler& game_profiler::get() noexcept {
+        static game_profiler profiler;
+        return profiler;
+    }
+
+    std::uint16_t& game_profiler::thread_depth() noexcept {
+        thread_local std::uint16_t depth = 0;
+        return depth;
+    }
+
+    std::uint16_t game_profiler::thread_index() noexcept {
+        static std::atomic<std::uint16_t> next_index{0};
+        thread_local const std::uint16_t index =
+            next_index.fetch_add(1, std::memory_order_relaxed);
+        return index;
+    }
+
+    void game_profiler::frame_begin() noexcept {
+        if constexpr (should_profile) {
+            const std::uint64_t now = performance_counter_value_current();
+
+            if (m_frame_start != 0) {
+                m_frame_history[m_frame_history_next] = {m_frame_start, now};
+                m_frame_history_next = (m_frame_history_next + 1) % frame_history_size;
+            }
+
+            m_frame_start = now;
+            m_frame.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void game_profiler::record(const char* name, const std::uint64_t start,
+                               const std::uint64_t end, const std::uint16_t depth) noexcept {
+        if constexpr (should_profile) {
+            const std::uint64_t index = m_write_index.fetch_add(1, std::memory_order_relaxed);
+            record_slot& slot = m_slots[index & (record_capacity - 1)];
+
+            // Zero marks the slot as being written, readers skip it until it is published.
+            slot.sequence.store(0, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            slot.record = {name, start, end, m_frame.load(std::memory_order_relaxed),
+                           thread_index(), depth};
+            slot.sequence.store(index + 1, std::memory_order_release);
+        }
+    }
+
+    const char* game_profiler::name_intern(std::string_view name) {
+        const std::lock_guard lock(m_names_mutex);
+
+        for (const std::string& interned : m_names) {
+            if (interned == name) {
+                return interned.c_str();
+            }
+        }
+
+        // A deque never moves its elements, so earlier pointers stay valid.
+        return m_names.emplace_back(name).c_str();
+    }
+
+    bool game_profiler::slot_read(const std::uint64_t index,
+                                  game_profile_record& out) const noexcept {
+        const record_slot& slot = m_slots[index & (record_capacity - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != index + 1) {
+            return false;
+        }
+
+        out = slot.record;
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        // A writer that lapped the ring while copying leaves a different sequence behind.
+        return slot.sequence.load(std::memory_order_relaxed) == index + 1;
+    }
+
+    void game_profiler::frame_records_get(const std::uint32_t frame,
+                                          std::vector<game_profile_record>& out) const {
+        out.clear();
+
+        if constexpr (should_profile) {
+            const std::uint64_t end = m_write_index.load(std::memory_order_acquire);
+            const std::uint64_t begin = (end > record_capacity) ? end - record_capacity : 0;
+
+            game_profile_record record;
+            for (std::uint64_t i = begin; i < end; ++i) {
+                if (slot_read(i, record) == true && record.frame == frame) {
+                    out.push_back(record);
+                }
+            }
+        }
+    }
+
+    bool game_profiler::dump_chrome_trace(std::string_view file_path) const {
+        if constexpr (should_profile == false) {
+            log_warning("Profiling is compiled out, not writing a trace to: {}", file_path);
+            return false;
+        }
+
+        const std::uint64_t end = m_write_index.load(std::memory_order_acquire);
+        const std::uint64_t begin = (end > record_capacity) ? end - record_capacity : 0;
+        const double counts_per_microsecond =
+            static_cast<double>(SDL_GetPerformanceFrequency()) / 1'000'000.0;
+
+        std::vector<game_profile_record> records;
+        records.reserve(static_cast<std::size_t>(end - begin));
+
+        game_profile_record record;
+        for (std::uint64_t i = begin; i < end; ++i) {
+            if (slot_read(i, record) == true) {
+                records.push_back(record);
+            }
+        }
+
+        // Timestamps are relative to the oldest zone so they stay small and precise.
+        std::uint64_t origin = 0;
+        if (records.empty() == false) {
+            origin = std::min_element(records.begin(), records.end(),
+                                      [](const auto& lhs, const auto& rhs) {
+                                          return lhs.start < rhs.start;
+                                      })->start;
+        }
+
+        std::string json = "{\"traceEvents\":[\n";
+        for (std::size_t i = 0; i < records.size(); ++i) {
+            const game_profile_record& zone = records[i];
+
+            json += "{\"name\":\"";
+            json_append_escaped(json, zone.name);
+            json += std::format(
+                "\",\"ph\":\"X\",\"pid\":0,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f},"
+                "\"args\":{{\"frame\":{}}}}}{}\n",
+                zone.thread, static_cast<double>(zone.start - origin) / counts_per_microsecond,
+                static_cast<double>(zone.end - zone.start) / counts_per_microsecond, zone.frame,
+                (i + 1 < records.size()) ? "," : "");
+        }
+        json += "],\"displayTimeUnit\":\"ms\"}\n";
+
+        std::ofstream stream{std::string(file_path), std::ios::binary | std::ios::trunc};
+        if (stream.is_open() == false) {
+            log_error("Failed to open the trace file: {}", file_path);
+            return false;
+        }
+
+        stream.write(json.data(), static_cast<std::streamsize>(json.size()));
+        log_info("Wrote {} profiler zones to: {}", records.size(), file_path);
+
+        return stream.good();
+    }
+
+    void game_profiler::draw_overlay(SDL_Renderer* sdl_renderer) const {
+        if constexpr (should_profile) {
+            if (m_is_overlay_visible == false || sdl_renderer == nullptr) {
+                return;
+            }
+
+            const std::uint32_t frame = get_frame();
+            if (frame < 2) {
+                return;
+            }
+
+            // The current frame is still running, show the last one that finished.
+            std::vector<game_profile_record> records;
+            frame_records_get(frame - 1, records);
+
+            const std::uint16_t main_thread = thread_index();
+            const double frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+            const double pixels_per_count =
+                overlay_width / (overlay_frame_budget_seconds * frequency);
+
+            std::uint64_t frame_start = UINT64_MAX;
+            std::uint16_t depth_max = 0;
+            for (const game_profile_record& zone : records) {
+                if (zone.thread == main_thread) {
+                    frame_start = std::min(frame_start, zone.start);
+                    depth_max = std::max(depth_max, zone.depth);
+                }
+            }
+
+            // Absolute overlay positions, whatever viewport the scene left behind.
+            SDL_SetRenderViewport(sdl_renderer, nullptr);
+            SDL_SetRenderDrawBlendMode(sdl_renderer, SDL_BLENDMODE_BLEND);
+
+            const float graph_top =
+                overlay_margin + static_cast<float>(depth_max + 1) * overlay_row_height +
+                overlay_margin;
+            const SDL_FRect background = {overlay_margin, overlay_margin, overlay_width,
+                                          graph_top + overlay_graph_height - overlay_margin};
+            SDL_SetRenderDrawColor(sdl_renderer, 0, 0, 0, 160);
+            SDL_RenderFillRect(sdl_renderer, &background);
+
+            for (const game_profile_record& zone : records) {
+                if (zone.thread != main_thread || frame_start == UINT64_MAX) {
+                    continue;
+                }
+
+                const SDL_FRect bar = {
+                    overlay_margin +
+                        static_cast<float>(static_cast<double>(zone.start - frame_start) *
+                                           pixels_per_count),
+                    overlay_margin + static_cast<float>(zone.depth) * overlay_row_height,
+                    std::max(1.f, static_cast<float>(static_cast<double>(zone.end - zone.start) *
+                                                     pixels_per_count)),
+                    overlay_row_height - 2.f};
+
+                const SDL_Color color = zone_color(zone.name);
+                SDL_SetRenderDrawColor(sdl_renderer, color.r, color.g, color.b, color.a);
+                SDL_RenderFillRect(sdl_renderer, &bar);
+
+                const std::size_t name_length = std::string_view(zone.name).size();
+                if (static_cast<float>(name_length) * overlay_glyph_width < bar.w) {
+                    SDL_SetRenderDrawColor(sdl_renderer, 0, 0, 0, 255);
+                    SDL_RenderDebugText(sdl_renderer, bar.x + 2.f, bar.y + 2.f, zone.name);
+                }
+            }
+
+            // Frame time graph, newest on the right, a full bar is the whole budget.
+            const float bar_width = overlay_width / static_cast<float>(frame_history_size);
+            for (std::size_t i = 0; i < frame_history_size; ++i) {
+                const frame_time& time =
+                    m_frame_history[(m_frame_history_next + i) % frame_history_size];
+                if (time.end == 0) {
+                    continue;
+                }
+
+                const double seconds = static_cast<double>(time.end - time.start) / frequency;
+                const float height = static_cast<float>(
+                    std::min(1.0, seconds / overlay_frame_budget_seconds) * overlay_graph_height);
+
+                const bool is_over_budget = seconds > overlay_frame_target_seconds;
+                SDL_SetRenderDrawColor(sdl_renderer, is_over_budget ? 230 : 90,
+                                       is_over_budget ? 90 : 200, 90, 220);
+
+                const SDL_FRect bar = {overlay_margin + static_cast<float>(i) * bar_width,
+                                       graph_top + overlay_graph_height - height, bar_width,
+                                       height};
+                SDL_RenderFillRect(sdl_renderer, &bar);
+            }
+        }
+    }
+}  // namespace engine
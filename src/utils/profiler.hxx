@@ -0,0 +1,206 @@
+/**
+ * @file profiler.hxx
+ * @brief Frame profiler with scoped CPU zones, a lock-free record ring and a trace dump.
+ *
+ * Zones are only recorded when the `ENGINE_PROFILE` CMake option is ON. Otherwise every
+ * function in here compiles down to nothing, the same way disabled `log_*` calls do.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "config.hxx"
+#include "timing.hxx"
+
+struct SDL_Renderer;
+
+namespace engine {
+    /**
+     * @brief Where the engine writes the trace of the last frames when its game loop ends.
+     */
+    constexpr std::string_view profile_trace_path_default = "profile_trace.json";
+
+    /**
+     * @brief A finished zone, times are raw performance counter values.
+     */
+    struct game_profile_record {
+        const char* name = nullptr;
+        std::uint64_t start = 0;
+        std::uint64_t end = 0;
+        std::uint32_t frame = 0;
+        std::uint16_t thread = 0;  ///< Small per-thread index, the first recording thread is 0.
+        std::uint16_t depth = 0;   ///< Nesting depth of the zone on its thread.
+    };
+
+    /**
+     * @brief Records zones from any thread into a fixed size ring and keeps a frame history.
+     *
+     * Writers claim a slot with a single atomic increment and publish it through the slot's
+     * sequence number, so recording never locks or allocates. The ring overwrites its oldest
+     * records, readers skip any slot that is rewritten while they copy it.
+     *
+     * @note Zone names are stored by pointer, pass literals or names from `name_intern`.
+     */
+    class game_profiler {
+    public:
+        /**
+         * @brief Number of records kept, a power of two.
+         */
+        static constexpr std::size_t record_capacity = 1 << 14;
+
+        /**
+         * @brief Number of frames kept for the overlay's frame time graph.
+         */
+        static constexpr std::size_t frame_history_size = 240;
+
+    public:
+        game_profiler();
+        ~game_profiler() = default;
+
+        game_profiler(const game_profiler&) = delete;
+        game_profiler& operator=(const game_profiler&) = delete;
+        game_profiler(game_profiler&&) = delete;
+        game_profiler& operator=(game_profiler&&) = delete;
+
+        /**
+         * @brief Close the previous frame and start a new one.
+         * @note Call from the thread running the game loop, the overlay shows its zones.
+         */
+        void frame_begin() noexcept;
+
+        void record(const char* name, std::uint64_t start, std::uint64_t end,
+                    std::uint16_t depth) noexcept;
+
+        /**
+         * @brief Copy a name into storage that lives as long as the profiler.
+         * @return A stable pointer, the same one for equal names.
+         */
+        [[nodiscard]] const char* name_intern(std::string_view name);
+
+        /**
+         * @brief Write every record still in the ring as a Chrome trace.
+         *
+         * The JSON can be opened in `chrome://tracing`, Perfetto, or imported into Tracy with
+         * its `import-chrome` tool.
+         *
+         * @return Whether the file could be written.
+         */
+        bool dump_chrome_trace(std::string_view file_path) const;
+
+        /**
+         * @brief Draw the last finished frame's zones and a frame time graph over the screen.
+         */
+        void draw_overlay(SDL_Renderer* sdl_renderer) const;
+
+        /**
+         * @brief Copy the valid records of a frame, oldest first.
+         */
+        void frame_records_get(std::uint32_t frame, std::vector<game_profile_record>& out) const;
+
+        [[nodiscard]] std::uint32_t get_frame() const noexcept;
+
+        [[nodiscard]] bool is_overlay_visible() const noexcept;
+        void set_overlay_visible(bool is_visible) noexcept;
+
+        /**
+         * @brief Get the profiler shared by the engine and game code.
+         */
+        [[nodiscard]] static game_profiler& get() noexcept;
+
+        /**
+         * @brief Get the calling thread's nesting depth, used by `game_profile_zone`.
+         */
+        [[nodiscard]] static std::uint16_t& thread_depth() noexcept;
+
+    private:
+        struct record_slot {
+            std::atomic<std::uint64_t> sequence{0};  ///< Claimed index plus one once written.
+            game_profile_record record;
+        };
+
+        struct frame_time {
+            std::uint64_t start;
+            std::uint64_t end;
+        };
+
+        [[nodiscard]] static std::uint16_t thread_index() noexcept;
+
+        [[nodiscard]] bool slot_read(std::uint64_t index, game_profile_record& out) const noexcept;
+
+    private:
+        std::unique_ptr<record_slot[]> m_slots;
+        std::atomic<std::uint64_t> m_write_index;
+
+        std::atomic<std::uint32_t> m_frame;
+        std::uint64_t m_frame_start;
+        std::vector<frame_time> m_frame_history;
+        std::size_t m_frame_history_next;
+
+        mutable std::mutex m_names_mutex;
+        std::deque<std::string> m_names;
+
+        bool m_is_overlay_visible;
+    };
+
+    /**
+     * @brief Records the time from its construction to its destruction as a zone.
+     *
+     * @code
+     * void update_enemies() {
+     *     const engine::game_profile_zone zone("update_enemies");
+     *     // ...
+     * }
+     * @endcode
+     */
+    class game_profile_zone {
+    public:
+        explicit game_profile_zone(const char* name) noexcept;
+        ~game_profile_zone();
+
+        game_profile_zone(const game_profile_zone&) = delete;
+        game_profile_zone& operator=(const game_profile_zone&) = delete;
+        game_profile_zone(game_profile_zone&&) = delete;
+        game_profile_zone& operator=(game_profile_zone&&) = delete;
+
+    private:
+        const char* m_name;
+        std::uint64_t m_start;
+    };
+
+    inline game_profile_zone::game_profile_zone(const char* name) noexcept
+        : m_name(name), m_start(0) {
+        if constexpr (should_profile) {
+            game_profiler::thread_depth()++;
+            m_start = performance_counter_value_current();
+        }
+    }
+
+    inline game_profile_zone::~game_profile_zone() {
+        if constexpr (should_profile) {
+            const std::uint64_t end = performance_counter_value_current();
+            const std::uint16_t depth = --game_profiler::thread_depth();
+            game_profiler::get().record(m_name, m_start, end, depth);
+        }
+    }
+
+    inline std::uint32_t game_profiler::get_frame() const noexcept {
+        return m_frame.load(std::memory_order_relaxed);
+    }
+
+    inline bool game_profiler::is_overlay_visible() const noexcept {
+        return m_is_overlay_visible;
+    }
+
+    inline void game_profiler::set_overlay_visible(const bool is_visible) noexcept {
+        m_is_overlay_visible = is_visible;
+    }
+}  // namespace engine
@@ -0,0 +1,235 @@
+/**
+ * @file resource_cache.cxx
+ * @brief Shared resource cache implementation.
+ */
+
+#include "resource_cache.hxx"
+
+#include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+
+#include "../logger.hxx"
+#include "../safety.hxx"
+
+namespace engine {
+    namespace {
+        /**
+         * @brief Estimate the video memory of a texture, as if it were stored as RGBA32.
+         */
+        std::size_t texture_bytes_estimate(SDL_Texture* texture) {
+            float width = 0.f;
+            float height = 0.f;
+            SDL_GetTextureSize(texture, &width, &height);
+
+            return static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4;
+        }
+    }  // namespace
+
+    game_resource_cache::game_resource_cache()
+        : m_mutex(),
+          m_textures(),
+          m_fonts(),
+          m_textures_unused(),
+          m_fonts_unused(),
+          m_texture_budget(texture_budget_default),
+          m_font_budget(font_budget_default),
+          m_stats() {
+    }
+
+    game_resource_cache::~game_resource_cache() {
+        for (const auto& [path, entry] : m_textures) {
+            if (entry.references > 0) {
+                log_warning("Texture still referenced when the cache was destroyed: {}", path);
+            }
+
+            SDL_DestroyTexture(entry.texture);
+        }
+
+        for (const auto& [key, entry] : m_fonts) {
+            if (entry.references > 0) {
+                log_warning("Font still referenced when the cache was destroyed: {}", key);
+            }
+
+            TTF_CloseFont(entry.font);
+        }
+    }
+
+    SDL_Texture* game_resource_cache::texture_acquire(std::string_view path) {
+        const std::lock_guard lock(m_mutex);
+
+        auto it = m_textures.find(path);
+        if (it == m_textures.end()) {
+            m_stats.misses++;
+            return nullptr;
+        }
+
+        entry_reference(it->second, m_textures_unused, m_stats.texture_bytes_unused);
+        m_stats.hits++;
+
+        return it->second.texture;
+    }
+
+    SDL_Texture* game_resource_cache::texture_insert(std::string_view path,
+                                                     SDL_Texture* texture) {
+        paranoid_ensure(texture != nullptr, "Cached textures cannot be null");
+
+        const std::lock_guard lock(m_mutex);
+
+        if (auto it = m_textures.find(path); it != m_textures.end()) {
+            SDL_DestroyTexture(texture);
+            entry_reference(it->second, m_textures_unused, m_stats.texture_bytes_unused);
+            return it->second.texture;
+        }
+
+        const std::size_t bytes = texture_bytes_estimate(texture);
+        m_textures.try_emplace(std::string(path),
+                               texture_entry{texture, bytes, 1, m_textures_unused.end()});
+        m_stats.texture_bytes += bytes;
+
+        // Nothing can be evicted now if the new texture alone fills the budget.
+        textures_trim(m_texture_budget);
+
+        return texture;
+    }
+
+    void game_resource_cache::texture_release(std::string_view path) {
+        const std::lock_guard lock(m_mutex);
+
+        auto it = m_textures.find(path);
+        if (it == m_textures.end()) {
+            return;
+        }
+
+        texture_entry& entry = it->second;
+        paranoid_ensure(entry.references > 0, "Texture released more often than acquired");
+
+        if (--entry.references == 0) {
+            entry.unused = m_textures_unused.insert(m_textures_unused.begin(), it->first);
+            m_stats.texture_bytes_unused += entry.bytes;
+            textures_trim(m_texture_budget);
+        }
+    }
+
+    TTF_Font* game_resource_cache::font_acquire(std::string_view key) {
+        const std::lock_guard lock(m_mutex);
+
+        auto it = m_fonts.find(key);
+        if (it == m_fonts.end()) {
+            m_stats.misses++;
+            return nullptr;
+        }
+
+        entry_reference(it->second, m_fonts_unused, m_stats.font_bytes_unused);
+        m_stats.hits++;
+
+        return it->second.font;
+    }
+
+    TTF_Font* game_resource_cache::font_insert(std::string_view key, TTF_Font* font,
+                                               std::shared_ptr<void> backing,
+                                               const std::size_t bytes) {
+        paranoid_ensure(font != nullptr, "Cached fonts cannot be null");
+
+        const std::lock_guard lock(m_mutex);
+
+        if (auto it = m_fonts.find(key); it != m_fonts.end()) {
+            TTF_CloseFont(font);
+            entry_reference(it->second, m_fonts_unused, m_stats.font_bytes_unused);
+            return it->second.font;
+        }
+
+        m_fonts.try_emplace(std::string(key),
+                            font_entry{font, std::move(backing), bytes, 1, m_fonts_unused.end()});
+        m_stats.font_bytes += bytes;
+
+        fonts_trim(m_font_budget);
+
+        return font;
+    }
+
+    void game_resource_cache::font_release(std::string_view key) {
+        const std::lock_guard lock(m_mutex);
+
+        auto it = m_fonts.find(key);
+        if (it == m_fonts.end()) {
+            return;
+        }
+
+        font_entry& entry = it->second;
+        paranoid_ensure(entry.references > 0, "Font released more often than acquired");
+
+        if (--entry.references == 0) {
+            entry.unused = m_fonts_unused.insert(m_fonts_unused.begin(), it->first);
+            m_stats.font_bytes_unused += entry.bytes;
+            fonts_trim(m_font_budget);
+        }
+    }
+
+    void game_resource_cache::unused_evict() {
+        const std::lock_guard lock(m_mutex);
+
+        textures_trim(0);
+        fonts_trim(0);
+    }
+
+    void game_resource_cache::set_texture_budget(const std::size_t bytes) {
+        const std::lock_guard lock(m_mutex);
+
+        m_texture_budget = bytes;
+        textures_trim(m_texture_budget);
+    }
+
+    void game_resource_cache::set_font_budget(const std::size_t bytes) {
+        const std::lock_guard lock(m_mutex);
+
+        m_font_budget = bytes;
+        fonts_trim(m_font_budget);
+    }
+
+    game_resource_cache_stats game_resource_cache::get_stats() const {
+        const std::lock_guard lock(m_mutex);
+        return m_stats;
+    }
+
+    template <class Entry>
+    void game_resource_cache::entry_reference(Entry& entry, lru_list& unused,
+                                              std::size_t& bytes_unused) noexcept {
+        if (entry.references == 0) {
+            unused.erase(entry.unused);
+            bytes_unused -= entry.bytes;
+        }
+
+        entry.references++;
+    }
+
+    void game_resource_cache::textures_trim(const std::size_t budget) {
+        while (m_stats.texture_bytes > budget && m_textures_unused.empty() == false) {
+            auto it = m_textures.find(m_textures_unused.back());
+            m_textures_unused.pop_back();
+
+            SDL_DestroyTexture(it->second.texture);
+            m_stats.texture_bytes -= it->second.bytes;
+            m_stats.texture_bytes_unused -= it->second.bytes;
+            m_stats.evictions++;
+
+            log_info("Evicted texture: {}", it->first);
+            m_textures.erase(it);
+        }
+    }
+
+    void game_resource_cache::fonts_trim(const std::size_t budget) {
+        while (m_stats.font_bytes > budget && m_fonts_unused.empty() == false) {
+            auto it = m_fonts.find(m_fonts_unused.back());
+            m_fonts_unused.pop_back();
+
+            // The backing memory is released after the font that reads from it is closed.
+            TTF_CloseFont(it->second.font);
+            m_stats.font_bytes -= it->second.bytes;
+            m_stats.font_bytes_unused -= it->second.bytes;
+            m_stats.evictions++;
+
+            log_info("Evicted font: {}", it->first);
+            m_fonts.erase(it);
+        }
+    }
+}  // namespace engine
@@ -0,0 +1,166 @@
+/**
+ * @file resource_cache.hxx
+ * @brief Reference counted textures and fonts shared by every scene's resources.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include "string_map.hxx"
+
+struct SDL_Texture;
+struct TTF_Font;
+
+namespace engine {
+    /**
+     * @brief Counters of a `game_resource_cache`, bytes are estimates of the uploaded data.
+     */
+    struct game_resource_cache_stats {
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+        std::uint64_t evictions = 0;
+
+        std::size_t texture_bytes = 0;
+        std::size_t texture_bytes_unused = 0;
+        std::size_t font_bytes = 0;
+        std::size_t font_bytes_unused = 0;
+    };
+
+    /**
+     * @brief Engine wide store of textures and fonts, counted by the resources that use them.
+     *
+     * Every `game_resources` holds one reference per texture path and font key it loaded.
+     * When the last reference goes, the entry stays resident so a later scene using the same
+     * file gets it without reading or uploading it again. Unused entries are only evicted,
+     * least recently released first, once the resident bytes of their kind exceed the budget.
+     * Entries still referenced are never evicted, the budget can be exceeded by those alone.
+     *
+     * @note Lookups are thread safe, so scenes preloading on another thread can share entries.
+     * Inserting, releasing and budget changes may destroy textures and must happen on the thread
+     * that owns the renderer.
+     */
+    class game_resource_cache {
+    public:
+        /**
+         * @brief Default bytes of textures kept resident, about the video memory of 2 GB devices.
+         */
+        static constexpr std::size_t texture_budget_default = 256 * 1024 * 1024;
+
+        /**
+         * @brief Default bytes of font files kept resident.
+         */
+        static constexpr std::size_t font_budget_default = 32 * 1024 * 1024;
+
+    public:
+        game_resource_cache();
+        ~game_resource_cache();
+
+        game_resource_cache(const game_resource_cache&) = delete;
+        game_resource_cache& operator=(const game_resource_cache&) = delete;
+        game_resource_cache(game_resource_cache&&) = delete;
+        game_resource_cache& operator=(game_resource_cache&&) = delete;
+
+        /**
+         * @brief Take a reference to a resident texture.
+         * @return The texture, or nullptr if the path is not resident.
+         */
+        [[nodiscard]] SDL_Texture* texture_acquire(std::string_view path);
+
+        /**
+         * @brief Hand over a freshly created texture, holding the first reference to it.
+         * @return The resident texture. If the path was made resident meanwhile, the given one is
+         * destroyed and a reference to the existing one is returned instead.
+         */
+        [[nodiscard]] SDL_Texture* texture_insert(std::string_view path, SDL_Texture* texture);
+        void texture_release(std::string_view path);
+
+        /**
+         * @brief Take a reference to a resident font.
+         * @param key Font path and size, as built by `game_resources`.
+         * @return The font, or nullptr if the key is not resident.
+         */
+        [[nodiscard]] TTF_Font* font_acquire(std::string_view key);
+
+        /**
+         * @brief Hand over a freshly opened font, holding the first reference to it.
+         * @param backing Memory the font reads from until it is closed, may be null.
+         * @param bytes Size accounted against the font budget.
+         * @return The resident font, the given one is closed if the key was resident meanwhile.
+         */
+        [[nodiscard]] TTF_Font* font_insert(std::string_view key, TTF_Font* font,
+                                            std::shared_ptr<void> backing, std::size_t bytes);
+        void font_release(std::string_view key);
+
+        /**
+         * @brief Evict every entry nothing references, regardless of the budgets.
+         */
+        void unused_evict();
+
+        void set_texture_budget(std::size_t bytes);
+        [[nodiscard]] std::size_t get_texture_budget() const noexcept;
+
+        void set_font_budget(std::size_t bytes);
+        [[nodiscard]] std::size_t get_font_budget() const noexcept;
+
+        [[nodiscard]] game_resource_cache_stats get_stats() const;
+
+    private:
+        using lru_list = std::list<std::string>;
+
+        struct texture_entry {
+            SDL_Texture* texture;
+            std::size_t bytes;
+            std::uint32_t references;
+            lru_list::iterator unused;  ///< Place among unused textures, valid without references.
+        };
+
+        struct font_entry {
+            TTF_Font* font;
+            std::shared_ptr<void> backing;
+            std::size_t bytes;
+            std::uint32_t references;
+            lru_list::iterator unused;
+        };
+
+        /**
+         * @brief Take a reference to an entry, it is no longer a candidate for eviction.
+         */
+        template <class Entry>
+        void entry_reference(Entry& entry, lru_list& unused, std::size_t& bytes_unused) noexcept;
+
+        /**
+         * @brief Evict the least recently released textures until they fit the budget.
+         * @note Expects the mutex to be held.
+         */
+        void textures_trim(std::size_t budget);
+        void fonts_trim(std::size_t budget);
+
+    private:
+        mutable std::mutex m_mutex;
+
+        string_map<texture_entry> m_textures;
+        string_map<font_entry> m_fonts;
+
+        lru_list m_textures_unused;  ///< Most recently released first.
+        lru_list m_fonts_unused;
+
+        std::size_t m_texture_budget;
+        std::size_t m_font_budget;
+        game_resource_cache_stats m_stats;
+    };
+
+    inline std::size_t game_resource_cache::get_texture_budget() const noexcept {
+        return m_texture_budget;
+    }
+
+    inline std::size_t game_resource_cache::get_font_budget() const noexcept {
+        return m_font_budget;
+    }
+}  // namespace engine
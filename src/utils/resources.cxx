@@ -1,28 +1,45 @@
 #include "resources.hxx"
 
+#include <algorithm>
 #include <stdexcept>
 #include <format>
+#include <span>
 
 #include <SDL3_ttf/SDL_ttf.h>
 #include <SDL3_image/SDL_image.h>
 
 #include "../logger.hxx"
 #include "../safety.hxx"
+#include "timing.hxx"
 
 #include "../renderer/renderer.hxx"
 
 namespace engine {
-    game_resources::game_resources(game_renderer* renderer)
+    game_resources::game_resources(game_renderer* renderer, game_jobs* jobs,
+                                   const game_asset_archive* archive, game_resource_cache* cache)
         : m_textures(),
           m_sprites(),
+          m_sprite_handles(),
           m_fonts(),
           m_static_texts(),
           m_dynamic_texts(),
-          m_renderer(renderer) {
+          m_dynamic_text_handles(),
+          m_font_files(),
+          m_glyph_atlases(),
+          m_atlas_pages(),
+          m_atlas_entries(),
+          m_loads(),
+          m_load_progress(),
+          m_renderer(renderer),
+          m_jobs(jobs),
+          m_archive(archive),
+          m_cache(cache) {
         paranoid_ensure(m_renderer != nullptr, "game_renderer pointer cannot be null");
     }
 
     game_resources::~game_resources() {
+        loads_wait();
+
         texts_clear();
         sprites_clear();
         textures_clear();
@@ -32,14 +49,27 @@ namespace engine {
     game_resources::game_resources(game_resources&& other) noexcept
         : m_textures(std::move(other.m_textures)),
           m_sprites(std::move(other.m_sprites)),
+          m_sprite_handles(std::move(other.m_sprite_handles)),
           m_fonts(std::move(other.m_fonts)),
           m_static_texts(std::move(other.m_static_texts)),
           m_dynamic_texts(std::move(other.m_dynamic_texts)),
-          m_renderer(other.m_renderer) {
+          m_dynamic_text_handles(std::move(other.m_dynamic_text_handles)),
+          m_font_files(std::move(other.m_font_files)),
+          m_glyph_atlases(std::move(other.m_glyph_atlases)),
+          m_atlas_pages(std::move(other.m_atlas_pages)),
+          m_atlas_entries(std::move(other.m_atlas_entries)),
+          m_loads(std::move(other.m_loads)),
+          m_load_progress(other.m_load_progress),
+          m_renderer(other.m_renderer),
+          m_jobs(other.m_jobs),
+          m_archive(other.m_archive),
+          m_cache(other.m_cache) {
     }
 
     game_resources& game_resources::operator=(game_resources&& other) noexcept {
         if (this != &other) {
+            loads_wait();
+
             texts_clear();
             sprites_clear();
             textures_clear();
@@ -48,10 +78,21 @@ namespace engine {
             // Move resources (reference stays the same)
             m_textures = std::move(other.m_textures);
             m_sprites = std::move(other.m_sprites);
+            m_sprite_handles = std::move(other.m_sprite_handles);
             m_fonts = std::move(other.m_fonts);
             m_static_texts = std::move(other.m_static_texts);
             m_dynamic_texts = std::move(other.m_dynamic_texts);
+            m_dynamic_text_handles = std::move(other.m_dynamic_text_handles);
+            m_font_files = std::move(other.m_font_files);
+            m_glyph_atlases = std::move(other.m_glyph_atlases);
+            m_atlas_pages = std::move(other.m_atlas_pages);
+            m_atlas_entries = std::move(other.m_atlas_entries);
+            m_loads = std::move(other.m_loads);
+            m_load_progress = other.m_load_progress;
             m_renderer = other.m_renderer;
+            m_jobs = other.m_jobs;
+            m_archive = other.m_archive;
+            m_cache = other.m_cache;
         }
 
         return *this;
@@ -59,15 +100,14 @@ namespace engine {
 
     game_sprite* game_resources::sprite_get_or_create(std::string_view key,
                                                       std::string_view file_path) {
-        auto it = m_sprites.find(std::string(key));
-        if (it != m_sprites.end()) {
-            return it->second.get();
+        if (auto* sprite = sprite_get(key)) {
+            return sprite;
         }
 
         SDL_Texture* texture = texture_get_or_create(file_path);
         auto sprite = std::make_unique<game_sprite>(file_path, texture);
         auto* sprite_ptr = sprite.get();
-        m_sprites[std::string(key)] = std::move(sprite);
+        m_sprite_handles.insert_or_assign(std::string(key), m_sprites.insert(std::move(sprite)));
 
         log_info("Created sprite: {}", key);
 
@@ -75,47 +115,425 @@ namespace engine {
     }
 
     game_sprite* game_resources::sprite_get(std::string_view key) {
-        auto it = m_sprites.find(std::string(key));
-        return (it != m_sprites.end()) ? it->second.get() : nullptr;
+        return m_sprites.get(sprite_handle_get(key));
+    }
+
+    game_sprite::handle game_resources::sprite_handle_get(std::string_view key) const {
+        auto it = m_sprite_handles.find(key);
+        return (it != m_sprite_handles.end()) ? it->second : game_sprite::handle{};
+    }
+
+    float game_resources::sprite_extent_max() const {
+        float extent = 0.f;
+
+        m_sprites.for_each([&](const game_sprite& sprite) {
+            // The farthest corner bounds the sprite for any rotation around its origin.
+            const glm::vec2 size = sprite.get_size();
+            const glm::vec2 origin = sprite.get_origin();
+            const glm::vec2 reach = glm::max(glm::abs(origin), glm::abs(size - origin));
+            extent = std::max(extent, glm::length(reach));
+        });
+
+        return extent;
+    }
+
+    game_sprite* game_resources::sprite_get_or_create_packed(std::string_view key,
+                                                             std::string_view file_path) {
+        if (auto* sprite = sprite_get(key)) {
+            return sprite;
+        }
+
+        auto entry_it = m_atlas_entries.find(file_path);
+        if (entry_it == m_atlas_entries.end()) {
+            const std::string path(file_path);
+
+            // Cooked images are already RGBA32 and upload straight from the mapping.
+            SDL_Surface* image = nullptr;
+            glm::ivec2 image_size = {0, 0};
+            const void* pixels = nullptr;
+            int pitch = 0;
+
+            const auto* cooked = archive_find(file_path, asset_archive_entry_type::image_rgba32);
+            if (cooked != nullptr) {
+                image_size = {static_cast<int>(cooked->width), static_cast<int>(cooked->height)};
+                pixels = m_archive->get_data(*cooked).data();
+                pitch = image_size.x * 4;
+            } else {
+                SDL_Surface* loaded = IMG_Load(path.c_str());
+                if (loaded == nullptr) {
+                    throw error_message("Failed to load the image at: {}", file_path);
+                }
+
+                // Pages are RGBA32, convert once so the upload is a plain copy.
+                image = SDL_ConvertSurface(loaded, SDL_PIXELFORMAT_RGBA32);
+                SDL_DestroySurface(loaded);
+                if (image == nullptr) {
+                    throw error_message("Failed to convert the image at: {}", file_path);
+                }
+
+                image_size = {image->w, image->h};
+                pixels = image->pixels;
+                pitch = image->pitch;
+            }
+
+            const std::optional<atlas_entry> entry = atlas_insert(image_size);
+            if (entry.has_value() == false) {
+                SDL_DestroySurface(image);
+                log_warning("Image is larger than an atlas page, not packing: {}", file_path);
+                return sprite_get_or_create(key, file_path);
+            }
+
+            const SDL_Rect rect = {entry->position.x, entry->position.y, entry->size.x,
+                                   entry->size.y};
+            SDL_UpdateTexture(m_atlas_pages[entry->page_index].texture, &rect, pixels, pitch);
+            SDL_DestroySurface(image);
+
+            entry_it = m_atlas_entries.try_emplace(path, *entry).first;
+
+            log_info("Packed image into atlas page {}: {}", entry->page_index, file_path);
+        }
+
+        const atlas_entry& entry = entry_it->second;
+        const glm::vec2 page_size = glm::vec2(static_cast<float>(atlas_page_size),
+                                              static_cast<float>(atlas_page_size));
+        const glm::vec2 uv_min = glm::vec2(entry.position) / page_size;
+        const glm::vec2 uv_max = glm::vec2(entry.position + entry.size) / page_size;
+
+        auto sprite = std::make_unique<game_sprite>(
+            file_path, m_atlas_pages[entry.page_index].texture, glm::vec2(entry.size));
+        sprite->set_uv({uv_min.x, uv_min.y, uv_max.x, uv_max.y});
+
+        auto* sprite_ptr = sprite.get();
+        m_sprite_handles.insert_or_assign(std::string(key), m_sprites.insert(std::move(sprite)));
+
+        log_info("Created sprite: {}", key);
+
+        return sprite_ptr;
+    }
+
+    std::optional<game_resources::atlas_entry> game_resources::atlas_insert(
+        const glm::ivec2& size) {
+        // Reserve the padding on the right and bottom, images stay at the reserved corner.
+        const glm::ivec2 reserved = size + atlas_padding;
+        if (reserved.x > atlas_page_size || reserved.y > atlas_page_size) {
+            return std::nullopt;
+        }
+
+        for (std::size_t i = 0; i < m_atlas_pages.size(); ++i) {
+            if (const auto position = m_atlas_pages[i].packer.insert(reserved)) {
+                return atlas_entry{i, *position, size};
+            }
+        }
+
+        SDL_Texture* texture =
+            atlas_page_texture_create(m_renderer->get_sdl_renderer(), atlas_page_size);
+        if (texture == nullptr) {
+            throw error_message("Failed to create an atlas page: {}", SDL_GetError());
+        }
+
+        m_atlas_pages.push_back({texture, game_atlas_packer({atlas_page_size, atlas_page_size})});
+        log_info("Created atlas page {} ({}x{})", m_atlas_pages.size() - 1, atlas_page_size,
+                 atlas_page_size);
+
+        const std::size_t index = m_atlas_pages.size() - 1;
+        const auto position = m_atlas_pages[index].packer.insert(reserved);
+        paranoid_ensure(position.has_value() == true, "An empty atlas page must fit the image");
+
+        return atlas_entry{index, *position, size};
+    }
+
+    void game_resources::atlas_pages_clear() {
+        for (atlas_page& page : m_atlas_pages) {
+            SDL_DestroyTexture(page.texture);
+        }
+
+        if (m_atlas_pages.empty() == false) {
+            log_info("Destroyed {} atlas pages.", m_atlas_pages.size());
+        }
+
+        m_atlas_pages.clear();
+        m_atlas_entries.clear();
     }
 
     void game_resources::sprite_destroy(std::string_view key) {
-        auto it = m_sprites.find(std::string(key));
-        if (it != m_sprites.end()) {
+        auto it = m_sprite_handles.find(key);
+        if (it != m_sprite_handles.end()) {
             log_info("Destroyed sprite: {}", key);
-            m_sprites.erase(it);
+            m_sprites.erase(it->second);
+            m_sprite_handles.erase(it);
+        }
+    }
+
+    game_sprite* game_resources::sprite_get_or_create_async(std::string_view key,
+                                                            std::string_view file_path) {
+        if (auto* sprite = sprite_get(key)) {
+            return sprite;
+        }
+
+        SDL_Texture* texture = texture_find(file_path);
+        if (texture == nullptr) {
+            texture_load_async(file_path);
+        }
+
+        auto sprite = std::make_unique<game_sprite>(file_path, texture);
+        auto* sprite_ptr = sprite.get();
+        m_sprite_handles.insert_or_assign(std::string(key), m_sprites.insert(std::move(sprite)));
+
+        log_info("Created sprite: {}", key);
+
+        return sprite_ptr;
+    }
+
+    void game_resources::texture_load_async(std::string_view file_path) {
+        if (load_find(load_type::texture, file_path) != nullptr ||
+            texture_find(file_path) != nullptr) {
+            return;
+        }
+
+        load_request(load_type::texture, file_path);
+    }
+
+    void game_resources::font_load_async(std::string_view font_path) {
+        if (m_font_files.contains(font_path) == true ||
+            load_find(load_type::font, font_path) != nullptr) {
+            return;
         }
+
+        load_request(load_type::font, font_path);
+    }
+
+    void game_resources::loads_update(const float budget_seconds) {
+        if (m_loads.empty() == true) {
+            return;
+        }
+
+        const std::uint64_t start = performance_counter_value_current();
+
+        for (auto& load : m_loads) {
+            if (load->counter.is_done() == false) {
+                continue;
+            }
+
+            load_finish(*load);
+
+            if (performance_counter_seconds_since(start) >= budget_seconds) {
+                break;
+            }
+        }
+
+        loads_erase_finished();
+    }
+
+    void game_resources::loads_wait() {
+        for (auto& load : m_loads) {
+            load_wait(*load);
+        }
+
+        loads_erase_finished();
+    }
+
+    void game_resources::load_job(void* context, std::size_t, std::size_t) {
+        auto* load = static_cast<pending_load*>(context);
+
+        // Only touches the load itself, the resources are owned by the render thread.
+        switch (load->type) {
+        case load_type::texture:
+            load->surface = IMG_Load(load->path.c_str());
+            break;
+        case load_type::font:
+            load->file_data = SDL_LoadFile(load->path.c_str(), &load->file_size);
+            break;
+        }
+    }
+
+    void game_resources::load_request(const load_type type, std::string_view path) {
+        auto load = std::make_unique<pending_load>();
+        load->type = type;
+        load->path = path;
+
+        // Cooked entries need no decode, the finish step reads them from the mapping.
+        const auto cooked_type = (type == load_type::texture)
+                                     ? asset_archive_entry_type::image_rgba32
+                                     : asset_archive_entry_type::raw;
+        if (archive_find(path, cooked_type) != nullptr) {
+            load->is_cooked = true;
+        } else if (m_jobs != nullptr) {
+            m_jobs->submit(load_job, load.get(), 0, 1, load->counter);
+        } else {
+            load_job(load.get(), 0, 1);
+        }
+
+        m_loads.push_back(std::move(load));
+        m_load_progress.requested++;
+    }
+
+    game_resources::pending_load* game_resources::load_find(const load_type type,
+                                                            std::string_view path) {
+        for (auto& load : m_loads) {
+            if (load->type == type && load->is_finished == false && load->path == path) {
+                return load.get();
+            }
+        }
+
+        return nullptr;
+    }
+
+    void game_resources::load_wait(pending_load& load) {
+        if (load.counter.is_done() == false) {
+            paranoid_ensure(m_jobs != nullptr, "Pending load without a job pool");
+            m_jobs->wait(load.counter);
+        }
+
+        load_finish(load);
+    }
+
+    void game_resources::load_finish(pending_load& load) {
+        if (load.is_finished == true) {
+            return;
+        }
+
+        load.is_finished = true;
+
+        if (load.type == load_type::font) {
+            if (load.is_cooked == true) {
+                m_load_progress.completed++;
+                return;
+            }
+
+            if (load.file_data == nullptr) {
+                log_error("Failed to read font: {}", load.path);
+                m_load_progress.failed++;
+                return;
+            }
+
+            std::shared_ptr<void> data(load.file_data, SDL_free);
+            m_font_files.try_emplace(load.path, font_file{std::move(data), load.file_size});
+            m_load_progress.completed++;
+
+            log_info("Read font file: {}", load.path);
+            return;
+        }
+
+        SDL_Texture* texture = nullptr;
+        if (load.is_cooked == true) {
+            texture = texture_create_archived(load.path);
+        } else if (load.surface != nullptr) {
+            texture = SDL_CreateTextureFromSurface(m_renderer->get_sdl_renderer(), load.surface);
+            SDL_DestroySurface(load.surface);
+            load.surface = nullptr;
+        }
+
+        if (texture == nullptr) {
+            log_error("Failed to load the texture at: {}", load.path);
+            m_load_progress.failed++;
+            return;
+        }
+
+        texture = texture_store(load.path, texture);
+        m_load_progress.completed++;
+
+        // Sprites created while the texture was loading point at its path.
+        m_sprites.for_each([&](game_sprite& sprite) {
+            if (sprite.is_valid() == false && sprite.get_file_path() == load.path) {
+                sprite.set_texture(texture);
+            }
+        });
+
+        log_info("Loaded texture: {}", load.path);
+    }
+
+    void game_resources::loads_erase_finished() {
+        std::erase_if(m_loads, [](const auto& load) { return load->is_finished == true; });
+    }
+
+    const asset_archive_entry* game_resources::archive_find(
+        std::string_view path, const asset_archive_entry_type type) const {
+        if (m_archive == nullptr) {
+            return nullptr;
+        }
+
+        const asset_archive_entry* entry = m_archive->find(path);
+        return (entry != nullptr && entry->type == type) ? entry : nullptr;
+    }
+
+    SDL_Texture* game_resources::texture_create_archived(std::string_view path) {
+        const asset_archive_entry* entry =
+            archive_find(path, asset_archive_entry_type::image_rgba32);
+        if (entry == nullptr) {
+            return nullptr;
+        }
+
+        const int width = static_cast<int>(entry->width);
+        const int height = static_cast<int>(entry->height);
+
+        SDL_Texture* texture = SDL_CreateTexture(m_renderer->get_sdl_renderer(),
+                                                 SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC,
+                                                 width, height);
+        if (texture == nullptr) {
+            return nullptr;
+        }
+
+        SDL_UpdateTexture(texture, nullptr, m_archive->get_data(*entry).data(), width * 4);
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+        return texture;
     }
 
     void game_resources::textures_clear() {
         for (auto& [key, texture] : m_textures) {
-            SDL_DestroyTexture(texture);
+            texture_release(key, texture);
             log_info("Destroyed texture: {}", key);
         }
 
         m_textures.clear();
+
+        atlas_pages_clear();
     }
 
     void game_resources::fonts_clear() {
+        // Atlases rasterize from the fonts, release them first.
+        m_glyph_atlases.clear();
+
         for (auto& [key, font] : m_fonts) {
-            TTF_CloseFont(font);
+            font_release(key, font);
             log_info("Destroyed font: {}", key);
         }
 
         m_fonts.clear();
+
+        // Fonts opened from memory read from these, cached ones hold their own reference.
+        m_font_files.clear();
     }
 
     SDL_Texture* game_resources::texture_get_or_create(std::string_view file_path) {
-        if (is_texture_loaded(file_path) == true) {
-            return m_textures.at(file_path.data());
+        if (SDL_Texture* texture = texture_find(file_path); texture != nullptr) {
+            return texture;
+        }
+
+        // Finish a pending asynchronous load instead of decoding the same file twice.
+        if (pending_load* load = load_find(load_type::texture, file_path); load != nullptr) {
+            load_wait(*load);
+            loads_erase_finished();
+
+            if (auto it = m_textures.find(file_path); it != m_textures.end()) {
+                return it->second;
+            }
+
+            throw error_message("Failed to load the texture at: {}", file_path);
+        }
+
+        // SDL wants a null-terminated path, which a view does not guarantee.
+        std::string path(file_path);
+        SDL_Texture* texture = texture_create_archived(file_path);
+        if (texture == nullptr) {
+            texture = IMG_LoadTexture(m_renderer->get_sdl_renderer(), path.c_str());
         }
 
-        SDL_Texture* texture = IMG_LoadTexture(m_renderer->get_sdl_renderer(), file_path.data());
         if (texture == nullptr) {
             throw error_message("Failed to load the texture at: {}", file_path);
         }
 
-        m_textures[file_path.data()] = texture;
+        texture = texture_store(path, texture);
 
         log_info("Loaded texture: {}", file_path);
 
@@ -123,32 +541,119 @@ namespace engine {
     }
 
     void game_resources::texture_destroy(std::string_view file_path) {
-        auto it = m_textures.find(file_path.data());
+        auto it = m_textures.find(file_path);
         if (it != m_textures.end()) {
-            SDL_DestroyTexture(it->second);
+            texture_release(it->first, it->second);
             log_info("Unloaded texture: {}", file_path);
             m_textures.erase(it);
         }
     }
 
+    SDL_Texture* game_resources::texture_find(std::string_view file_path) {
+        if (auto it = m_textures.find(file_path); it != m_textures.end()) {
+            return it->second;
+        }
+
+        if (m_cache == nullptr) {
+            return nullptr;
+        }
+
+        // Loaded by another scene, or released by one and not evicted yet.
+        SDL_Texture* texture = m_cache->texture_acquire(file_path);
+        if (texture != nullptr) {
+            m_textures.try_emplace(std::string(file_path), texture);
+            log_info("Using cached texture: {}", file_path);
+        }
+
+        return texture;
+    }
+
+    SDL_Texture* game_resources::texture_store(std::string_view file_path,
+                                               SDL_Texture* texture) {
+        // A load that raced another one for the same path already holds this scene's
+        // reference, so the duplicate is dropped rather than referenced a second time.
+        if (auto it = m_textures.find(file_path); it != m_textures.end()) {
+            if (it->second != texture) {
+                SDL_DestroyTexture(texture);
+            }
+
+            return it->second;
+        }
+
+        if (m_cache != nullptr) {
+            texture = m_cache->texture_insert(file_path, texture);
+        }
+
+        m_textures.try_emplace(std::string(file_path), texture);
+
+        return texture;
+    }
+
+    void game_resources::texture_release(std::string_view file_path, SDL_Texture* texture) {
+        if (m_cache != nullptr) {
+            m_cache->texture_release(file_path);
+        } else {
+            SDL_DestroyTexture(texture);
+        }
+    }
+
     bool game_resources::is_texture_loaded(std::string_view file_path) const {
-        return m_textures.contains(file_path.data());
+        return m_textures.contains(file_path);
     }
 
     TTF_Font* game_resources::font_get_or_create(std::string_view font_path, float font_size) {
         std::string unique_key = get_font_unique_key(font_path, font_size);
 
-        if (is_font_loaded(unique_key) == true) {
+        if (auto it = m_fonts.find(unique_key); it != m_fonts.end()) {
             log_info("Using cached font: {}", unique_key);
-            return m_fonts.at(unique_key);
+            return it->second;
+        }
+
+        if (m_cache != nullptr) {
+            if (TTF_Font* font = m_cache->font_acquire(unique_key); font != nullptr) {
+                m_fonts.try_emplace(std::move(unique_key), font);
+                log_info("Using shared font: {} (size: {})", font_path, font_size);
+                return font;
+            }
+        }
+
+        if (pending_load* load = load_find(load_type::font, font_path); load != nullptr) {
+            load_wait(*load);
+            loads_erase_finished();
+        }
+
+        // Cooked fonts stay mapped for the archive's lifetime, so they need no copy to outlive.
+        TTF_Font* font = nullptr;
+        std::shared_ptr<void> backing;
+        std::size_t font_bytes = 0;
+        if (const auto* cooked = archive_find(font_path, asset_archive_entry_type::raw)) {
+            const std::span<const std::byte> data = m_archive->get_data(*cooked);
+            font = TTF_OpenFontIO(SDL_IOFromConstMem(data.data(), data.size()), true, font_size);
+            font_bytes = data.size();
+        } else if (auto it = m_font_files.find(font_path); it != m_font_files.end()) {
+            font = TTF_OpenFontIO(SDL_IOFromConstMem(it->second.data.get(), it->second.size),
+                                  true, font_size);
+            backing = it->second.data;
+            font_bytes = it->second.size;
+        } else {
+            const std::string path(font_path);
+            font = TTF_OpenFont(path.c_str(), font_size);
+
+            SDL_PathInfo info;
+            if (SDL_GetPathInfo(path.c_str(), &info) == true) {
+                font_bytes = static_cast<std::size_t>(info.size);
+            }
         }
 
-        TTF_Font* font = TTF_OpenFont(font_path.data(), font_size);
         if (font == nullptr) {
             throw error_message("Failed to load font: {}", font_path);
         }
 
-        m_fonts[unique_key] = font;
+        if (m_cache != nullptr) {
+            font = m_cache->font_insert(unique_key, font, std::move(backing), font_bytes);
+        }
+
+        m_fonts.try_emplace(std::move(unique_key), font);
 
         log_info("Loaded font: {} (size: {})", font_path, font_size);
 
@@ -156,16 +661,28 @@ namespace engine {
     }
 
     void game_resources::font_destroy(std::string_view unique_key) {
-        auto it = m_fonts.find(unique_key.data());
+        auto it = m_fonts.find(unique_key);
         if (it != m_fonts.end()) {
-            TTF_CloseFont(it->second);
+            if (auto atlas = m_glyph_atlases.find(unique_key); atlas != m_glyph_atlases.end()) {
+                m_glyph_atlases.erase(atlas);
+            }
+
+            font_release(it->first, it->second);
             log_info("Unloaded font: {}", unique_key);
             m_fonts.erase(it);
         }
     }
 
+    void game_resources::font_release(std::string_view unique_key, TTF_Font* font) {
+        if (m_cache != nullptr) {
+            m_cache->font_release(unique_key);
+        } else {
+            TTF_CloseFont(font);
+        }
+    }
+
     bool game_resources::is_font_loaded(std::string_view unique_key) const {
-        return m_fonts.contains(unique_key.data());
+        return m_fonts.contains(unique_key);
     }
 
     std::string game_resources::get_font_unique_key(std::string_view font_path,
@@ -173,11 +690,30 @@ namespace engine {
         return std::format("{}:{}", font_path, font_size);
     }
 
+    game_glyph_atlas* game_resources::glyph_atlas_get_or_create(std::string_view font_path,
+                                                                float font_size) {
+        std::string unique_key = get_font_unique_key(font_path, font_size);
+
+        if (auto it = m_glyph_atlases.find(unique_key); it != m_glyph_atlases.end()) {
+            return it->second.get();
+        }
+
+        // The font is only looked up for a new atlas, which keeps using it afterwards.
+        TTF_Font* font = font_get_or_create(font_path, font_size);
+        auto atlas = std::make_unique<game_glyph_atlas>(m_renderer->get_sdl_renderer(), font);
+        game_glyph_atlas* atlas_ptr = atlas.get();
+        m_glyph_atlases.try_emplace(std::move(unique_key), std::move(atlas));
+
+        log_info("Created glyph atlas: {} (size: {})", font_path, font_size);
+
+        return atlas_ptr;
+    }
+
     game_text_static* game_resources::text_static_get_or_create(std::string_view key,
                                                                 std::string_view text,
                                                                 std::string_view font_path,
                                                                 float font_size) {
-        auto it = m_static_texts.find(std::string(key));
+        auto it = m_static_texts.find(key);
         if (it != m_static_texts.end()) {
             return it->second.get();
         }
@@ -191,7 +727,7 @@ namespace engine {
 
         auto text_obj = std::make_unique<game_text_static>(sdl_text);
         game_text_static* ptr = text_obj.get();
-        m_static_texts[std::string(key)] = std::move(text_obj);
+        m_static_texts.insert_or_assign(std::string(key), std::move(text_obj));
 
         log_info("Created static text resource: {}", key);
         return ptr;
@@ -200,39 +736,36 @@ namespace engine {
                                                                   std::string_view initial_text,
                                                                   std::string_view font_path,
                                                                   float font_size) {
-        auto it = m_dynamic_texts.find(std::string(key));
-        if (it != m_dynamic_texts.end()) {
-            return it->second.get();
+        if (auto* text = text_dynamic_get(key)) {
+            return text;
         }
 
-        TTF_Font* font = font_get_or_create(font_path, font_size);
-        TTF_Text* sdl_text = TTF_CreateText(m_renderer->get_sdl_text_engine(), font,
-                                            initial_text.data(), initial_text.length());
-        if (sdl_text == nullptr) {
-            throw std::runtime_error(std::format("Failed to create dynamic text base: {}", key));
-        }
-
-        auto text_obj = std::make_unique<game_text_dynamic>(std::string(initial_text), sdl_text,
-                                                            m_renderer->get_sdl_renderer(), font);
+        game_glyph_atlas* glyph_atlas = glyph_atlas_get_or_create(font_path, font_size);
+        auto text_obj = std::make_unique<game_text_dynamic>(initial_text, glyph_atlas);
         game_text_dynamic* ptr = text_obj.get();
-        m_dynamic_texts[std::string(key)] = std::move(text_obj);
+        m_dynamic_text_handles.insert_or_assign(std::string(key),
+                                                m_dynamic_texts.insert(std::move(text_obj)));
 
         log_info("Created dynamic text resource: {}", key);
         return ptr;
     }
 
     game_text_static* game_resources::text_static_get(std::string_view key) {
-        auto it = m_static_texts.find(std::string(key));
+        auto it = m_static_texts.find(key);
         return (it != m_static_texts.end()) ? it->second.get() : nullptr;
     }
 
     game_text_dynamic* game_resources::text_dynamic_get(std::string_view key) {
-        auto it = m_dynamic_texts.find(std::string(key));
-        return (it != m_dynamic_texts.end()) ? it->second.get() : nullptr;
+        return m_dynamic_texts.get(text_dynamic_handle_get(key));
+    }
+
+    game_text_dynamic::handle game_resources::text_dynamic_handle_get(std::string_view key) const {
+        auto it = m_dynamic_text_handles.find(key);
+        return (it != m_dynamic_text_handles.end()) ? it->second : game_text_dynamic::handle{};
     }
 
     void game_resources::text_static_destroy(std::string_view key) {
-        auto it = m_static_texts.find(std::string(key));
+        auto it = m_static_texts.find(key);
         if (it != m_static_texts.end()) {
             log_info("Unloaded static text: {}", key);
             m_static_texts.erase(it);
@@ -240,23 +773,26 @@ namespace engine {
     }
 
     void game_resources::text_dynamic_destroy(std::string_view key) {
-        auto it = m_dynamic_texts.find(std::string(key));
-        if (it != m_dynamic_texts.end()) {
+        auto it = m_dynamic_text_handles.find(key);
+        if (it != m_dynamic_text_handles.end()) {
             log_info("Unloaded dynamic text: {}", key);
-            m_dynamic_texts.erase(it);
+            m_dynamic_texts.erase(it->second);
+            m_dynamic_text_handles.erase(it);
         }
     }
 
     void game_resources::sprites_clear() {
-        log_info("Unloading {} sprite resources.", m_sprites.size());
+        log_info("Unloading {} sprite resources.", m_sprites.get_size());
         m_sprites.clear();
+        m_sprite_handles.clear();
     }
 
     void game_resources::texts_clear() {
         log_info("Unloading {} static text resources.", m_static_texts.size());
         m_static_texts.clear();
 
-        log_info("Unloading {} dynamic text resources.", m_dynamic_texts.size());
+        log_info("Unloading {} dynamic text resources.", m_dynamic_texts.get_size());
         m_dynamic_texts.clear();
+        m_dynamic_text_handles.clear();
     }
 }  // namespace engine
@@ -5,22 +5,94 @@
 
 #pragma once
 
-#include <unordered_map>
+#include <cstddef>
 #include <string>
 #include <memory>
+#include <optional>
+#include <vector>
 
 #include "../renderer/sprite.hxx"
 #include "../renderer/text.hxx"
+#include "../renderer/atlas.hxx"
+#include "handles.hxx"
+#include "string_map.hxx"
+#include "jobs.hxx"
+#include "archive.hxx"
+#include "resource_cache.hxx"
+
+struct SDL_Surface;
 
 namespace engine {
     class game_renderer;
 
+    /**
+     * @brief Counters of asynchronous loads requested from a `game_resources`.
+     */
+    struct game_load_progress {
+        std::size_t requested = 0;
+        std::size_t completed = 0;
+        std::size_t failed = 0;
+
+        /**
+         * @brief Get the finished share of all requested loads, failed ones included.
+         * @return A value in [0, 1], 1 when nothing was requested.
+         */
+        [[nodiscard]] float get_fraction() const noexcept;
+        [[nodiscard]] bool is_done() const noexcept;
+    };
+
+    inline float game_load_progress::get_fraction() const noexcept {
+        if (requested == 0) {
+            return 1.f;
+        }
+
+        return static_cast<float>(completed + failed) / static_cast<float>(requested);
+    }
+
+    inline bool game_load_progress::is_done() const noexcept {
+        return completed + failed == requested;
+    }
+
     /**
      * @brief Manages the loading, caching and unloading of game resources.
+     *
+     * The `_async` functions read and decode files on the job pool, then `loads_update` uploads
+     * finished textures on the render thread within a time budget. Until then, sprites created
+     * asynchronously have no texture and the renderer skips them.
+     *
+     * With a `game_resource_cache`, textures and fonts are first looked up there and loaded
+     * ones are handed to it, so resources of different scenes share one copy per file. Each
+     * instance releases its references when it clears or is destroyed. Atlas pages and glyph
+     * atlases stay owned by the instance that created them.
      */
     class game_resources {
     public:
-        explicit game_resources(game_renderer* renderer);
+        /**
+         * @brief Default time per frame that `loads_update` may spend creating textures.
+         */
+        static constexpr float upload_budget_default = 0.002f;
+
+        /**
+         * @brief Width and height of every atlas page in pixels.
+         */
+        static constexpr int atlas_page_size = 2048;
+
+        /**
+         * @brief Transparent gap kept between packed images so filtering does not bleed.
+         */
+        static constexpr int atlas_padding = 1;
+
+    public:
+        /**
+         * @param renderer Renderer that owns the created textures, must stay alive.
+         * @param jobs Pool decoding asynchronous loads, nullptr decodes them on request.
+         * @param archive Cooked assets tried before loose files, nullptr only reads files.
+         * @param cache Textures and fonts shared with other resources, must outlive them. With
+         * nullptr this instance owns everything it loads.
+         */
+        explicit game_resources(game_renderer* renderer, game_jobs* jobs = nullptr,
+                                const game_asset_archive* archive = nullptr,
+                                game_resource_cache* cache = nullptr);
         ~game_resources();
 
         game_resources(const game_resources&) = delete;
@@ -32,6 +104,35 @@ namespace engine {
         game_sprite* sprite_get(std::string_view key);
         void sprite_destroy(std::string_view key);
 
+        /**
+         * @brief Create a sprite whose image is packed into a shared atlas page.
+         * @return The sprite, drawing a sub-rectangle of the page's texture.
+         * @note Sprites on the same page batch into one draw call. Images larger than a page get
+         * their own texture instead. Page space is only reclaimed by `textures_clear`.
+         */
+        game_sprite* sprite_get_or_create_packed(std::string_view key, std::string_view file_path);
+
+        [[nodiscard]] std::size_t get_atlas_page_count() const noexcept;
+
+        /**
+         * @brief Look up the handle of a sprite by key, for caching in components.
+         * @return The sprite's handle, or an invalid handle if no sprite uses this key.
+         */
+        [[nodiscard]] game_sprite::handle sprite_handle_get(std::string_view key) const;
+
+        /**
+         * @brief Resolve a sprite handle without hashing or allocating.
+         * @return The sprite, or nullptr if the handle is invalid or its sprite was destroyed.
+         */
+        [[nodiscard]] game_sprite* sprite_get(game_sprite::handle handle) const noexcept;
+
+        /**
+         * @brief Get the largest distance from any sprite's pivot to one of its corners.
+         * @return The extent in unscaled world units, used to inflate culling queries.
+         * @note Walks every loaded sprite, call it once per frame rather than per entity.
+         */
+        [[nodiscard]] float sprite_extent_max() const;
+
         game_text_static* text_static_get_or_create(std::string_view key,
                                                     std::string_view initial_text,
                                                     std::string_view font_path, float font_size);
@@ -44,29 +145,200 @@ namespace engine {
         game_text_dynamic* text_dynamic_get(std::string_view key);
         void text_dynamic_destroy(std::string_view key);
 
+        /**
+         * @brief Look up the handle of dynamic text by key, for caching in components.
+         * @return The text's handle, or an invalid handle if no dynamic text uses this key.
+         */
+        [[nodiscard]] game_text_dynamic::handle text_dynamic_handle_get(std::string_view key) const;
+
+        /**
+         * @brief Resolve a dynamic text handle without hashing or allocating.
+         * @return The text, or nullptr if the handle is invalid or its text was destroyed.
+         */
+        [[nodiscard]] game_text_dynamic* text_dynamic_get(
+            game_text_dynamic::handle handle) const noexcept;
+
+        /**
+         * @brief Create a sprite right away and load its texture in the background.
+         * @return The sprite, invalid until its texture was uploaded by `loads_update`.
+         * @note Size and origin set before the upload are kept, unset ones come from the image.
+         */
+        game_sprite* sprite_get_or_create_async(std::string_view key, std::string_view file_path);
+
+        /**
+         * @brief Start reading and decoding an image unless it is loaded or already pending.
+         */
+        void texture_load_async(std::string_view file_path);
+
+        /**
+         * @brief Start reading a font file unless it is cached or already pending.
+         * @note Fonts created from the path afterwards open from memory instead of the disk.
+         */
+        void font_load_async(std::string_view font_path);
+
+        /**
+         * @brief Finish decoded loads, must be called on the thread that owns the renderer.
+         * @param budget_seconds Time after which no further texture is created this call, at
+         * least one finished load is always processed so loading cannot stall.
+         */
+        void loads_update(float budget_seconds = upload_budget_default);
+
+        /**
+         * @brief Block until every pending load finished, then process all of them.
+         */
+        void loads_wait();
+
+        [[nodiscard]] const game_load_progress& get_load_progress() const noexcept;
+        [[nodiscard]] bool is_loading() const noexcept;
+
         void textures_clear();
         void fonts_clear();
         void sprites_clear();
         void texts_clear();
 
     private:
+        enum class load_type {
+            texture,
+            font
+        };
+
+        /**
+         * @brief A load handed to the job pool, the job only writes the result fields.
+         */
+        struct pending_load {
+            load_type type;
+            std::string path;
+
+            SDL_Surface* surface = nullptr;
+            void* file_data = nullptr;
+            std::size_t file_size = 0;
+
+            game_job_counter counter;
+            bool is_cooked = false;  ///< Read from the archive, no job was submitted.
+            bool is_finished = false;
+        };
+
+        /**
+         * @brief A font file read into memory, shared with the cached fonts opened from it.
+         */
+        struct font_file {
+            std::shared_ptr<void> data;
+            std::size_t size;
+        };
+
+        struct atlas_page {
+            SDL_Texture* texture;
+            game_atlas_packer packer;
+        };
+
+        /**
+         * @brief Where an image was packed, so packing the same file twice reuses it.
+         */
+        struct atlas_entry {
+            std::size_t page_index;
+            glm::ivec2 position;
+            glm::ivec2 size;
+        };
+
+        /**
+         * @brief Reserve room for an image on the first page that fits, adding one if needed.
+         * @return The placement, or nothing if the image is larger than a page.
+         */
+        [[nodiscard]] std::optional<atlas_entry> atlas_insert(const glm::ivec2& size);
+        void atlas_pages_clear();
+
+        static void load_job(void* context, std::size_t begin, std::size_t end);
+
+        void load_request(load_type type, std::string_view path);
+        [[nodiscard]] pending_load* load_find(load_type type, std::string_view path);
+        void load_wait(pending_load& load);
+        void load_finish(pending_load& load);
+        void loads_erase_finished();
+
+        /**
+         * @brief Find a cooked entry of the given type, nullptr without an archive.
+         */
+        [[nodiscard]] const asset_archive_entry* archive_find(
+            std::string_view path, asset_archive_entry_type type) const;
+
+        /**
+         * @brief Upload a cooked image straight from the mapped archive.
+         * @return The texture, or nullptr if the archive lacks the image.
+         */
+        SDL_Texture* texture_create_archived(std::string_view path);
+
         SDL_Texture* texture_get_or_create(std::string_view file_path);
         void texture_destroy(std::string_view file_path);
+
+        /**
+         * @brief Find a texture this instance holds, or take a reference from the cache.
+         * @return The texture, or nullptr if neither has it.
+         */
+        [[nodiscard]] SDL_Texture* texture_find(std::string_view file_path);
+
+        /**
+         * @brief Keep a created texture, handing it to the cache when there is one.
+         * @return The texture to use, the cache's copy if another instance was faster.
+         */
+        SDL_Texture* texture_store(std::string_view file_path, SDL_Texture* texture);
+        void texture_release(std::string_view file_path, SDL_Texture* texture);
         bool is_texture_loaded(std::string_view file_path) const;
 
         TTF_Font* font_get_or_create(std::string_view font_path, float font_size);
         void font_destroy(std::string_view unique_key);
+        void font_release(std::string_view unique_key, TTF_Font* font);
         bool is_font_loaded(std::string_view unique_key) const;
         std::string get_font_unique_key(std::string_view font_path, float font_size) const;
 
+        /**
+         * @brief Get the glyph cache shared by every dynamic text of a font and size.
+         */
+        game_glyph_atlas* glyph_atlas_get_or_create(std::string_view font_path, float font_size);
+
     private:
-        std::unordered_map<std::string, SDL_Texture*> m_textures;
-        std::unordered_map<std::string, game_sprite::uptr> m_sprites;
+        string_map<SDL_Texture*> m_textures;
+        game_handle_pool<game_sprite> m_sprites;
+        string_map<game_sprite::handle> m_sprite_handles;
+
+        string_map<TTF_Font*> m_fonts;
+        string_map<game_text_static::uptr> m_static_texts;
+        game_handle_pool<game_text_dynamic> m_dynamic_texts;
+        string_map<game_text_dynamic::handle> m_dynamic_text_handles;
+
+        string_map<font_file> m_font_files;
+        string_map<game_glyph_atlas::uptr> m_glyph_atlases;
 
-        std::unordered_map<std::string, TTF_Font*> m_fonts;
-        std::unordered_map<std::string, game_text_static::uptr> m_static_texts;
-        std::unordered_map<std::string, game_text_dynamic::uptr> m_dynamic_texts;
+        std::vector<atlas_page> m_atlas_pages;
+        string_map<atlas_entry> m_atlas_entries;
+
+        std::vector<std::unique_ptr<pending_load>> m_loads;
+        game_load_progress m_load_progress;
 
         game_renderer* m_renderer;
+        game_jobs* m_jobs;
+        const game_asset_archive* m_archive;
+        game_resource_cache* m_cache;
     };
+
+    inline game_sprite* game_resources::sprite_get(
+        const game_sprite::handle handle) const noexcept {
+        return m_sprites.get(handle);
+    }
+
+    inline game_text_dynamic* game_resources::text_dynamic_get(
+        const game_text_dynamic::handle handle) const noexcept {
+        return m_dynamic_texts.get(handle);
+    }
+
+    inline std::size_t game_resources::get_atlas_page_count() const noexcept {
+        return m_atlas_pages.size();
+    }
+
+    inline const game_load_progress& game_resources::get_load_progress() const noexcept {
+        return m_load_progress;
+    }
+
+    inline bool game_resources::is_loading() const noexcept {
+        return m_loads.empty() == false;
+    }
 }  // namespace engine
@@ -5,6 +5,7 @@
 
 #include "scenes.hxx"
 
+#include <algorithm>
 #include <stdexcept>
 
 #include "../safety.hxx"
@@ -13,30 +14,53 @@
 
 namespace engine {
     game_scene::game_scene(std::string_view name, void* state,
-                           const game_scene_callbacks& callbacks, game_engine* engine)
+                           const game_scene_callbacks& callbacks, game_engine* engine,
+                           const std::uint64_t id)
         : m_name(name),
+          m_id(id),
           m_state(state),
           m_callbacks(callbacks),
           m_engine(engine),
-          m_entities(std::make_unique<game_entities>()),
-          m_resources(std::make_unique<game_resources>(engine->get_renderer())),
+          m_entities(std::make_unique<game_entities>(engine->get_jobs())),
+          m_resources(
+              std::make_unique<game_resources>(engine->get_renderer(), engine->get_jobs(),
+                                               engine->get_archive(),
+                                               engine->get_resource_cache())),
           m_cameras(),
           m_viewports() {
         paranoid_ensure(name.empty() != true, "Scene name cannot be empty");
 
-        m_cameras[std::string(game_camera::default_name)] =
-            std::make_unique<game_camera>(game_camera::default_name, glm::vec2{0.0f, 0.0f}, 1.0f);
+        m_cameras.try_emplace(
+            std::string(game_camera::default_name),
+            std::make_unique<game_camera>(game_camera::default_name, glm::vec2{0.0f, 0.0f}, 1.0f));
 
-        m_viewports[std::string(game_viewport::default_name)] = std::make_unique<game_viewport>(
-            game_viewport::default_name, glm::vec2{0.f, 0.f}, glm::vec2{1.f, 1.f});
+        m_viewports.try_emplace(std::string(game_viewport::default_name),
+                                std::make_unique<game_viewport>(game_viewport::default_name,
+                                                                glm::vec2{0.f, 0.f},
+                                                                glm::vec2{1.f, 1.f}));
     }
 
     game_scenes::game_scenes(game_engine* engine)
-        : m_scenes(), m_active_scene_name(), m_engine(engine) {
+        : m_engine(engine),
+          m_scenes(),
+          m_preloads(),
+          m_teardowns(),
+          m_active_scene_name(),
+          m_active_scene(nullptr),
+          m_scene_id_next(1) {
         paranoid_ensure(m_engine != nullptr, "game_engine pointer cannot be null");
     }
 
     game_scenes::~game_scenes() {
+        // Preloads that never finished are dropped, their on_load has not run.
+        for (auto& [name, preload] : m_preloads) {
+            preload->thread.join();
+            log_info("Dropping preloaded scene '{}' during cleanup", name);
+        }
+
+        m_preloads.clear();
+        teardowns_collect(true);
+
         for (auto& [scene_id, scene_info] : m_scenes) {
             log_info("Unloading scene '{}' during cleanup", scene_id);
         }
@@ -46,12 +70,13 @@ namespace engine {
 
     void game_scenes::load_scene(std::string_view name, void* state,
                                  const game_scene_callbacks& callbacks) {
-        if (is_scene_loaded(name) == true) {
+        if (is_scene_loaded(name) == true || is_scene_preloading(name) == true) {
             log_warning("Scene '{}' is already loaded.", name);
             return;
         }
 
-        auto new_scene = std::make_unique<game_scene>(name, state, callbacks, m_engine);
+        auto new_scene = std::make_unique<game_scene>(name, state, callbacks, m_engine,
+                                                      m_scene_id_next++);
         game_scene* scene_ptr = new_scene.get();
         m_scenes.emplace(std::string(name), std::move(new_scene));
 
@@ -60,13 +85,47 @@ namespace engine {
         log_info("Scene '{}' loaded successfully", name);
     }
 
+    void game_scenes::preload_scene(std::string_view name, void* state,
+                                    const game_scene_callbacks& callbacks) {
+        if (is_scene_loaded(name) == true || is_scene_preloading(name) == true) {
+            log_warning("Scene '{}' is already loaded.", name);
+            return;
+        }
+
+        auto preload = std::make_unique<scene_preload>();
+        preload->scene =
+            std::make_unique<game_scene>(name, state, callbacks, m_engine, m_scene_id_next++);
+
+        scene_preload* preload_ptr = preload.get();
+        m_preloads.try_emplace(std::string(name), std::move(preload));
+
+        preload_ptr->thread = std::thread([preload_ptr] {
+            try {
+                const game_profile_zone zone("scene_preload");
+                game_scene* scene = preload_ptr->scene.get();
+                invoke_void(scene->get_callbacks().on_preload, scene);
+            } catch (...) {
+                // Nothing can handle it on this thread, the next collect rethrows it.
+                preload_ptr->exception = std::current_exception();
+            }
+
+            preload_ptr->is_done.store(true, std::memory_order_release);
+        });
+
+        log_info("Scene '{}' preloading in the background", name);
+    }
+
     void game_scenes::unload_scene(std::string_view name) {
+        if (is_scene_preloading(name) == true) {
+            preloads_collect(name);
+        }
+
         if (is_scene_loaded(name) == false) {
             log_warning("Scene '{}' is not loaded.", name);
             return;
         }
 
-        game_scene* scene = m_scenes.at(std::string(name)).get();
+        game_scene* scene = m_scenes.find(name)->second.get();
 
         // If this scene is active, deactivate it first.
         if (is_scene_active() == true && m_active_scene_name == name) {
@@ -80,18 +139,43 @@ namespace engine {
         deactivate_current_scene();
         invoke_void(scene->get_callbacks().on_unload, scene);
 
-        m_scenes.erase(std::string(name));
+        auto it = m_scenes.find(name);
+        std::unique_ptr<game_scene> unloaded = std::move(it->second);
+        m_scenes.erase(it);
+
+        // Destroying a large registry takes a while and touches nothing the main thread uses.
+        auto teardown = std::make_unique<scene_teardown>();
+        teardown->entities = unloaded->entities_release();
+        unloaded.reset();
+
+        scene_teardown* teardown_ptr = teardown.get();
+        m_teardowns.push_back(std::move(teardown));
+
+        teardown_ptr->thread = std::thread([teardown_ptr] {
+            teardown_ptr->entities.reset();
+            teardown_ptr->is_done.store(true, std::memory_order_release);
+        });
 
         log_info("Scene '{}' unloaded successfully", name);
     }
 
+    bool game_scenes::is_scene_ready(std::string_view name) const {
+        auto it = m_scenes.find(name);
+        return it != m_scenes.end() && it->second->get_resources()->is_loading() == false;
+    }
+
     void game_scenes::activate_scene(std::string_view name) {
+        if (is_scene_preloading(name) == true) {
+            log_warning("Scene '{}' activated before it finished preloading, waiting.", name);
+            preloads_collect(name);
+        }
+
         if (is_scene_loaded(name) == false) {
             log_error("Scene '{}' is not loaded. Cannot activate.", name);
             return;
         }
 
-        game_scene* scene = m_scenes.at(std::string(name)).get();
+        game_scene* scene = m_scenes.find(name)->second.get();
 
         if (is_scene_active() == true) {
             if (m_active_scene_name == name) {
@@ -105,6 +189,7 @@ namespace engine {
         invoke_void(scene->get_callbacks().on_activate, scene);
 
         m_active_scene_name = name;
+        m_active_scene = scene;
         update_renderer_for_active_scene();
 
         log_info("Scene '{}' activated successfully", name);
@@ -120,16 +205,33 @@ namespace engine {
         if (it == m_scenes.end()) {
             log_error("Active scene '{}' not found in scene registry", m_active_scene_name);
             m_active_scene_name.clear();
+            m_active_scene = nullptr;
             return;
         }
 
         game_scene* scene = it->second.get();
         invoke_void(scene->get_callbacks().on_deactivate, scene);
         m_active_scene_name.clear();
+        m_active_scene = nullptr;
 
         log_info("Scene deactivated successfully");
     }
 
+    game_load_progress game_scenes::get_load_progress(std::string_view name) const {
+        // Its resources belong to the preload thread, nothing can be read from them yet.
+        if (is_scene_preloading(name) == true) {
+            return {1, 0, 0};
+        }
+
+        auto it = m_scenes.find(name);
+        if (it == m_scenes.end()) {
+            log_warning("Scene '{}' is not loaded.", name);
+            return {};
+        }
+
+        return it->second->get_resources()->get_load_progress();
+    }
+
     void game_scenes::for_each_scene(void (*callback)(std::string_view name,
                                                       const game_scene& scene)) const {
         if (callback == nullptr) {
@@ -149,6 +251,19 @@ namespace engine {
     }
 
     void game_scenes::on_engine_frame(const float frame_interval) {
+        if (m_preloads.empty() == false) {
+            preloads_collect();
+        }
+
+        if (m_teardowns.empty() == false) {
+            teardowns_collect(false);
+        }
+
+        // Inactive scenes keep loading too, so a loading scene can wait on the next one.
+        for (auto& [name, scene] : m_scenes) {
+            scene->get_resources()->loads_update();
+        }
+
         if (game_scene* active_scene = get_active_scene(); active_scene != nullptr) {
             invoke_void(active_scene->get_callbacks().on_frame, active_scene, frame_interval);
         }
@@ -166,6 +281,68 @@ namespace engine {
         }
     }
 
+    void game_scenes::render_packet_write(game_render_packet& packet) {
+        if (game_scene* active_scene = get_active_scene(); active_scene != nullptr) {
+            packet.scene_id = active_scene->get_id();
+            active_scene->get_entities()->render_packet_write(*active_scene->get_resources(),
+                                                              packet);
+        }
+    }
+
+    void game_scenes::render_packet_draw(const game_render_packet& packet) {
+        // Handles from another scene would resolve against the wrong resources. Ids are compared
+        // since a scene loaded after an unload can get the address of the one it replaced.
+        if (game_scene* active_scene = get_active_scene();
+            active_scene != nullptr && active_scene->get_id() == packet.scene_id) {
+            system_render_packet::draw(packet, m_engine->get_renderer(),
+                                       *active_scene->get_resources());
+        }
+    }
+
+    void game_scenes::preloads_collect(std::string_view name) {
+        // One at a time, on_load may start another preload and invalidate the iteration.
+        while (true) {
+            auto it = std::find_if(m_preloads.begin(), m_preloads.end(), [&](const auto& entry) {
+                return entry.first == name ||
+                       entry.second->is_done.load(std::memory_order_acquire) == true;
+            });
+
+            if (it == m_preloads.end()) {
+                return;
+            }
+
+            std::string scene_name = it->first;
+            std::unique_ptr<scene_preload> preload = std::move(it->second);
+            m_preloads.erase(it);
+
+            preload->thread.join();
+            if (preload->exception != nullptr) {
+                log_error("Scene '{}' failed to preload.", scene_name);
+                std::rethrow_exception(preload->exception);
+            }
+
+            game_scene* scene = preload->scene.get();
+            m_scenes.emplace(scene_name, std::move(preload->scene));
+
+            invoke_void(scene->get_callbacks().on_load, scene);
+
+            log_info("Scene '{}' loaded successfully", scene_name);
+        }
+    }
+
+    void game_scenes::teardowns_collect(const bool should_wait) {
+        for (auto it = m_teardowns.begin(); it != m_teardowns.end();) {
+            scene_teardown& teardown = **it;
+            if (should_wait == false && teardown.is_done.load(std::memory_order_acquire) == false) {
+                ++it;
+                continue;
+            }
+
+            teardown.thread.join();
+            it = m_teardowns.erase(it);
+        }
+    }
+
     void game_scenes::update_renderer_for_active_scene() {
         if (game_scene* active_scene = get_active_scene(); active_scene != nullptr) {
             if (game_renderer* renderer = m_engine->get_renderer(); renderer != nullptr) {
@@ -5,15 +5,21 @@
 
 #pragma once
 
-#include <unordered_map>
+#include <atomic>
+#include <cstdint>
+#include <exception>
 #include <string>
 #include <memory>
+#include <thread>
 #include <type_traits>
+#include <vector>
 
 #include "resources.hxx"
+#include "string_map.hxx"
 #include "../ecs/entities.hxx"
 #include "../renderer/camera.hxx"
 #include "../renderer/viewport.hxx"
+#include "../renderer/render_packet.hxx"
 
 namespace engine {
     class game_scene;
@@ -22,6 +28,12 @@ namespace engine {
      * @brief Callbacks for hooking into the game scene lifecycle.
      */
     struct game_scene_callbacks {
+        /**
+         * @brief Called on a background thread by `game_scenes::preload_scene`, before `on_load`.
+         * @note Only build entities and request `_async` loads here, the scene is not visible to
+         * the engine yet but the renderer is in use by the main thread.
+         */
+        void (*on_preload)(game_scene* scene) = nullptr;
         void (*on_load)(game_scene* scene) = nullptr;
         void (*on_unload)(game_scene* scene) = nullptr;
         void (*on_activate)(game_scene* scene) = nullptr;
@@ -36,16 +48,15 @@ namespace engine {
 
     /**
      * @brief Represents a single scene with its own state managed by the engine.
-     *
-     * @todo Refactor cameras and viewports to use std::vector:
-     *      - Both of the classes already store their names as fields.
-     *      - No unnecessary string allocations for keys in std::unorderdered_map.
      */
     class game_scene {
     public:
         game_scene() = delete;
+        /**
+         * @param id Unique among every scene the engine created, see `get_id`.
+         */
         game_scene(std::string_view name, void* state, const game_scene_callbacks& callbacks,
-                   game_engine* engine);
+                   game_engine* engine, std::uint64_t id);
         ~game_scene() = default;
 
         game_scene(const game_scene&) = default;
@@ -55,6 +66,12 @@ namespace engine {
 
         [[nodiscard]] std::string_view get_name() const;
 
+        /**
+         * @brief Get the id the scene was created with, never reused by a later scene.
+         * @note Unlike the scene's address, which a scene loaded after unloading it may get.
+         */
+        [[nodiscard]] std::uint64_t get_id() const noexcept;
+
         /**
          * @brief Get the scene-specific state as the specified type.
          * @tparam T The type to cast the scene state to. Must be a class type.
@@ -72,8 +89,15 @@ namespace engine {
         [[nodiscard]] game_camera* get_camera(std::string_view name);
         [[nodiscard]] game_viewport* get_viewport(std::string_view name);
 
+        /**
+         * @brief Hand over the entities, so they can be destroyed away from the main thread.
+         * @note The scene must not be used afterwards except for destroying it.
+         */
+        [[nodiscard]] std::unique_ptr<game_entities> entities_release() noexcept;
+
     private:
         std::string m_name;
+        std::uint64_t m_id;
 
         void* m_state;
         game_scene_callbacks m_callbacks;
@@ -81,14 +105,18 @@ namespace engine {
 
         std::unique_ptr<game_entities> m_entities;
         std::unique_ptr<game_resources> m_resources;
-        std::unordered_map<std::string, std::unique_ptr<game_camera>> m_cameras;
-        std::unordered_map<std::string, std::unique_ptr<game_viewport>> m_viewports;
+        string_map<std::unique_ptr<game_camera>> m_cameras;
+        string_map<std::unique_ptr<game_viewport>> m_viewports;
     };
 
     inline std::string_view game_scene::get_name() const {
         return m_name;
     }
 
+    inline std::uint64_t game_scene::get_id() const noexcept {
+        return m_id;
+    }
+
     template <class T>
         requires std::is_class_v<T>
     T* game_scene::get_state() noexcept {
@@ -111,8 +139,12 @@ namespace engine {
         return m_resources.get();
     }
 
+    inline std::unique_ptr<game_entities> game_scene::entities_release() noexcept {
+        return std::move(m_entities);
+    }
+
     inline game_camera* game_scene::get_camera(std::string_view name) {
-        auto it = m_cameras.find(std::string{name});
+        auto it = m_cameras.find(name);
         if (it != m_cameras.end()) {
             return it->second.get();
         }
@@ -121,7 +153,7 @@ namespace engine {
     }
 
     inline game_viewport* game_scene::get_viewport(std::string_view name) {
-        auto it = m_viewports.find(std::string{name});
+        auto it = m_viewports.find(name);
         if (it != m_viewports.end()) {
             return it->second.get();
         }
@@ -143,9 +175,38 @@ namespace engine {
         game_scenes& operator=(game_scenes&&) = delete;
 
         void load_scene(std::string_view name, void* state, const game_scene_callbacks& callbacks);
+
+        /**
+         * @brief Build a scene on a background thread while the active scene keeps running.
+         *
+         * `on_preload` runs on its own thread, off the job pool so it never stalls a frame that
+         * waits on jobs. Once it returned, the next frame adds the scene as if by `load_scene`
+         * and runs `on_load` on the main thread. Loads it requested keep advancing each frame,
+         * `is_scene_ready` tells when activating it is a plain swap.
+         *
+         * @note Activating or unloading the scene before then waits for `on_preload`.
+         */
+        void preload_scene(std::string_view name, void* state,
+                           const game_scene_callbacks& callbacks);
+
+        /**
+         * @brief Unload a scene, destroying its entities on a background thread.
+         * @note Resources are still released here, textures belong to the main thread.
+         */
         void unload_scene(std::string_view name);
         [[nodiscard]] bool is_scene_loaded(std::string_view name) const;
+        [[nodiscard]] bool is_scene_preloading(std::string_view name) const;
+
+        /**
+         * @brief Check whether a scene is loaded and none of its asynchronous loads is pending.
+         */
+        [[nodiscard]] bool is_scene_ready(std::string_view name) const;
 
+        /**
+         * @brief Make a scene the active one.
+         * @note Waits for the scene if it is still preloading. Assets still loading show up as
+         * they finish, check `is_scene_ready` first for a seamless switch.
+         */
         void activate_scene(std::string_view name);
         void deactivate_current_scene();
 
@@ -153,6 +214,13 @@ namespace engine {
         [[nodiscard]] std::string_view get_active_scene_name() const;
         [[nodiscard]] game_scene* get_active_scene();
 
+        /**
+         * @brief Get the asynchronous load progress of a loaded scene's resources.
+         * @note Loads of every loaded scene are advanced each frame, so a loading scene can poll
+         * this for the scene it is about to activate. Reports nothing done while preloading.
+         */
+        [[nodiscard]] game_load_progress get_load_progress(std::string_view name) const;
+
         void for_each_scene(void (*callback)(std::string_view name, const game_scene& scene)) const;
 
         void on_engine_tick(float tick_interval);
@@ -160,18 +228,73 @@ namespace engine {
         void on_engine_draw(float fraction_to_next_tick);
         void on_engine_input();
 
+        /**
+         * @brief Snapshot the active scene's entities, an empty packet without one.
+         * @note Runs on the simulation thread in threaded mode.
+         */
+        void render_packet_write(game_render_packet& packet);
+
+        /**
+         * @brief Draw a packet, unless it was written by a scene that is no longer active.
+         */
+        void render_packet_draw(const game_render_packet& packet);
+
     private:
+        /**
+         * @brief A scene whose `on_preload` runs on `thread`, owned by nobody else until done.
+         */
+        struct scene_preload {
+            std::unique_ptr<game_scene> scene;
+            std::thread thread;
+            std::atomic<bool> is_done = false;
+            std::exception_ptr exception;
+        };
+
+        /**
+         * @brief Entities of an unloaded scene being destroyed on `thread`.
+         */
+        struct scene_teardown {
+            std::unique_ptr<game_entities> entities;
+            std::thread thread;
+            std::atomic<bool> is_done = false;
+        };
+
         void update_renderer_for_active_scene();
         void reset_renderer_to_global();
 
+        /**
+         * @brief Add preloaded scenes whose thread finished, or wait for one by name.
+         * @param name Scene to wait for, empty to only collect the finished ones.
+         * @throws Rethrows what `on_preload` threw, on the main thread.
+         */
+        void preloads_collect(std::string_view name = {});
+
+        /**
+         * @brief Join teardown threads that finished, or all of them.
+         */
+        void teardowns_collect(bool should_wait);
+
     private:
         game_engine* m_engine;
-        std::unordered_map<std::string, std::unique_ptr<game_scene>> m_scenes;
+        string_map<std::unique_ptr<game_scene>> m_scenes;
+        string_map<std::unique_ptr<scene_preload>> m_preloads;
+        std::vector<std::unique_ptr<scene_teardown>> m_teardowns;
         std::string m_active_scene_name;
+
+        /**
+         * @brief Cached on activation so the per-frame callbacks skip the name lookup.
+         */
+        game_scene* m_active_scene;
+
+        std::uint64_t m_scene_id_next;  ///< Id of the next scene loaded or preloaded.
     };
 
     inline bool game_scenes::is_scene_loaded(std::string_view name) const {
-        return m_scenes.contains(std::string(name));
+        return m_scenes.contains(name);
+    }
+
+    inline bool game_scenes::is_scene_preloading(std::string_view name) const {
+        return m_preloads.contains(name);
     }
 
     inline bool game_scenes::is_scene_active() const {
@@ -183,15 +306,6 @@ namespace engine {
     }
 
     inline game_scene* game_scenes::get_active_scene() {
-        if (is_scene_active() == false) {
-            return nullptr;
-        }
-
-        auto it = m_scenes.find(std::string(m_active_scene_name));
-        if (it != m_scenes.end()) {
-            return it->second.get();
-        }
-
-        return nullptr;
+        return m_active_scene;
     }
 }  // namespace engine
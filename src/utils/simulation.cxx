@@ -0,0 +1,98 @@
+/**
+ * @file simulation.cxx
+ * @brief Simulation thread implementation.
+ */
+
+#include "simulation.hxx"
+
+#include <utility>
+
+#include "../logger.hxx"
+#include "../safety.hxx"
+#include "profiler.hxx"
+
+namespace engine {
+    game_simulation_thread::game_simulation_thread(const batch_function function, void* context)
+        : m_function(function),
+          m_context(context),
+          m_mutex(),
+          m_condition(),
+          m_is_busy(false),
+          m_is_stopping(false),
+          m_tick_count(0),
+          m_fraction_to_next_tick(0.f),
+          m_exception(),
+          m_thread(&game_simulation_thread::worker_main, this) {
+        paranoid_ensure(m_function != nullptr, "Simulation batch function cannot be null");
+        log_info("Simulation thread started.");
+    }
+
+    game_simulation_thread::~game_simulation_thread() {
+        {
+            const std::lock_guard lock(m_mutex);
+            m_is_stopping = true;
+        }
+
+        m_condition.notify_all();
+        m_thread.join();
+
+        log_info("Simulation thread stopped.");
+    }
+
+    void game_simulation_thread::run_async(const std::uint32_t tick_count,
+                                           const float fraction_to_next_tick) {
+        {
+            const std::lock_guard lock(m_mutex);
+            paranoid_ensure(m_is_busy == false, "Previous simulation batch was not waited on");
+
+            m_tick_count = tick_count;
+            m_fraction_to_next_tick = fraction_to_next_tick;
+            m_is_busy = true;
+        }
+
+        m_condition.notify_all();
+    }
+
+    void game_simulation_thread::wait() {
+        std::exception_ptr exception;
+
+        {
+            std::unique_lock lock(m_mutex);
+            m_condition.wait(lock, [this] { return m_is_busy == false; });
+            exception = std::exchange(m_exception, nullptr);
+        }
+
+        if (exception != nullptr) {
+            std::rethrow_exception(exception);
+        }
+    }
+
+    void game_simulation_thread::worker_main() {
+        std::unique_lock lock(m_mutex);
+
+        while (true) {
+            m_condition.wait(lock, [this] { return m_is_busy == true || m_is_stopping == true; });
+            if (m_is_stopping == true) {
+                return;
+            }
+
+            const std::uint32_t tick_count = m_tick_count;
+            const float fraction_to_next_tick = m_fraction_to_next_tick;
+            lock.unlock();
+
+            std::exception_ptr exception;
+            try {
+                const game_profile_zone zone("simulation");
+                m_function(m_context, tick_count, fraction_to_next_tick);
+            } catch (...) {
+                // Nothing can handle it on this thread, hand it to whoever waits.
+                exception = std::current_exception();
+            }
+
+            lock.lock();
+            m_exception = exception;
+            m_is_busy = false;
+            m_condition.notify_all();
+        }
+    }
+}  // namespace engine
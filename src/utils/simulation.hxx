@@ -0,0 +1,71 @@
+/**
+ * @file simulation.hxx
+ * @brief Dedicated thread the engine runs fixed ticks on in threaded simulation mode.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace engine {
+    /**
+     * @brief Runs a batch of ticks on its own thread while the caller draws the previous batch.
+     *
+     * The caller hands over work with `run_async` and synchronizes with `wait`. Between the
+     * two the worker owns all simulation state, after `wait` returns the caller does, so state
+     * shared with the ticks never needs a lock of its own.
+     */
+    class game_simulation_thread {
+    public:
+        /**
+         * @brief Batch entry point, called on the worker thread.
+         * @param context Opaque pointer given to the constructor.
+         * @param tick_count Ticks to run in this batch, possibly zero.
+         * @param fraction_to_next_tick Interpolation factor once the batch has run.
+         */
+        using batch_function = void (*)(void* context, std::uint32_t tick_count,
+                                        float fraction_to_next_tick);
+
+    public:
+        game_simulation_thread(batch_function function, void* context);
+        ~game_simulation_thread();
+
+        game_simulation_thread(const game_simulation_thread&) = delete;
+        game_simulation_thread& operator=(const game_simulation_thread&) = delete;
+        game_simulation_thread(game_simulation_thread&&) = delete;
+        game_simulation_thread& operator=(game_simulation_thread&&) = delete;
+
+        /**
+         * @brief Start a batch on the worker.
+         * @note The previous batch must have been waited on.
+         */
+        void run_async(std::uint32_t tick_count, float fraction_to_next_tick);
+
+        /**
+         * @brief Block until the running batch finished.
+         * @throws Rethrows whatever the batch threw, on the calling thread.
+         */
+        void wait();
+
+    private:
+        void worker_main();
+
+    private:
+        batch_function m_function;
+        void* m_context;
+
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        bool m_is_busy;
+        bool m_is_stopping;
+        std::uint32_t m_tick_count;
+        float m_fraction_to_next_tick;
+        std::exception_ptr m_exception;
+
+        std::thread m_thread;  ///< Declared last so it starts after everything it reads.
+    };
+}  // namespace engine
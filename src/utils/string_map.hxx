@@ -0,0 +1,37 @@
+/**
+ * @file string_map.hxx
+ * @brief String keyed hash map that can be probed with string views.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace engine {
+    /**
+     * @brief Transparent string hash, hashes `std::string`, views and literals the same way.
+     */
+    struct string_hash {
+        using is_transparent = void;
+
+        [[nodiscard]] std::size_t operator()(std::string_view value) const noexcept;
+    };
+
+    inline std::size_t string_hash::operator()(std::string_view value) const noexcept {
+        return std::hash<std::string_view>{}(value);
+    }
+
+    /**
+     * @brief Hash map keyed by owned strings whose `find`, `contains` and `count` accept a
+     * `std::string_view` without allocating a temporary key.
+     * @note `operator[]`, `at` and `erase(key)` still take `std::string`, heterogeneous erase
+     * needs C++23. Use `find` on lookup paths, then `erase(it)` to remove the entry found, and
+     * `try_emplace(std::string(key), ...)` when inserting.
+     */
+    template <class T>
+    using string_map = std::unordered_map<std::string, T, string_hash, std::equal_to<>>;
+}  // namespace engine
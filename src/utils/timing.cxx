@@ -3,6 +3,13 @@
 #include <SDL3/SDL.h>
 
 namespace engine {
+    namespace {
+        /**
+         * @brief How long before the target waiting stops sleeping and starts spinning.
+         */
+        constexpr Uint64 wait_spin_ns = 1'500'000;
+    }  // namespace
+
     std::uint64_t performance_counter_value_current() noexcept {
         return static_cast<std::uint64_t>(SDL_GetPerformanceCounter());
     }
@@ -12,4 +19,28 @@ namespace engine {
         const std::uint64_t frequency = SDL_GetPerformanceFrequency();
         return static_cast<float>(counter_end - counter_start) / static_cast<float>(frequency);
     }
+
+    std::uint64_t performance_counter_value_from_seconds(const float seconds) noexcept {
+        const auto frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+        return static_cast<std::uint64_t>(static_cast<double>(seconds) * frequency);
+    }
+
+    void performance_counter_wait_until(const std::uint64_t target_value) noexcept {
+        const std::uint64_t frequency = SDL_GetPerformanceFrequency();
+
+        const std::uint64_t now = performance_counter_value_current();
+        if (now >= target_value) {
+            return;
+        }
+
+        const auto remaining_ns = static_cast<Uint64>(
+            static_cast<double>(target_value - now) * (1'000'000'000.0 / frequency));
+        if (remaining_ns > wait_spin_ns) {
+            SDL_DelayNS(remaining_ns - wait_spin_ns);
+        }
+
+        while (performance_counter_value_current() < target_value) {
+            SDL_DelayNS(0);
+        }
+    }
 }  // namespace engine
@@ -42,6 +42,21 @@ namespace engine {
         return performance_counter_seconds_between(start_value, now);
     }
 
+    /**
+     * @brief Convert a duration in seconds to performance counter units.
+     */
+    [[nodiscard]] std::uint64_t performance_counter_value_from_seconds(float seconds) noexcept;
+
+    /**
+     * @brief Block until the performance counter reaches a value.
+     * @param target_value A value from `performance_counter_value_current`, returns at once if
+     *        it has already passed.
+     * @note Sleeps while the target is far away, then spins for the last stretch since an OS
+     *       sleep can oversleep by a scheduler quantum. The spin yields, so a whole core is
+     *       only held for about a millisecond.
+     */
+    void performance_counter_wait_until(std::uint64_t target_value) noexcept;
+
     constexpr float ticks_rate_to_interval(const float ticks_per_second) noexcept {
         return 1.f / ticks_per_second;
     }
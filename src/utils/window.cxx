@@ -23,6 +23,9 @@ namespace engine {
             case game_window_type::fullscreen:
                 window_flags = SDL_WINDOW_FULLSCREEN;
                 break;
+            case game_window_type::hidden:
+                window_flags = SDL_WINDOW_HIDDEN;
+                break;
             default:
                 window_flags = SDL_WINDOW_RESIZABLE;
                 break;
@@ -13,7 +13,13 @@ namespace engine {
     /**
      * @brief Types of supported game windows.
      */
-    enum class game_window_type { resizable, non_resizable, borderless, fullscreen };
+    enum class game_window_type {
+        resizable,
+        non_resizable,
+        borderless,
+        fullscreen,
+        hidden  ///< Never shown, for headless runs such as benchmarks.
+    };
 
     class game_window {
     public:
@@ -0,0 +1,221 @@
+/**
+ * @file main.cxx
+ * @brief Asset cook tool, packs an asset folder into a single archive the engine can map.
+ *
+ * Images are decoded with SDL_image and stored as tightly packed RGBA32 pixels, everything else
+ * is stored as is. Entries are sorted by path so the engine can binary search the index.
+ *
+ * Usage: `cook <assets directory> <output archive> [path prefix]`, the prefix defaults to the
+ * assets directory's name so paths match what game code requests, e.g. `assets/sprite.png`.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <SDL3/SDL.h>
+#include <SDL3_image/SDL_image.h>
+
+#include "utils/archive.hxx"
+
+namespace {
+    namespace fs = std::filesystem;
+
+    struct cooked_asset {
+        std::string path;
+        engine::asset_archive_entry_type type;
+        std::uint32_t width;
+        std::uint32_t height;
+        std::vector<std::byte> data;
+    };
+
+    constexpr std::array<std::string_view, 7> image_extensions = {
+        ".png", ".jpg", ".jpeg", ".bmp", ".tga", ".webp", ".qoi"};
+
+    bool is_image(const fs::path& file) {
+        std::string extension = file.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+        return std::find(image_extensions.begin(), image_extensions.end(), extension) !=
+               image_extensions.end();
+    }
+
+    bool cook_raw(const fs::path& file, cooked_asset& asset) {
+        std::ifstream stream(file, std::ios::binary);
+        if (stream.is_open() == false) {
+            return false;
+        }
+
+        asset.type = engine::asset_archive_entry_type::raw;
+        asset.width = 0;
+        asset.height = 0;
+        asset.data.resize(static_cast<std::size_t>(fs::file_size(file)));
+        stream.read(reinterpret_cast<char*>(asset.data.data()),
+                    static_cast<std::streamsize>(asset.data.size()));
+
+        return stream.good() == true || asset.data.empty() == true;
+    }
+
+    bool cook_image(const fs::path& file, cooked_asset& asset) {
+        SDL_Surface* loaded = IMG_Load(file.string().c_str());
+        if (loaded == nullptr) {
+            return false;
+        }
+
+        SDL_Surface* image = SDL_ConvertSurface(loaded, SDL_PIXELFORMAT_RGBA32);
+        SDL_DestroySurface(loaded);
+        if (image == nullptr) {
+            return false;
+        }
+
+        // Surfaces may pad their rows, the archive stores them tightly packed.
+        const std::size_t row_size = static_cast<std::size_t>(image->w) * 4;
+
+        asset.type = engine::asset_archive_entry_type::image_rgba32;
+        asset.width = static_cast<std::uint32_t>(image->w);
+        asset.height = static_cast<std::uint32_t>(image->h);
+        asset.data.resize(row_size * static_cast<std::size_t>(image->h));
+
+        for (int y = 0; y < image->h; ++y) {
+            std::memcpy(asset.data.data() + row_size * static_cast<std::size_t>(y),
+                        static_cast<const std::byte*>(image->pixels) +
+                            static_cast<std::ptrdiff_t>(image->pitch) * y,
+                        row_size);
+        }
+
+        SDL_DestroySurface(image);
+        return true;
+    }
+
+    std::uint64_t align_up(const std::uint64_t value, const std::uint64_t alignment) {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    bool archive_write(const fs::path& output, const std::vector<cooked_asset>& assets) {
+        std::vector<engine::asset_archive_entry> entries(assets.size());
+        std::string strings;
+
+        const std::uint64_t entries_offset = sizeof(engine::asset_archive_header);
+        const std::uint64_t strings_offset =
+            entries_offset + entries.size() * sizeof(engine::asset_archive_entry);
+
+        for (const cooked_asset& asset : assets) {
+            strings += asset.path;
+        }
+
+        std::uint64_t data_offset =
+            align_up(strings_offset + strings.size(), engine::asset_archive_alignment);
+        std::uint64_t path_offset = 0;
+
+        for (std::size_t i = 0; i < assets.size(); ++i) {
+            entries[i] = {.path_offset = path_offset,
+                          .data_offset = data_offset,
+                          .data_size = assets[i].data.size(),
+                          .path_size = static_cast<std::uint32_t>(assets[i].path.size()),
+                          .type = assets[i].type,
+                          .width = assets[i].width,
+                          .height = assets[i].height};
+
+            path_offset += assets[i].path.size();
+            data_offset = align_up(data_offset + assets[i].data.size(),
+                                   engine::asset_archive_alignment);
+        }
+
+        const engine::asset_archive_header header = {
+            .magic = engine::asset_archive_magic,
+            .version = engine::asset_archive_version,
+            .entry_count = static_cast<std::uint32_t>(entries.size()),
+            .reserved = 0,
+            .entries_offset = entries_offset,
+            .strings_offset = strings_offset};
+
+        std::ofstream stream(output, std::ios::binary | std::ios::trunc);
+        if (stream.is_open() == false) {
+            return false;
+        }
+
+        const auto pad_to = [&](const std::uint64_t offset) {
+            static constexpr char zeros[engine::asset_archive_alignment] = {};
+            const auto position = static_cast<std::uint64_t>(stream.tellp());
+            stream.write(zeros, static_cast<std::streamsize>(offset - position));
+        };
+
+        stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        stream.write(reinterpret_cast<const char*>(entries.data()),
+                     static_cast<std::streamsize>(entries.size() * sizeof(entries[0])));
+        stream.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+
+        for (std::size_t i = 0; i < assets.size(); ++i) {
+            pad_to(entries[i].data_offset);
+            stream.write(reinterpret_cast<const char*>(assets[i].data.data()),
+                         static_cast<std::streamsize>(assets[i].data.size()));
+        }
+
+        return stream.good();
+    }
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::fprintf(stderr, "Usage: %s <assets directory> <output archive> [path prefix]\n",
+                     argv[0]);
+        return 1;
+    }
+
+    const fs::path input = fs::path(argv[1]).lexically_normal();
+    const fs::path output = argv[2];
+    const fs::path name = input.has_filename() ? input.filename() : input.parent_path().filename();
+    const std::string prefix = (argc > 3) ? argv[3] : name.string();
+
+    if (fs::is_directory(input) == false) {
+        std::fprintf(stderr, "Not a directory: %s\n", input.string().c_str());
+        return 1;
+    }
+
+    std::vector<cooked_asset> assets;
+    std::size_t image_count = 0;
+
+    for (const fs::directory_entry& file : fs::recursive_directory_iterator(input)) {
+        if (file.is_regular_file() == false) {
+            continue;
+        }
+
+        cooked_asset asset;
+        asset.path = (fs::path(prefix) / fs::relative(file.path(), input)).generic_string();
+
+        // Images SDL_image cannot decode are still packed, just without decoding them.
+        if (is_image(file.path()) == true && cook_image(file.path(), asset) == true) {
+            image_count++;
+        } else if (cook_raw(file.path(), asset) == false) {
+            std::fprintf(stderr, "Failed to read: %s\n", file.path().string().c_str());
+            return 1;
+        }
+
+        assets.push_back(std::move(asset));
+    }
+
+    // Byte-wise order, the same order `std::string_view` comparisons use at runtime.
+    std::sort(assets.begin(), assets.end(), [](const cooked_asset& a, const cooked_asset& b) {
+        return a.path < b.path;
+    });
+
+    if (archive_write(output, assets) == false) {
+        std::fprintf(stderr, "Failed to write: %s\n", output.string().c_str());
+        return 1;
+    }
+
+    std::printf("Cooked %zu assets (%zu images) into %s\n", assets.size(), image_count,
+                output.string().c_str());
+
+    return 0;
+}